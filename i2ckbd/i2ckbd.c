@@ -1,8 +1,21 @@
 #include <stdio.h>
 #include <pico/stdio.h>
 #include "i2ckbd.h"
+#include "hardware/sync.h"
 
 static uint8_t i2c_inited = 0;
+static int ctrlheld = 0;
+
+// Background scanner state. The timer callback is the only producer and
+// the main loop the only consumer, so head/tail need no lock.
+static struct repeating_timer scan_timer;
+static volatile bool scan_running = false;
+static kbd_event_t events[I2C_KBD_EVENT_FIFO_SIZE];
+static volatile uint32_t events_head = 0;   // Written by the scanner
+static volatile uint32_t events_tail = 0;   // Written by the consumer
+static bool read_in_flight = false;
+static int read_ticks = 0;
+static kbd_scan_stats_t scan_stats;
 
 void init_i2c_kbd() {
     gpio_set_function(I2C_KBD_SCL, GPIO_FUNC_I2C);
@@ -14,9 +27,14 @@ void init_i2c_kbd() {
     i2c_inited = 1;
 }
 
+// Apply the Ctrl key to a pressed key code
+static int kbd_press_code(int c) {
+    if (c >= 'a' && c <= 'z' && ctrlheld)c = c - 'a' + 1;
+    return c;
+}
+
 int read_i2c_kbd() {
     int retval;
-    static int ctrlheld = 0;
     uint16_t buff = 0;
     unsigned char msg[2];
     int c = -1;
@@ -24,6 +42,15 @@ int read_i2c_kbd() {
 
     if (i2c_inited == 0) return -1;
 
+    // The scanner owns the bus once running: take the next press from its FIFO
+    if (scan_running) {
+        kbd_event_t ev;
+        while (i2c_kbd_pop_event(&ev)) {
+            if (ev.state == I2C_KBD_PRESSED) return ev.code;
+        }
+        return 0;
+    }
+
     retval = i2c_write_timeout_us(I2C_KBD_MOD, I2C_KBD_ADDR, msg, 1, false, 500000);
     if (retval == PICO_ERROR_GENERIC || retval == PICO_ERROR_TIMEOUT) {
         printf("i2c write error\n");
@@ -48,10 +75,114 @@ int read_i2c_kbd() {
                     realc = c;
                     break;
             }
-            c = realc;
-            if (c >= 'a' && c <= 'z' && ctrlheld)c = c - 'a' + 1;
+            c = kbd_press_code(realc);
         }
         return c;
     }
     return 0;
+}
+
+// Queue one event from the scanner (timer IRQ)
+static void push_event(uint16_t buff) {
+    uint8_t key = buff >> 8;
+    uint8_t state = buff & 0xff;
+
+    if (buff == 0x7e03) {
+        ctrlheld = 0;
+        return;
+    }
+    if (buff == 0x7e02) {
+        ctrlheld = 1;
+        return;
+    }
+
+    uint32_t head = events_head;
+    if (head - events_tail >= I2C_KBD_EVENT_FIFO_SIZE) {
+        scan_stats.dropped++;
+        return;
+    }
+    events[head % I2C_KBD_EVENT_FIFO_SIZE] = (kbd_event_t) {
+        .key = key,
+        .code = kbd_press_code(key),
+        .state = state,
+        .time_us = time_us_32(),
+    };
+    __dmb();
+    events_head = head + 1;
+    scan_stats.events++;
+}
+
+// Queue "write register 0x09, read 2 bytes" in the I2C command FIFO. The
+// controller runs both transfers on its own; the reply lands in the RX FIFO.
+static void start_fifo_read(i2c_hw_t *hw) {
+    hw->data_cmd = 0x09 | I2C_IC_DATA_CMD_STOP_BITS;
+    hw->data_cmd = I2C_IC_DATA_CMD_CMD_BITS;
+    hw->data_cmd = I2C_IC_DATA_CMD_CMD_BITS | I2C_IC_DATA_CMD_STOP_BITS;
+}
+
+// Drop anything left of an aborted or stalled read
+static void reset_fifo_read(i2c_hw_t *hw) {
+    (void) hw->clr_tx_abrt;
+    while (hw->rxflr > 0) (void) hw->data_cmd;
+    scan_stats.bus_errors++;
+}
+
+// Scanner tick: collect the previous read, then start the next one
+static bool scan_timer_cb(struct repeating_timer *t) {
+    i2c_hw_t *hw = i2c_get_hw(I2C_KBD_MOD);
+
+    if (read_in_flight) {
+        if (hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS) {
+            reset_fifo_read(hw);
+        } else if (hw->rxflr >= 2) {
+            uint16_t buff = hw->data_cmd & 0xff;
+            buff |= (hw->data_cmd & 0xff) << 8;
+            if (buff != 0) push_event(buff);
+        } else if (++read_ticks < I2C_KBD_STALL_TICKS) {
+            return true;                    // Still on the bus
+        } else {
+            hw->enable |= I2C_IC_ENABLE_ABORT_BITS;
+            read_ticks = 0;
+            return true;                    // Abort shows up as TX_ABRT next tick
+        }
+    }
+
+    start_fifo_read(hw);
+    read_in_flight = true;
+    read_ticks = 0;
+    return true;
+}
+
+bool i2c_kbd_scan_start(void) {
+    if (i2c_inited == 0 || scan_running) return scan_running;
+
+    // Only one device on this bus: set the target address once
+    i2c_hw_t *hw = i2c_get_hw(I2C_KBD_MOD);
+    hw->enable = 0;
+    hw->tar = I2C_KBD_ADDR;
+    hw->enable = 1;
+
+    scan_running = add_repeating_timer_ms(-I2C_KBD_SCAN_INTERVAL_MS, scan_timer_cb, NULL, &scan_timer);
+    if (scan_running) {
+        printf("Keyboard scanner: every %d ms\n", I2C_KBD_SCAN_INTERVAL_MS);
+    }
+    return scan_running;
+}
+
+bool i2c_kbd_pop_event(kbd_event_t *ev) {
+    uint32_t tail = events_tail;
+    if (tail == events_head) return false;
+    __dmb();
+    *ev = events[tail % I2C_KBD_EVENT_FIFO_SIZE];
+    __dmb();
+    events_tail = tail + 1;
+    return true;
+}
+
+bool i2c_kbd_has_event(void) {
+    return events_tail != events_head;
+}
+
+void i2c_kbd_get_scan_stats(kbd_scan_stats_t *stats) {
+    *stats = scan_stats;
 }
\ No newline at end of file
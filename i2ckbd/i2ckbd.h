@@ -13,7 +13,43 @@
 
 #define I2C_KBD_ADDR 0x1F
 
+// Background scanner: a repeating timer reads the keyboard controller's
+// FIFO at a fixed rate. Each read is queued as a whole in the I2C command
+// FIFO and collected on the next tick, so the CPU never waits on the bus.
+#define I2C_KBD_SCAN_INTERVAL_MS 5
+#define I2C_KBD_EVENT_FIFO_SIZE  32     // Power of two
+#define I2C_KBD_STALL_TICKS      4      // Ticks before a read that never completes is aborted
+
+// Key states reported by the keyboard controller
+#define I2C_KBD_PRESSED  1
+#define I2C_KBD_HOLD     2
+#define I2C_KBD_RELEASED 3
+
+typedef struct {
+    uint8_t key;
+    uint8_t code;           // Key as typed, with Ctrl applied (Ctrl+A = 1)
+    uint8_t state;          // I2C_KBD_PRESSED / HOLD / RELEASED
+    uint32_t time_us;       // When the scanner received it
+} kbd_event_t;
+
+typedef struct {
+    uint32_t events;        // Events queued
+    uint32_t dropped;       // Events lost to a full FIFO
+    uint32_t bus_errors;    // Aborted or stalled reads
+} kbd_scan_stats_t;
+
 void init_i2c_kbd();
 int read_i2c_kbd();
 
-#endif
\ No newline at end of file
+// Start the background scanner; afterwards read_i2c_kbd() takes key presses from its FIFO
+bool i2c_kbd_scan_start(void);
+
+// Take the next event; false if none is queued
+bool i2c_kbd_pop_event(kbd_event_t *ev);
+
+// True if events are queued
+bool i2c_kbd_has_event(void);
+
+void i2c_kbd_get_scan_stats(kbd_scan_stats_t *stats);
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Benchmark suite for the hardware paths the firmware depends on: display
+// fills, console text and scrolling over SPI, LVGL hardware scrolling,
+// SRAM/PSRAM copies, XIP flash reads, CRC32, SHA-256, the RGB565 blend
+// kernels, deferred logging, the news, forecast and Telegram JSON parsers,
+// LodePNG, the virtualized list, offline TLS handshakes against an
+// in-memory server (the default preferences, then one pinned suite and
+// curve per variant; configure with -DOMNITOOL_BENCH=ON, otherwise they
+// report skipped) and the TLS receive path. Inputs are fixed (embedded
+// fixtures, fixed-seed RNG for TLS and synthetic record streams) so runs
+// are comparable across builds.
+// Results go to the UART as
+//   BENCH_BEGIN version=v0.04.0 build=42 clk_hz=150000000
+//   BENCH <test>.<metric> <value> <unit>
+//   BENCH_END tests=10 elapsed_ms=5230
+// so two logs can be compared with grep '^BENCH' and diff.
+//
+// Tests run one at a time from the caller (the Benchmarks screen steps
+// through them from an LVGL timer). The display tests draw straight to the
+// panel, so the caller must redraw the screen after them.
+//
+// Console commands (see console.h), stepped the same way:
+//   bench list          test names
+//   bench all           the whole suite
+//   bench <test>        one test
+#define BENCH_PSRAM_SCRATCH  (128 * 1024)   // Frame strip and PSRAM copy buffers
+#define BENCH_SRAM_BLOCK     (16 * 1024)    // SRAM copy/CRC block
+
+// Receives each metric as it is measured
+typedef void (*bench_result_cb_t)(const char *test, const char *metric, float value,
+                                  const char *unit, void *user_data);
+
+// API Functions
+
+// Register the console command
+void bench_init(void);
+
+// Number of tests and their names
+int bench_test_count(void);
+const char *bench_test_name(int index);
+
+// True if the test draws to the display
+bool bench_test_draws(int index);
+
+// Print the report header
+void bench_begin(void);
+
+// Run one test, printing its metrics and passing them to cb (may be NULL)
+void bench_run_test(int index, bench_result_cb_t cb, void *user_data);
+
+// Print the report footer
+void bench_end(void);
+
+#endif // BENCH_H
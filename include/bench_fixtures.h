@@ -0,0 +1,19 @@
+#ifndef BENCH_FIXTURES_H
+#define BENCH_FIXTURES_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Binary inputs for the benchmark suite (bench.c)
+
+// Map tile for the PNG decode benchmark
+extern const uint8_t bench_tile_png[];
+extern const size_t bench_tile_png_size;
+
+// Key and certificate of the in-memory TLS server
+extern const uint8_t bench_server_key_der[];
+extern const size_t bench_server_key_der_size;
+extern const uint8_t bench_server_cert_der[];
+extern const size_t bench_server_cert_der_size;
+
+#endif // BENCH_FIXTURES_H
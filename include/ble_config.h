@@ -69,6 +69,20 @@ typedef struct {
     bool notifications_enabled;
 } ble_connection_state_t;
 
+// Link counters since boot (runtime stats console)
+typedef struct {
+    uint32_t hci_events;         // Events through the HCI/SM packet handler
+    uint32_t connects;
+    uint32_t disconnects;
+    uint8_t last_disconnect_reason;
+    uint16_t conn_interval;      // Of the current link, in 1.25 ms units (0 = none)
+    uint32_t rx_notifications;
+    uint32_t rx_bytes;
+    uint32_t tx_writes;
+    uint32_t tx_bytes;
+    uint32_t tx_failures;
+} ble_link_stats_t;
+
 // Data callback type for received data
 typedef void (*ble_data_received_callback_t)(const uint8_t *data, uint16_t length);
 
@@ -100,6 +114,7 @@ void ble_sps_set_data_callback(ble_data_received_callback_t callback);
 
 // Utility functions
 const char* ble_sps_type_to_string(sps_device_type_t type);
+void ble_get_link_stats(ble_link_stats_t *stats);
 void ble_address_to_string(const bd_addr_t address, char *str, size_t len);
 
 #endif // BLE_CONFIG_H
@@ -0,0 +1,47 @@
+#ifndef BLEND_RGB565_H
+#define BLEND_RGB565_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// RGB565 fill and blend kernels for LVGL's software renderer.
+// LVGL calls them through the LV_DRAW_SW_ASM_CUSTOM hooks (see
+// lv_blend_rgb565_custom.h) for solid fills, fills with opacity, A8 glyph
+// masks and RGB565 image copy/blend. The fast kernels move two pixels per
+// 32-bit access and classify four mask bytes per load; each has a portable
+// reference that matches LVGL's own C loops bit for bit, and the fast path
+// is only enabled once it has been checked against the reference.
+//
+// Strides are in pixels. opa follows LVGL: >= BLEND565_OPA_COVER is opaque.
+#define BLEND565_OPA_COVER 253   // LV_OPA_MAX
+
+// Kernels, for blend565_benchmark()
+#define BLEND565_KERNEL_FILL  0
+#define BLEND565_KERNEL_MASK  1
+#define BLEND565_KERNEL_IMAGE 2
+#define BLEND565_KERNEL_COUNT 3
+
+// API Functions
+
+// Self-test the fast kernels against the reference ones and enable them
+void blend565_setup(void);
+
+// True once the fast kernels passed the self-test
+bool blend565_enabled(void);
+
+// Fill with a color (opa >= BLEND565_OPA_COVER) or blend it at opa
+void blend565_fill(uint16_t *dest, int32_t w, int32_t h, int32_t dest_stride,
+                   uint16_t color, uint8_t opa);
+
+// Blend a color through an A8 mask, scaled by opa (glyphs, anti-aliased edges)
+void blend565_fill_mask(uint16_t *dest, int32_t w, int32_t h, int32_t dest_stride,
+                        uint16_t color, uint8_t opa, const uint8_t *mask, int32_t mask_stride);
+
+// Copy (opa >= BLEND565_OPA_COVER) or blend an RGB565 image at opa
+void blend565_image(uint16_t *dest, int32_t w, int32_t h, int32_t dest_stride,
+                    const uint16_t *src, int32_t src_stride, uint8_t opa);
+
+// Time one kernel at opa through the reference and fast paths (Mpixel/s)
+void blend565_benchmark(int kernel, uint8_t opa, float *ref_mpx_s, float *fast_mpx_s);
+
+#endif // BLEND_RGB565_H
@@ -0,0 +1,25 @@
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// UART command console - reads lines from stdio without blocking and hands
+// each one, split on spaces, to the module that registered its first word
+// ("prof ...", "cap ..."). "help" lists the registered commands.
+#define CONSOLE_LINE_MAX     64
+#define CONSOLE_MAX_ARGS     8
+#define CONSOLE_MAX_COMMANDS 8
+
+// Handles one command line; argv[0] is the command name
+typedef void (*console_cmd_fn_t)(int argc, char **argv);
+
+// API Functions
+
+// Register a command (usage is printed by "help")
+bool console_register(const char *name, console_cmd_fn_t fn, const char *usage);
+
+// Read UART input and run complete lines (main loop)
+void console_poll(void);
+
+#endif // CONSOLE_H
@@ -0,0 +1,65 @@
+#ifndef EVENT_BUS_H
+#define EVENT_BUS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Event bus - pushes network module state changes to the UI.
+// Modules post from lwIP callbacks (IRQ context) or either core; events are
+// queued and delivered to subscribers by event_bus_dispatch() from the main
+// loop, right before lv_timer_handler(), so a finished fetch is on screen in
+// the same frame it is dispatched. Progress events are coalesced: at most
+// one per source is queued and it carries the latest byte count.
+#define EVENT_BUS_QUEUE_SIZE      16
+#define EVENT_BUS_MAX_SUBSCRIBERS 8
+
+// Module that posted the event
+typedef enum {
+    EVENT_SOURCE_NEWS,
+    EVENT_SOURCE_WEATHER,
+    EVENT_SOURCE_TELEGRAM,
+    EVENT_SOURCE_COUNT
+} event_source_t;
+
+// Event types
+typedef enum {
+    EVENT_FETCH_STARTED,    // A request was started (state tells which)
+    EVENT_FETCH_PROGRESS,   // Response bytes received so far
+    EVENT_FETCH_COMPLETED,  // Data is ready in *_api_get_data()
+    EVENT_FETCH_ERROR       // error_message is set in *_api_get_data()
+} event_type_t;
+
+// Event
+typedef struct {
+    event_source_t source;
+    event_type_t type;
+    int state;              // Module state enum when posted
+    uint32_t bytes;         // Response bytes so far (progress events)
+    uint32_t posted_us;     // Post time, for delivery latency
+} app_event_t;
+
+// Subscriber callback (runs in the main loop)
+typedef void (*event_handler_t)(const app_event_t *event, void *user_data);
+
+// API Functions
+
+// Initialize the bus (before any module can post)
+void event_bus_init(void);
+
+// Post an event; safe from IRQ context and either core.
+// Returns false if the queue is full (the event is dropped and counted).
+bool event_bus_post(event_source_t source, event_type_t type, int state);
+
+// Post a progress update for source (coalesced, see above)
+void event_bus_post_progress(event_source_t source, int state, uint32_t bytes);
+
+// Subscribe to one source; returns false if all slots are taken
+bool event_bus_subscribe(event_source_t source, event_handler_t handler, void *user_data);
+
+// Remove every subscription of handler (no-op if there is none)
+void event_bus_unsubscribe(event_handler_t handler);
+
+// Deliver queued events to subscribers; returns the number dispatched
+uint32_t event_bus_dispatch(void);
+
+#endif // EVENT_BUS_H
@@ -0,0 +1,54 @@
+#ifndef JOB_QUEUE_H
+#define JOB_QUEUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Cross-core job queue - runs CPU-heavy, self-contained work (JSON parsing,
+// decoding, hashing) on core1 so it doesn't stall rendering on core0.
+// Jobs may be submitted from core0 code or lwIP callbacks. Core1 runs them
+// one at a time in submission order; each job's done callback then runs
+// on core0 from job_queue_poll() in the main loop.
+//
+// Urgent jobs (draw tasks core0 is waiting on) have a queue of their own
+// that core1 always empties first. They are refused while core1 is in the
+// middle of a normal job, so they never wait behind a parse.
+//
+// A job must not touch lwIP, LVGL objects or the LVGL heap: none of them
+// are safe to use from core1 (lv_port_draw_core1.c only offloads draw tasks
+// that render without them).
+#define JOB_QUEUE_SIZE               8
+#define JOB_QUEUE_URGENT_SIZE        2
+#define JOB_QUEUE_REPORT_INTERVAL_MS 10000   // Stats window for the busy/latency report
+
+// Job body (core1) and completion callback (core0 main loop)
+typedef void (*job_fn_t)(void *arg);
+
+// API Functions
+
+// Initialize the queues (on core0, before core1 is launched)
+void job_queue_init(void);
+
+// Core1 worker loop; never returns
+void job_queue_worker_run(void);
+
+// Queue a job; done may be NULL. Returns false if the worker isn't running
+// or the queue is full - the caller should then run the job itself.
+bool job_queue_submit(const char *name, job_fn_t run, job_fn_t done, void *arg);
+
+// Queue a job ahead of the normal ones (no done callback). Returns false if
+// core1 is busy with a normal job or the urgent queue is full - the caller
+// should then run the job itself.
+bool job_queue_submit_urgent(const char *name, job_fn_t run, void *arg);
+
+// Run completion callbacks of finished jobs and print the per-core busy
+// time and job latency report once per window (core0 main loop)
+void job_queue_poll(void);
+
+// Add main loop busy time for core0 to the current report window
+void job_queue_core0_busy(uint32_t busy_us);
+
+// Core1 busy time (job run time) and jobs run since boot
+void job_queue_get_totals(uint64_t *core1_busy_us, uint32_t *jobs);
+
+#endif // JOB_QUEUE_H
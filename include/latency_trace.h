@@ -0,0 +1,40 @@
+#ifndef LATENCY_TRACE_H
+#define LATENCY_TRACE_H
+
+#include "lvgl.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// Key-to-photon latency tracer.
+// A key press delivered to LVGL starts a trace; the first area LVGL
+// invalidates after it is remembered, and the trace ends when the first
+// flush overlapping that area has been sent to the panel. Each trace is
+// split into stages:
+//   scan   - keyboard scanner receive -> delivered by the LVGL indev read
+//   lvgl   - indev read -> first invalidation (event handling)
+//   wait   - invalidation -> start of the refresh that draws it
+//   draw   - refresh start -> flush of the area done (render + SPI)
+// Percentiles are computed over the last LATENCY_TRACE_SAMPLES traces.
+// One key is traced at a time; presses during a trace are not sampled.
+#define LATENCY_TRACE_SAMPLES     128
+#define LATENCY_TRACE_DUMP_EVERY  32     // Print to UART after this many new traces
+#define LATENCY_TRACE_TIMEOUT_MS  1000   // Keys that redraw nothing are dropped
+
+// API Functions
+
+// Hook into the default display's refresh events (after lv_port_disp_init)
+void latency_trace_init(void);
+
+// A key press was delivered to LVGL; key_us is the scanner's timestamp
+void latency_trace_key(uint32_t key_us);
+
+// The display flush callback finished sending an area
+void latency_trace_flush_done(const lv_area_t *area);
+
+// Print p50/p95/p99 per stage over UART
+void latency_trace_dump(void);
+
+// Show or hide the percentile overlay on the top layer
+void latency_trace_toggle_overlay(void);
+
+#endif // LATENCY_TRACE_H
@@ -0,0 +1,63 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Deferred logging - LOG_E/W/I/D take printf-style arguments but only copy
+// the format pointer and the argument values into a lock-free ring, so they
+// are safe from IRQ context and either core and cost a few microseconds
+// instead of the time it takes to clock a line out of the UART. log_drain()
+// formats queued messages from the main loop and hands them to stdio one
+// whole line at a time, starting a line only once the UART TX FIFO has
+// emptied, so it blocks for no more than one line's overflow. printf from
+// the main loop or the other core lands between lines; printf from an IRQ
+// handler can still split one, so code that runs there uses LOG_*.
+//
+// The format must be a string literal (only its pointer is stored). %s
+// arguments are copied, up to LOG_STRING_BYTES per message in total, so
+// they may point at temporary buffers; longer strings are truncated.
+// %n and long double are not supported.
+#define LOG_LEVEL_NONE   0
+#define LOG_LEVEL_ERROR  1
+#define LOG_LEVEL_WARN   2
+#define LOG_LEVEL_INFO   3
+#define LOG_LEVEL_DEBUG  4
+
+// Messages above this level are compiled out
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+#define LOG_RING_RECORDS  64    // Power of two
+#define LOG_ARG_BYTES     32    // Numeric argument storage per message
+#define LOG_STRING_BYTES  48    // Copied %s text per message
+#define LOG_LINE_MAX      192   // Longest formatted line
+
+#define LOG_AT(level, ...) \
+    do { if ((level) <= LOG_LEVEL) log_write((level), __VA_ARGS__); } while (0)
+
+#define LOG_E(...) LOG_AT(LOG_LEVEL_ERROR, __VA_ARGS__)
+#define LOG_W(...) LOG_AT(LOG_LEVEL_WARN, __VA_ARGS__)
+#define LOG_I(...) LOG_AT(LOG_LEVEL_INFO, __VA_ARGS__)
+#define LOG_D(...) LOG_AT(LOG_LEVEL_DEBUG, __VA_ARGS__)
+
+// API Functions
+
+// Initialize the ring (first thing in main; messages before it are dropped)
+void log_init(void);
+
+// Queue a message; use the LOG_* macros instead so levels are filtered at compile time
+void log_write(uint8_t level, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+// Format queued messages and push them to the UART while its FIFO has room (main loop)
+void log_drain(void);
+
+// Write out everything queued, blocking until done (before a long synchronous dump)
+void log_flush(void);
+
+// Compare the cost of a queued message with a synchronous printf (ns per
+// call each), and time how long draining the queued ones takes
+void log_benchmark(uint32_t *log_ns, uint32_t *printf_ns, uint32_t *drain_us);
+
+#endif // LOG_H
@@ -0,0 +1,60 @@
+/**
+ * @file lv_blend_rgb565_custom.h
+ *
+ * LV_DRAW_SW_ASM_CUSTOM hooks for RGB565 targets, routed to blend_rgb565.c.
+ *
+ * LVGL includes this file from its software blender. Each hook returns
+ * LV_RESULT_OK when it blended the area, or LV_RESULT_INVALID so LVGL
+ * falls back to its own C loop (fast kernels disabled or not yet set up).
+ */
+
+#ifndef LV_BLEND_RGB565_CUSTOM_H
+#define LV_BLEND_RGB565_CUSTOM_H
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "blend_rgb565.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565(dsc)                   lv_blend565_color(dsc)
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_OPA(dsc)          lv_blend565_color(dsc)
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_MASK(dsc)         lv_blend565_color_mask(dsc, LV_OPA_COVER)
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_MIX_MASK_OPA(dsc)      lv_blend565_color_mask(dsc, (dsc)->opa)
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565(dsc)           lv_blend565_image(dsc)
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_OPA(dsc)  lv_blend565_image(dsc)
+
+/**********************
+ *   INLINE FUNCTIONS
+ **********************/
+
+static inline lv_result_t lv_blend565_color(lv_draw_sw_blend_fill_dsc_t * dsc)
+{
+    if(!blend565_enabled()) return LV_RESULT_INVALID;
+
+    blend565_fill(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride / 2,
+                  lv_color_to_u16(dsc->color), dsc->opa);
+    return LV_RESULT_OK;
+}
+
+static inline lv_result_t lv_blend565_color_mask(lv_draw_sw_blend_fill_dsc_t * dsc, lv_opa_t opa)
+{
+    if(!blend565_enabled()) return LV_RESULT_INVALID;
+
+    blend565_fill_mask(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride / 2,
+                       lv_color_to_u16(dsc->color), opa, dsc->mask_buf, dsc->mask_stride);
+    return LV_RESULT_OK;
+}
+
+static inline lv_result_t lv_blend565_image(lv_draw_sw_blend_image_dsc_t * dsc)
+{
+    if(!blend565_enabled()) return LV_RESULT_INVALID;
+
+    blend565_image(dsc->dest_buf, dsc->dest_w, dsc->dest_h, dsc->dest_stride / 2,
+                   dsc->src_buf, dsc->src_stride / 2, dsc->opa);
+    return LV_RESULT_OK;
+}
+
+#endif /*LV_BLEND_RGB565_CUSTOM_H*/
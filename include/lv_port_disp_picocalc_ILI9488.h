@@ -43,6 +43,16 @@ void disp_enable_update(void);
  */
 void disp_disable_update(void);
 
+/* Scroll an object with the panel's hardware vertical scrolling: when it
+ * scrolls, its rows are moved on the panel and only the rows that scroll in
+ * are redrawn. Used while no other object shares its screen rows; otherwise
+ * LVGL redraws it as usual. */
+void lv_port_disp_hw_scroll_attach(lv_obj_t * obj);
+
+/* Scroll an attached object with and without hardware scrolling and return
+ * the SPI bytes sent per scrolled line. False if the object can't scroll. */
+bool lv_port_disp_hw_scroll_benchmark(lv_obj_t * obj, uint32_t * redraw_bytes, uint32_t * hw_bytes);
+
 /**********************
  *      MACROS
  **********************/
@@ -0,0 +1,45 @@
+/**
+ * @file lv_port_draw_core1.h
+ *
+ */
+
+#ifndef LV_PORT_DRAW_CORE1_H
+#define LV_PORT_DRAW_CORE1_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lvgl.h"
+#include <stdbool.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+/* Full-screen redraws timed per mode by lv_port_draw_core1_report_frame_time() */
+#define DRAW_CORE1_BENCH_FRAMES 3
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+/* Register a second LVGL draw unit whose tasks are rendered on core1 (through
+ * the job queue) while the software draw unit keeps rendering on core0.
+ * Call after lv_init() and once core1 runs the job queue worker. */
+void lv_port_draw_core1_init(void);
+
+/* Route draw tasks to core1 (true) or keep all rendering on core0 (false) */
+void lv_port_draw_core1_set_enabled(bool enabled);
+
+/* Time full-screen redraws of the active screen with one draw unit (core0)
+ * and with two (core0 + core1), and print both. Renders synchronously, so it
+ * is run on request ("ui frame" console command), never from a transition */
+void lv_port_draw_core1_report_frame_time(const char *name);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_PORT_DRAW_CORE1_H*/
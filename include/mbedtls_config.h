@@ -7,6 +7,9 @@
 // Enable TLS/SSL support
 #define MBEDTLS_SSL_CLI_C
 #define MBEDTLS_SSL_TLS_C
+#ifdef OMNITOOL_BENCH
+#define MBEDTLS_SSL_SRV_C            // Only for the in-memory peer of the TLS benchmark (bench.c)
+#endif
 
 // Cipher suites required for modern HTTPS
 #define MBEDTLS_KEY_EXCHANGE_RSA_ENABLED
@@ -49,6 +52,7 @@
 
 // Memory and platform
 #define MBEDTLS_PLATFORM_C
+#define MBEDTLS_PLATFORM_MEMORY      // calloc/free are routed to tls_arena at runtime
 
 // Use standard C library functions
 #include <stdio.h>
@@ -0,0 +1,50 @@
+#ifndef NET_CAPTURE_H
+#define NET_CAPTURE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "event_bus.h"
+
+// Record and replay of API responses. With capture on, each network module
+// copies the raw response it receives (HTTP headers and body, after TLS
+// decryption) into a PSRAM buffer per source, keeping the latest one. The
+// capture can be dumped over the UART (tools/capture_extract.py writes it
+// to a file) or replayed: the bytes are reassembled in segments of a chosen
+// size and run through the module's parser, once whole and once segmented,
+// with the item counts, a checksum of the reassembled body and the parse
+// time printed as
+//   CAPTURE <source> bytes=<n> segments=<n> items=<n> crc=<hex> parse_us=<n>
+//
+// Console commands (see console.h):
+//   cap on | cap off            enable or disable capture
+//   cap list                    show the captured responses
+//   cap dump <source>           stream a capture ("CAPT BEGIN" ... "CAPT END")
+//   cap replay <source> [seg]   replay with seg-byte segments (0 = random)
+// where <source> is news, weather or telegram.
+#define NET_CAPTURE_MAGIC         0x434E4350  // "PCNC"
+#define NET_CAPTURE_VERSION       1
+#define NET_CAPTURE_NEWS_SIZE     (160 * 1024)  // Matches NEWS_RESPONSE_BUFFER_SIZE
+#define NET_CAPTURE_WEATHER_SIZE  (32 * 1024)   // Twice the client buffer, so overruns show
+#define NET_CAPTURE_TELEGRAM_SIZE (16 * 1024)
+#define NET_CAPTURE_MAX_SEGMENT   1460          // Random segments are 1..one TCP MSS
+
+// API Functions
+
+// Register the console command
+void net_capture_init(void);
+
+// Start a new capture for source (called when a request is sent)
+void net_capture_begin(event_source_t source);
+
+// Append received response bytes (lwIP callback context)
+void net_capture_append(event_source_t source, const void *data, size_t len);
+
+// Close the capture when the connection ends
+void net_capture_end(event_source_t source);
+
+// Replay a closed capture; returns the item count of the segmented pass,
+// -1 if there is nothing to replay
+int net_capture_replay(event_source_t source, uint32_t segment);
+
+#endif // NET_CAPTURE_H
@@ -4,19 +4,28 @@
 #include <stdint.h>
 #include <stdbool.h>
 
-// Maximum number of news articles to fetch
-#define MAX_NEWS_ARTICLES 20
+// Article store capacity
+#define NEWS_PAGE_SIZE 100                         // Articles requested per fetch (NewsAPI maximum)
+#define MAX_NEWS_ARTICLES NEWS_PAGE_SIZE           // Records per store bank (one page is fetched)
+#define NEWS_TEXT_ARENA_SIZE (64 * 1024)           // String arena per store bank (PSRAM)
+#define NEWS_RESPONSE_BUFFER_SIZE (160 * 1024)     // Raw HTTP response (PSRAM)
 
-// Maximum lengths for news data
+// Maximum lengths for news data (longer strings are truncated)
 #define NEWS_TITLE_MAX_LEN 128
 #define NEWS_SOURCE_MAX_LEN 64
 #define NEWS_DESCRIPTION_MAX_LEN 512
 
-// News article structure
+// News article record - offsets of NUL-terminated strings in the text arena.
+// The headline is "[source]\ntitle" (or just the title) so a list row can
+// bind to it with lv_label_set_text_static; title points inside it.
 typedef struct {
-    char title[NEWS_TITLE_MAX_LEN + 1];
-    char source[NEWS_SOURCE_MAX_LEN + 1];
-    char description[NEWS_DESCRIPTION_MAX_LEN + 1];
+    uint32_t headline;
+    uint32_t title;
+    uint32_t source;
+    uint32_t description;
+    uint16_t title_len;
+    uint16_t source_len;
+    uint16_t description_len;
 } news_article_t;
 
 // News fetch state
@@ -28,13 +37,38 @@ typedef enum {
 } news_fetch_state_t;
 
 // News data structure
+// The store is double-buffered: a fetch parses into the idle bank and only
+// then publishes it here, so strings bound to labels stay valid until the
+// fetch after next.
 typedef struct {
-    news_article_t articles[MAX_NEWS_ARTICLES];
-    uint8_t count;
+    const news_article_t *articles;  // count records
+    const char *text;                // Arena the record offsets point into
+    uint16_t count;
     news_fetch_state_t state;
     char error_message[128];
 } news_data_t;
 
+// Article string accessors
+static inline const char *news_article_headline(const news_data_t *data, uint16_t index)
+{
+    return data->text + data->articles[index].headline;
+}
+
+static inline const char *news_article_title(const news_data_t *data, uint16_t index)
+{
+    return data->text + data->articles[index].title;
+}
+
+static inline const char *news_article_source(const news_data_t *data, uint16_t index)
+{
+    return data->text + data->articles[index].source;
+}
+
+static inline const char *news_article_description(const news_data_t *data, uint16_t index)
+{
+    return data->text + data->articles[index].description;
+}
+
 // Initialize news API
 void news_api_init(void);
 
@@ -48,4 +82,9 @@ news_data_t* news_api_get_data(void);
 // Get current fetch state
 news_fetch_state_t news_api_get_state(void);
 
+// Parse a JSON body with the article parser into scratch storage, leaving
+// the published data alone (benchmarks). Returns the article count, -1 on
+// allocation failure.
+int news_api_parse_fixture(const char *json);
+
 #endif // NEWS_API_H
@@ -0,0 +1,25 @@
+#ifndef PERF_OVERLAY_H
+#define PERF_OVERLAY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// On-screen performance overlay (F1 toggles it). A fixed-size box in the
+// top right corner of the top layer shows, over the last update period:
+//   fps   - frames flushed per second
+//   flush - average / longest disp_flush() in ms, KB sent to the panel per s
+//   cpu   - core0 main loop and core1 job load
+//   lvgl  - LVGL heap used / size, PSRAM used, SRAM heap still free
+// The box never changes size and is redrawn only when the period ends, so
+// its own cost is one small flush per update; the numbers come from
+// runtime_stats.h.
+#define PERF_OVERLAY_PERIOD_MS  500
+#define PERF_OVERLAY_WIDTH      150
+#define PERF_OVERLAY_HEIGHT     54
+
+// API Functions
+
+// Show or hide the overlay
+void perf_overlay_toggle(void);
+
+#endif // PERF_OVERLAY_H
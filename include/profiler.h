@@ -0,0 +1,48 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Sampling profiler - a hardware timer alarm per core interrupts at a fixed
+// rate and records the interrupted PC and LR from the exception stack frame
+// into a PSRAM buffer. Start and stop it with F8 or the UART commands below;
+// stopping dumps the samples hex framed ("PROF BEGIN" ... "PROF END"), and
+// tools/prof_symbolize.py turns the dump into flat and folded-stack profiles
+// against the picocalc_omnitool ELF.
+//
+// Console commands (see console.h):
+//   prof start [hz]   start sampling (default PROFILER_DEFAULT_HZ)
+//   prof stop         stop and dump
+//   prof dump         dump the last run again
+#define PROFILER_MAX_SAMPLES  16384   // Both cores together, 8 bytes each
+#define PROFILER_DEFAULT_HZ   1000    // Per core
+#define PROFILER_MIN_HZ       10
+#define PROFILER_MAX_HZ       20000
+#define PROFILER_MAGIC        0x46504350  // "PCPF"
+#define PROFILER_VERSION      1
+
+// API Functions
+
+// Allocate the sample buffer and set up core0's alarm (after psram_init)
+void profiler_init(void);
+
+// Set up the alarm on the calling core (core1 entry)
+void profiler_core_init(void);
+
+// Start sampling both cores at rate_hz (clamped to PROFILER_MIN_HZ..MAX_HZ)
+void profiler_start(uint32_t rate_hz);
+
+// Stop sampling
+void profiler_stop(void);
+
+// True while sampling
+bool profiler_running(void);
+
+// Start if stopped; stop and dump if running (key combo)
+void profiler_toggle(void);
+
+// Stream the samples over stdio
+void profiler_dump(void);
+
+#endif // PROFILER_H
@@ -0,0 +1,83 @@
+#ifndef RUNTIME_STATS_H
+#define RUNTIME_STATS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// Runtime counters for release builds - memory (SRAM heap, PSRAM, LVGL
+// heap, lwIP pools), main loop CPU time per task, frame and flush times,
+// TLS handshakes, HTTP fetches, the BLE link and Wi-Fi signal, read out
+// over the UART console. The main loop, disp_flush() and the TLS profiler
+// feed the counters; the rest is read from the owning modules on demand.
+//
+// Console commands (see console.h):
+//   stats [group]           print a group once (default all)
+//   stats lwip full         lwIP's own stats_display() (LWIP_STATS_DISPLAY builds)
+//   watch <group> [ms]      print a one-line summary every ms (default
+//                           RUNTIME_STATS_WATCH_MS), "watch off" stops
+// where <group> is mem, net, lwip, cpu, frame, tls, http, ble, wifi or all.
+// cpu and frame report the time since they were last printed.
+#define RUNTIME_STATS_WATCH_MS     1000
+#define RUNTIME_STATS_MIN_WATCH_MS 100
+#define RUNTIME_STATS_HIST_BINS    8     // <=1, 2, 5, 10, 20, 50, 100, >100 ms
+
+// Main loop tasks timed by runtime_stats_task_end()
+typedef enum {
+    STATS_TASK_STATE,       // App state machine
+    STATS_TASK_JOBS,        // job_queue_poll()
+    STATS_TASK_EVENTS,      // event_bus_dispatch()
+    STATS_TASK_LVGL,        // lv_timer_handler()
+    STATS_TASK_CONSOLE,     // log_drain(), console_poll()
+    STATS_TASK_COUNT
+} stats_task_t;
+
+// Readers of the flush time maximum, each with its own window
+typedef enum {
+    STATS_READER_CONSOLE,
+    STATS_READER_OVERLAY,
+    STATS_READER_COUNT
+} stats_reader_t;
+
+// Load and display totals since boot; readers diff two snapshots
+typedef struct {
+    uint64_t at_us;
+    uint64_t core0_busy_us;     // Main loop, excluding its sleep
+    uint64_t core1_busy_us;     // Job run time
+    uint32_t core1_jobs;
+    uint32_t frames;
+    uint32_t flush_calls;
+    uint64_t flush_us;
+    uint64_t flush_bytes;
+} runtime_stats_snapshot_t;
+
+// API Functions
+
+// Register the console commands and subscribe to the network events
+void runtime_stats_init(void);
+
+// Charge now - start_us to task; returns now, the start of the next task
+uint64_t runtime_stats_task_end(stats_task_t task, uint64_t start_us);
+
+// Record one main loop iteration's busy time (excluding the sleep)
+void runtime_stats_loop(uint32_t busy_us);
+
+// Record one disp_flush() call; last is set on the final area of a frame
+void runtime_stats_flush(uint32_t flush_us, uint32_t bytes, bool last);
+
+// Record a finished or failed TLS handshake
+void runtime_stats_tls_handshake(bool ok, uint32_t total_us, uint32_t cpu_us);
+
+// Take a snapshot of the totals
+void runtime_stats_snapshot(runtime_stats_snapshot_t *snap);
+
+// Longest disp_flush() since this reader last asked
+uint32_t runtime_stats_take_flush_max(stats_reader_t reader);
+
+// SRAM heap in use and its size (malloc arena between __end__ and __HeapLimit)
+void runtime_stats_get_sram(size_t *used, size_t *total);
+
+// Print watch lines when due (main loop)
+void runtime_stats_poll(void);
+
+#endif // RUNTIME_STATS_H
@@ -0,0 +1,57 @@
+#ifndef SHA256_ENGINE_H
+#define SHA256_ENGINE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// SHA-256 engine backed by the RP2350 SHA-256 block, used for the WiFi
+// config record in flash. It is not an mbedTLS backend: pico_mbedtls owns
+// the MBEDTLS_SHA256_ALT hook and its contexts wait for the block while
+// another one holds it, which a TLS handshake with its transcript hash
+// open would never release. TLS keeps the software SHA-256.
+// The block holds a single hash in flight and its state cannot be loaded,
+// so a context claims it at start and keeps it until finish. Contexts
+// started while it is busy (and SHA-224, and host builds) run the portable
+// implementation instead. Cloning a hardware context reads the intermediate
+// state back out and continues the copy in software.
+#define SHA256_ENGINE_DIGEST_SIZE    32
+#define SHA256_ENGINE_BLOCK_SIZE     64
+#define SHA256_ENGINE_DMA_MIN_BLOCKS 4   // Shorter runs are fed by the CPU
+
+// Hashing context
+typedef struct {
+    uint32_t state[8];
+    uint64_t total;                              // Bytes hashed so far
+    uint8_t buffer[SHA256_ENGINE_BLOCK_SIZE];    // Partial block
+    uint32_t buffer_len;
+    bool is224;
+    bool hw;                                     // Owns the hardware block
+} sha256_engine_ctx_t;
+
+// API Functions
+
+// Claim the DMA channel and self-test the hardware against the portable path
+void sha256_engine_setup(void);
+
+// Context lifecycle
+void sha256_engine_init(sha256_engine_ctx_t *ctx);
+void sha256_engine_free(sha256_engine_ctx_t *ctx);
+void sha256_engine_clone(sha256_engine_ctx_t *dst, const sha256_engine_ctx_t *src);
+
+// Streaming hash
+void sha256_engine_starts(sha256_engine_ctx_t *ctx, bool is224);
+void sha256_engine_update(sha256_engine_ctx_t *ctx, const void *data, size_t len);
+void sha256_engine_finish(sha256_engine_ctx_t *ctx, uint8_t *digest);
+
+// One-shot hash
+void sha256_engine_hash(const void *data, size_t len, uint8_t digest[SHA256_ENGINE_DIGEST_SIZE]);
+
+// Hardware control (e.g. to compare against the portable path)
+bool sha256_engine_hw_available(void);
+void sha256_engine_set_hw_enabled(bool enabled);
+
+// Hardware and software throughput in MB/s (hardware 0 when unavailable)
+void sha256_engine_benchmark(float *hw_mb_s, float *sw_mb_s);
+
+#endif // SHA256_ENGINE_H
@@ -0,0 +1,46 @@
+#ifndef STALL_DETECT_H
+#define STALL_DETECT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Stall detector for the UI core. The main loop kicks the detector each
+// time it gets back to lv_timer_handler(); a core0 timer alarm checks the
+// kick every STALL_DETECT_SAMPLE_MS. Once the loop has been away for
+// STALL_DETECT_SOFT_MS the alarm samples what core0 is doing - the stacked
+// PC and LR and the return addresses found on the stack - until the loop
+// comes back, and the main loop then logs the stall's duration and call
+// site. Blocking calls (wifi_connect_blocking(), the BLE connect waits,
+// a TLS handshake in an lwIP callback) show up this way.
+//
+// The alarm also feeds the hardware watchdog. A stall that reaches
+// STALL_DETECT_HARD_MS is taken as a hang: the alarm stops feeding and
+// the watchdog reboots, with the trace kept in uninitialised RAM and
+// printed on the next boot. The watchdog also fires if core0 stops taking
+// interrupts altogether.
+//
+// Addresses are printed in hex; resolve them with
+//   arm-none-eabi-addr2line -fe build/picocalc_omnitool.elf <addr>...
+//
+// Console commands (see console.h):
+//   stall             count, longest and the last stall's trace
+//   stall test <ms>   block the main loop for ms (beyond HARD_MS it reboots)
+#define STALL_DETECT_SAMPLE_MS   20
+#define STALL_DETECT_SOFT_MS     250      // Longer than any normal frame
+#define STALL_DETECT_HARD_MS     30000    // Longer than the Wi-Fi and BLE connect timeouts
+#define STALL_DETECT_WATCHDOG_MS 4000     // Covers a flash erase with interrupts off
+#define STALL_DETECT_SAMPLES     32       // PC/LR samples kept per stall (latest)
+#define STALL_DETECT_STACK_DEPTH 8        // Return addresses from the first sample
+#define STALL_DETECT_SCAN_WORDS  128      // Stack words searched for them
+#define STALL_DETECT_MAGIC       0x4C545350  // "PSTL"
+
+// API Functions
+
+// Claim the alarm, start the watchdog and report a stall that caused the
+// last reboot (core0, after log_init)
+void stall_detect_init(void);
+
+// The main loop reached lv_timer_handler(); logs a stall that just ended
+void stall_detect_kick(void);
+
+#endif // STALL_DETECT_H
@@ -5,7 +5,7 @@
 #include <stdbool.h>
 #include <time.h>
 
-// Maximum number of telegram messages to store
+// Number of recent telegram messages to keep (oldest are dropped first)
 #define MAX_TELEGRAM_MESSAGES 15
 
 // Maximum lengths for telegram data
@@ -62,4 +62,9 @@ telegram_data_t* telegram_api_get_data(void);
 // Get current API state
 telegram_api_state_t telegram_api_get_state(void);
 
+// Parse a getUpdates JSON body into scratch storage, leaving the shown
+// messages alone (benchmarks). Returns the number of messages, -1 if the
+// body has no result array or allocation failed.
+int telegram_api_parse_fixture(const char *json);
+
 #endif // TELEGRAM_API_H
@@ -0,0 +1,62 @@
+#ifndef TLS_ARENA_H
+#define TLS_ARENA_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// Per-connection heap for mbedTLS.
+// mbedtls_platform_set_calloc_free routes every mbedTLS allocation into the
+// arena of the connection currently being serviced. Small, frequently touched
+// objects (bignum limbs, handshake state) are placed in an SRAM pool; large
+// ones (the in/out record buffers) go to a PSRAM region. Both are dropped in
+// one go when the connection closes, so nothing is left to fragment the SRAM
+// heap between requests.
+#define TLS_ARENA_SRAM_SIZE         (12 * 1024)  // SRAM pool per connection
+#define TLS_ARENA_PSRAM_SIZE        (64 * 1024)  // PSRAM region per connection
+#define TLS_ARENA_SMALL_OBJECT_MAX  512          // Allocations up to this size prefer SRAM
+#define TLS_ARENA_MAX_ARENAS        4            // Arenas that can be registered at once
+
+// One memory region managed by the arena
+typedef struct {
+    uint8_t *base;
+    size_t size;
+    size_t used;        // Bytes in live blocks, including headers
+    size_t peak;        // High-water mark of used since the last reset
+    uint32_t allocs;    // Allocations served since the last reset
+} tls_arena_region_t;
+
+// Arena owned by one TLS client
+typedef struct {
+    const char *name;
+    tls_arena_region_t sram;
+    tls_arena_region_t psram;
+    uint32_t failures;  // Allocations that did not fit in either region
+    bool initialized;
+    uint8_t sram_pool[TLS_ARENA_SRAM_SIZE] __attribute__((aligned(8)));
+} tls_arena_t;
+
+// API Functions
+
+// Set up the arena (allocates its PSRAM region once) and install the
+// mbedTLS allocator hooks on first use
+bool tls_arena_init(tls_arena_t *arena, const char *name);
+
+// Make arena the target of subsequent mbedTLS allocations (NULL = libc heap)
+// and return the previous target. Every lwIP callback that drives mbedTLS
+// selects its arena on entry and puts the previous one back on exit, since
+// it may have interrupted mbedTLS code using another arena.
+tls_arena_t *tls_arena_select(tls_arena_t *arena);
+
+// Drop every allocation in the arena at once and reset the peak counters.
+// All mbedTLS contexts using the arena must already be freed.
+void tls_arena_release(tls_arena_t *arena);
+
+// Release the arena and unregister it; mbedTLS allocations go back to the
+// libc heap if it was selected. The PSRAM region is kept for the next init.
+void tls_arena_deinit(tls_arena_t *arena);
+
+// Print peak SRAM/PSRAM usage since the last release
+void tls_arena_report(const tls_arena_t *arena, const char *label);
+
+#endif // TLS_ARENA_H
@@ -0,0 +1,56 @@
+#ifndef TLS_PROFILE_H
+#define TLS_PROFILE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "mbedtls/ssl.h"
+
+// TLS handshake profiler and ciphersuite/curve preferences.
+// The handshake is driven one mbedtls_ssl_handshake_step() at a time so the
+// CPU time spent in each state (ServerKeyExchange verify, ECDH compute,
+// Finished, ...) can be attributed. The server's plaintext flight is sniffed
+// from the receive path to learn the negotiated curve.
+#define TLS_PROFILE_MAX_STATES  32   // Covers every mbedtls_ssl_states value
+
+// Handshake timing for one connection
+typedef struct {
+    const char *host;
+    uint64_t start_us;                      // tls_profile_begin() timestamp
+    uint64_t total_us;                      // Wall time until the handshake finished
+    uint64_t cpu_us;                        // Time spent inside mbedTLS
+    uint32_t state_us[TLS_PROFILE_MAX_STATES];
+    uint16_t group_id;                      // IANA group from ServerKeyExchange (0 = unknown)
+    bool done;
+
+    // Server flight parser (stops at the server's ChangeCipherSpec)
+    uint8_t rec_hdr[5];
+    uint8_t rec_hdr_len;
+    uint16_t rec_remaining;
+    uint8_t hs_hdr[4];
+    uint8_t hs_hdr_len;
+    uint32_t hs_remaining;
+    uint8_t ske[3];
+    uint8_t ske_len;
+    bool sniff_done;
+} tls_profile_t;
+
+// API Functions
+
+// Apply the ciphersuite and curve preference lists to conf.
+// The lists are static, so conf may keep pointing at them.
+void tls_profile_apply_preferences(mbedtls_ssl_config *conf);
+
+// Start profiling a handshake
+void tls_profile_begin(tls_profile_t *prof, const char *host);
+
+// Drop-in replacement for mbedtls_ssl_handshake() that records per-step timing
+int tls_profile_handshake(tls_profile_t *prof, mbedtls_ssl_context *ssl);
+
+// Receive tap (tls_rx_tap_t) - feed it every byte mbedTLS reads
+void tls_profile_observe(void *ctx, const unsigned char *buf, size_t len);
+
+// Print the step breakdown and the negotiated suite/curve
+void tls_profile_report(const tls_profile_t *prof, const mbedtls_ssl_context *ssl);
+
+#endif // TLS_PROFILE_H
@@ -0,0 +1,50 @@
+#ifndef TLS_RX_QUEUE_H
+#define TLS_RX_QUEUE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "lwip/pbuf.h"
+#include "lwip/tcp.h"
+
+// Optional observer of the bytes handed to mbedTLS (used by tls_profile)
+typedef void (*tls_rx_tap_t)(void *ctx, const unsigned char *buf, size_t len);
+
+// Ciphertext receive queue for TLS over lwIP raw TCP.
+// Incoming pbuf chains are queued as-is and handed to mbedTLS straight out of
+// the pbuf payloads; consumed bytes are released from the head of the chain
+// instead of shifting a linear buffer. The TCP window is only reopened
+// (tcp_recved) for bytes mbedTLS has actually consumed.
+typedef struct {
+    struct pbuf *head;        // Unread ciphertext, oldest segment first
+    struct tcp_pcb *pcb;      // Connection to acknowledge consumed bytes on
+    uint32_t bytes_queued;    // Total ciphertext received this connection
+    uint32_t bytes_consumed;  // Total ciphertext handed to mbedTLS
+    tls_rx_tap_t tap;         // Called with every chunk read by mbedTLS
+    void *tap_ctx;
+} tls_rx_queue_t;
+
+// API Functions
+
+// Bind the queue to a new connection (drops anything left from the previous one)
+void tls_rx_queue_init(tls_rx_queue_t *q, struct tcp_pcb *pcb);
+
+// Observe bytes as mbedTLS reads them (cleared by tls_rx_queue_init)
+void tls_rx_queue_set_tap(tls_rx_queue_t *q, tls_rx_tap_t tap, void *ctx);
+
+// Append a received segment chain; the queue takes ownership of p
+void tls_rx_queue_push(tls_rx_queue_t *q, struct pbuf *p);
+
+// Copy up to len bytes out of the queue; returns bytes copied (0 if empty)
+size_t tls_rx_queue_read(tls_rx_queue_t *q, unsigned char *buf, size_t len);
+
+// Bytes waiting to be consumed
+size_t tls_rx_queue_pending(const tls_rx_queue_t *q);
+
+// Free queued segments and detach from the connection
+void tls_rx_queue_reset(tls_rx_queue_t *q);
+
+// mbedTLS BIO receive callback; ctx is the tls_rx_queue_t
+int tls_rx_queue_bio_recv(void *ctx, unsigned char *buf, size_t len);
+
+#endif // TLS_RX_QUEUE_H
@@ -0,0 +1,56 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Hot-path tracer - begin/end/counter events stamped with the core's DWT
+// cycle counter, written into per-core ring buffers in PSRAM. Writing an
+// event is a few stores and an atomic index bump, with no lock and no UART
+// output, so it can be used in IRQ handlers and on both cores. The newest
+// TRACE_RING_EVENTS events per core are kept; trace_dump() streams them in
+// a compact binary format (hex framed for the UART), which
+// tools/trace_decode.py turns into Chrome trace JSON.
+#define TRACE_RING_EVENTS  4096          // Per core, power of two (12 bytes each)
+#define TRACE_SYNC_CYCLES  (1u << 29)    // Max cycles between time sync records
+#define TRACE_MAGIC        0x52544350    // "PCTR"
+#define TRACE_VERSION      1
+
+// Event names; the table in trace.c must follow this order
+typedef enum {
+    TRACE_SYNC,             // Counter: time_us_32() at this cycle count (internal)
+    TRACE_LV_TIMER,         // lv_timer_handler() in the main loop
+    TRACE_DISP_FLUSH,       // LVGL flush callback (SPI transfer)
+    TRACE_TLS_HANDSHAKE,    // One mbedtls_ssl_handshake_step()
+    TRACE_JSON_PARSE,       // News, forecast and Telegram response parsing
+    TRACE_BLE_PACKET,       // BTstack HCI packet handler
+    TRACE_KEY_EVENT,        // Counter: key code
+    TRACE_PSRAM_ALLOC,      // Counter: bytes allocated
+    TRACE_SPS_SENT,         // Counter: bytes written over SPS
+    TRACE_ID_COUNT
+} trace_id_t;
+
+// API Functions
+
+// Allocate the rings and start the cycle counter on core0 (after psram_init)
+void trace_init(void);
+
+// Start the cycle counter on the calling core (core1 entry)
+void trace_core_init(void);
+
+// Record events
+void trace_begin(trace_id_t id);
+void trace_end(trace_id_t id);
+void trace_counter(trace_id_t id, uint32_t value);
+
+// Stream both rings over stdio between "TRACE BEGIN" and "TRACE END" lines
+void trace_dump(void);
+
+// Hex-framed binary output over stdio, also used by other dumps:
+// "<tag> BEGIN", then "<tag>:<hex>" lines of 32 bytes, then "<tag> END"
+void trace_hex_begin(const char *tag);
+void trace_hex_write(const void *data, size_t len);
+void trace_hex_end(void);
+
+#endif // TRACE_H
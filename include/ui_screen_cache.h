@@ -0,0 +1,39 @@
+#ifndef UI_SCREEN_CACHE_H
+#define UI_SCREEN_CACHE_H
+
+#include "lvgl.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// Screen cache - keeps recently used screens alive across transitions.
+// A cached screen is detached (its widgets leave the keypad group) instead
+// of deleted, and re-attached with its previous focus when it is shown
+// again. Screens are charged the LVGL heap they took to build; the least
+// recently used ones are deleted when the budget or the heap runs out.
+#define UI_SCREEN_CACHE_SLOTS      4
+#define UI_SCREEN_CACHE_BUDGET     (16 * 1024)  // LVGL heap cached screens may hold (0 = cache off)
+#define UI_SCREEN_CACHE_MIN_FREE   (8 * 1024)   // Evict before building a screen below this
+#define UI_SCREEN_CACHE_MAX_FOCUS  16           // Group members remembered per screen
+
+// API Functions
+
+// Register a freshly built screen under key, charged heap_cost bytes.
+// Returns false if it does not fit the budget (it is then not cached).
+bool ui_screen_cache_add(int key, lv_obj_t *screen, size_t heap_cost);
+
+// Get the cached screen for key and re-attach it to the keypad group
+lv_obj_t *ui_screen_cache_get(int key);
+
+// Leaving a screen: returns true if it is cached (it has been detached and
+// must not be deleted), false if the caller should delete it
+bool ui_screen_cache_release(lv_obj_t *screen);
+
+// Delete least recently used cached screens until the LVGL heap has
+// min_free bytes available (the active screen is never evicted)
+void ui_screen_cache_trim(size_t min_free);
+
+// Drop every cached screen that is not active
+void ui_screen_cache_clear(void);
+
+#endif // UI_SCREEN_CACHE_H
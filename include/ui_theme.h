@@ -0,0 +1,70 @@
+#ifndef UI_THEME_H
+#define UI_THEME_H
+
+#include "lvgl.h"
+#include <stdint.h>
+
+// ============================================================================
+// MODERN THEME STYLING SYSTEM
+// ============================================================================
+
+// Color palette - Modern dark theme with orange text
+#define THEME_BG_PRIMARY     0x1a1a1a  // Screen background (darkest)
+#define THEME_BG_SECONDARY   0x242424  // Container/list background
+#define THEME_BG_TERTIARY    0x2d2d2d  // Input/card background
+#define THEME_BG_BUTTON      0x3d3d3d  // Button background
+#define THEME_BORDER_LIGHT   0x4a4a4a  // Subtle borders
+#define THEME_BORDER_NORMAL  0x3d3d3d  // Standard borders
+#define THEME_TEXT_PRIMARY   0xffa726  // Titles/headers (bright orange)
+#define THEME_TEXT_SECONDARY 0xff9800  // Body text (orange)
+#define THEME_TEXT_TERTIARY  0xff8a65  // Status/muted text (soft orange)
+#define THEME_TEXT_DISABLED  0xcc7a52  // Placeholder text (muted orange)
+#define THEME_ACCENT_SUCCESS 0x4caf50  // Success states (green)
+#define THEME_ACCENT_ERROR   0xf44336  // Error states (red)
+
+// Font hierarchy (Montserrat, minimum 12px for body text)
+#define FONT_TITLE &lv_font_montserrat_14  // Screen titles
+#define FONT_BODY  &lv_font_montserrat_12  // Body text, labels, buttons
+#define FONT_SMALL &lv_font_montserrat_10  // Small details (use sparingly)
+
+// Spacing constants
+#define PADDING_SMALL  5
+#define PADDING_NORMAL 10
+#define PADDING_LARGE  20
+#define BORDER_THIN    1
+
+// Shared styles. Each is a single static lv_style_t attached with
+// lv_obj_add_style(), so widgets reference it instead of carrying their own
+// local style properties in the LVGL heap.
+typedef enum {
+    UI_STYLE_SCREEN,
+    UI_STYLE_TITLE,
+    UI_STYLE_BODY,
+    UI_STYLE_STATUS,
+    UI_STYLE_BUTTON,
+    UI_STYLE_BUTTON_LABEL,
+    UI_STYLE_TEXTAREA,
+    UI_STYLE_DROPDOWN,
+    UI_STYLE_DROPDOWN_LIST,
+    UI_STYLE_DROPDOWN_SELECTED,  // LV_PART_SELECTED of the dropdown list
+    UI_STYLE_FOCUSED,            // LV_STATE_FOCUS_KEY outline for lists
+    UI_STYLE_LIST,
+    UI_STYLE_LIST_SCROLLBAR,     // LV_PART_SCROLLBAR of a list viewport
+    UI_STYLE_LIST_ROW,
+    UI_STYLE_LIST_ROW_SELECTED,  // LV_STATE_CHECKED of a list row
+    UI_STYLE_COUNT
+} ui_style_id_t;
+
+// API Functions
+
+// Initialize the shared styles (after lv_init, before any screen is built)
+void ui_theme_init(void);
+
+// Get a shared style
+lv_style_t *ui_theme_style(ui_style_id_t id);
+
+// Print object count, the LVGL heap the screen took to build and the
+// average style property lookup time (walks the tree; console use only)
+void ui_theme_report_screen(lv_obj_t *screen, const char *name, size_t heap_used);
+
+#endif // UI_THEME_H
@@ -0,0 +1,81 @@
+#ifndef UI_VLIST_H
+#define UI_VLIST_H
+
+#include "lvgl.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// Virtualized list widget.
+// Only the rows inside the viewport (plus UI_VLIST_MARGIN_ROWS above and
+// below) exist as LVGL objects. Rows are recycled by index modulo the pool
+// size and rebound through the data-source callback as the list scrolls, so
+// a 1000-item list costs the same objects and heap as a 10-item one.
+// Rows have a fixed height; labels longer than the row are cut with "...".
+//
+// The list is a single focusable object: Up/Down move the selection,
+// Home/End jump to the ends and Enter activates the selected row.
+#define UI_VLIST_MARGIN_ROWS 1
+#define UI_VLIST_MAX_POOL    24   // Upper bound on live rows per list
+
+// Data source: set the text of a row label for item index
+typedef void (*ui_vlist_bind_cb_t)(lv_obj_t *label, uint32_t index, void *user_data);
+
+// Enter pressed on the selected item
+typedef void (*ui_vlist_select_cb_t)(lv_obj_t *vlist, uint32_t index, void *user_data);
+
+// Style a pooled row once, when it is created
+typedef void (*ui_vlist_row_init_cb_t)(lv_obj_t *row, lv_obj_t *label);
+
+// List configuration
+typedef struct {
+    int32_t row_height;
+    ui_vlist_bind_cb_t bind_cb;
+    ui_vlist_select_cb_t select_cb;       // Optional
+    ui_vlist_row_init_cb_t row_init_cb;   // Optional
+    void *user_data;
+} ui_vlist_config_t;
+
+// Row recycling counters (since creation)
+typedef struct {
+    uint32_t rows_live;      // Row objects in the pool
+    uint32_t binds;          // Rows rebound to a different item
+    uint32_t rebind_passes;  // Scroll / data updates processed
+} ui_vlist_stats_t;
+
+// ui_vlist_benchmark() result
+typedef struct {
+    uint32_t rows_live;      // Row objects in the pool
+    uint32_t heap_bytes;     // LVGL heap taken by the list
+    uint32_t step_us;        // Average time per selection step
+    uint32_t binds;          // Rows rebound during the walk
+} ui_vlist_bench_t;
+
+// API Functions
+
+// Create a list; size it with lv_obj_set_size() before setting the count
+lv_obj_t *ui_vlist_create(lv_obj_t *parent, const ui_vlist_config_t *config);
+
+// Set the number of items. Rows that come into view are bound; rows that
+// already show an item keep it (call ui_vlist_refresh() if items changed).
+// The selection is clamped to the new count.
+void ui_vlist_set_count(lv_obj_t *vlist, uint32_t count);
+uint32_t ui_vlist_get_count(lv_obj_t *vlist);
+
+// Rebind the visible rows after the data behind them changed
+void ui_vlist_refresh(lv_obj_t *vlist);
+
+// Select an item and scroll it into view
+void ui_vlist_set_selected(lv_obj_t *vlist, uint32_t index);
+uint32_t ui_vlist_get_selected(lv_obj_t *vlist);
+
+// Scrollable viewport (for scrollbar styling)
+lv_obj_t *ui_vlist_get_viewport(lv_obj_t *vlist);
+
+// Recycling counters
+void ui_vlist_get_stats(lv_obj_t *vlist, ui_vlist_stats_t *stats);
+
+// Scroll a list of count items end to end on an off-screen parent and
+// measure the LVGL heap it uses and the time per scroll step
+void ui_vlist_benchmark(uint32_t count, ui_vlist_bench_t *result);
+
+#endif // UI_VLIST_H
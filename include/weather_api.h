@@ -79,6 +79,10 @@ weather_data_t* weather_api_get_data(void);
 weather_api_state_t weather_api_get_state(void);
 void weather_api_cleanup(void);  // Free map image memory
 
+// Parse a JSON body with the forecast parser into scratch storage, leaving
+// the published data alone (benchmarks). Returns the forecast count.
+int weather_api_parse_fixture(const char *json);
+
 // Utility: Get weather emoji from icon code
 const char* weather_get_emoji(const char *icon_code);
 
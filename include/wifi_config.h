@@ -4,9 +4,11 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "pico/cyw43_arch.h"
+#include "sha256_engine.h"
 
 // Flash storage configuration
-#define WIFI_CONFIG_MAGIC 0x57494649  // "WIFI" in hex
+#define WIFI_CONFIG_MAGIC 0x57494632  // "WIF2" in hex, SHA-256 digest
+#define WIFI_CONFIG_MAGIC_CRC32 0x57494649  // "WIFI" in hex, older records with a CRC32
 #define WIFI_CONFIG_FLASH_OFFSET (PICO_FLASH_SIZE_BYTES - FLASH_SECTOR_SIZE)  // Last 4KB sector
 #define WIFI_SSID_MAX_LEN 32
 #define WIFI_PASS_MAX_LEN 64
@@ -22,7 +24,7 @@ typedef struct {
     char ssid[WIFI_SSID_MAX_LEN + 1];       // Network SSID
     char password[WIFI_PASS_MAX_LEN + 1];   // Network password
     uint32_t auth_mode;                      // CYW43_AUTH_* constant
-    uint32_t crc32;                          // Data integrity check
+    uint8_t digest[SHA256_ENGINE_DIGEST_SIZE];  // SHA-256 of everything above (CRC32 in older records)
 } wifi_config_t;
 
 // Single scan result
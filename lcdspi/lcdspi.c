@@ -8,6 +8,7 @@
 #include "hardware/xip_cache.h"
 #include <ctype.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "lcdspi.h"
 #include "i2ckbd.h"
@@ -33,7 +34,35 @@ static int dma_tx_channel = -1;
 static uint8_t *dma_buffer = NULL;
 static size_t dma_buffer_size = 0;
 
+// Glyph-run text renderer: consecutive console glyphs on a text row are
+// expanded together into the DMA buffer and sent with one region define
+#define GLYPH_MAX_WIDTH 16
+static uint16_t *glyph_rows = NULL;         // Per-glyph scan lines, leftmost pixel in bit 15
+static uint8_t glyph_expand[16][12];        // 4 scan line bits -> 4 RGB888 pixels
+static bool glyph_expand_valid = false;
+static int glyph_expand_fc, glyph_expand_bc;
+static unsigned char text_run[LCD_WIDTH];   // Pending glyphs of the current run
+static int text_run_len = 0;
+static short text_run_x, text_run_y;
+static int text_run_fc, text_run_bc;
+static bool text_runs_enabled = true;
+
+// Hardware vertical scrolling: rows vscroll_top..vscroll_top+vscroll_height-1
+// are a ring in frame memory and logical row y of that area is stored at
+// vscroll_top + (y - vscroll_top + vscroll_offset) % vscroll_height
+#define LCD_MEMORY_ROWS 480                 // Frame memory rows (TFA + VSA + BFA)
+static int vscroll_top = 0;
+static int vscroll_height = 0;              // 0: no scroll area defined
+static int vscroll_offset = 0;
+static bool vscroll_enabled = true;
+
+// SPI bytes moved to/from the panel, for the scroll and text measurements
+static uint32_t spi_bytes = 0;
+
+static void text_run_flush(void);
+
 void __not_in_flash_func(spi_write_fast)(spi_inst_t *spi, const uint8_t *src, size_t len) {
+    spi_bytes += len;
     // Write to TX FIFO whilst ignoring RX, then clean up afterward. When RX
     // is full, PL022 inhibits RX pushes, and sets a sticky flag on
     // push-on-full, but continues shifting. Safe if SSPIMSC_RORIM is not set.
@@ -65,6 +94,28 @@ void set_font() {
 
     s_height = vres / gui_font_height;
     s_width = hres / gui_font_width;
+
+    // Precompute the scan lines of every glyph for the run renderer
+    free(glyph_rows);
+    glyph_rows = NULL;
+    if (gui_font_width > GLYPH_MAX_WIDTH) return;
+
+    int width = gui_font_width, height = gui_font_height;
+    glyph_rows = (uint16_t *) malloc(MainFont[3] * height * sizeof(uint16_t));
+    if (glyph_rows == NULL) return;
+
+    for (int g = 0; g < MainFont[3]; g++) {
+        unsigned char *bitmap = MainFont + 4 + (g * height * width) / 8;
+        for (int i = 0; i < height; i++) {
+            uint16_t bits = 0;
+            for (int k = 0; k < width; k++) {
+                // Same bit order as draw_bitmap_spi()
+                if ((bitmap[((i * width) + k) / 8] >> (((height * width) - ((i * width) + k) - 1) % 8)) & 1)
+                    bits |= 0x8000 >> k;
+            }
+            glyph_rows[g * height + i] = bits;
+        }
+    }
 }
 
 void define_region_spi(int xstart, int ystart, int xend, int yend, int rw) {
@@ -95,9 +146,73 @@ void define_region_spi(int xstart, int ystart, int xend, int yend, int rw) {
     gpio_put(Pico_LCD_DC, 1);
 }
 
+// Frame memory row of a logical row
+static int vscroll_row(int y) {
+    if (vscroll_offset == 0 || y < vscroll_top || y >= vscroll_top + vscroll_height) return y;
+    return vscroll_top + (y - vscroll_top + vscroll_offset) % vscroll_height;
+}
+
+// Define the region for logical rows y..yend, up to where the scroll area
+// wraps in frame memory. Returns the number of rows covered; callers loop
+// until all rows are sent (one pass unless the rows cross the wrap).
+static int define_rows_spi(int xstart, int y, int xend, int yend, int rw) {
+    int rows = yend - y + 1;
+    int py = vscroll_row(y);
+
+    if (vscroll_offset != 0) {
+        if (y < vscroll_top) {
+            if (rows > vscroll_top - y) rows = vscroll_top - y;
+        } else if (y < vscroll_top + vscroll_height) {
+            int wrap = vscroll_top + vscroll_height - py;   // rows before memory wraps
+            int area = vscroll_top + vscroll_height - y;    // rows left in the area
+            if (rows > wrap) rows = wrap;
+            if (rows > area) rows = area;
+        }
+    }
+    define_region_spi(xstart, py, xend, py + rows - 1, rw);
+    return rows;
+}
+
+// Set rows top..top+height-1 as the hardware scroll area (VSCRDEF) and
+// reset its start line. The rows must be redrawn afterwards.
+void lcd_vscroll_define(int top, int height) {
+    int bottom = LCD_MEMORY_ROWS - top - height;
+
+    text_run_flush();
+    spi_write_cd(ILI9341_VSCRDEF, 6, top >> 8, top, height >> 8, height, bottom >> 8, bottom);
+    spi_write_cd(ILI9341_VSCRSADD, 2, top >> 8, top);
+    vscroll_top = top;
+    vscroll_height = height;
+    vscroll_offset = 0;
+}
+
+// Move the content of the scroll area up by lines (down if negative) by
+// changing the display start line (VSCRSADD). The rows that scroll in
+// still show old content and have to be drawn by the caller.
+void lcd_vscroll_by(int lines) {
+    if (vscroll_height == 0) return;
+
+    text_run_flush();
+    vscroll_offset = ((vscroll_offset + lines) % vscroll_height + vscroll_height) % vscroll_height;
+    int start = vscroll_top + vscroll_offset;
+    spi_write_cd(ILI9341_VSCRSADD, 2, start >> 8, start);
+}
+
+// True when the panel is scrolled and logical rows no longer match frame memory
+bool lcd_vscroll_active(void) {
+    return vscroll_offset != 0;
+}
+
+// SPI bytes transferred to/from the panel since power up
+uint32_t lcd_spi_bytes(void) {
+    return spi_bytes;
+}
+
 void read_buffer_spi(int x1, int y1, int x2, int y2, unsigned char *p) {
     int r, N, t;
     unsigned char h, l;
+
+    text_run_flush();
 //	PInt(x1);PIntComma(y1);PIntComma(x2);PIntComma(y2);PRet();
     // make sure the coordinates are kept within the display area
     if (x2 <= x1) {
@@ -120,17 +235,22 @@ void read_buffer_spi(int x1, int y1, int x2, int y2, unsigned char *p) {
     if (y2 >= vres) y2 = vres - 1;
     N = (x2 - x1 + 1) * (y2 - y1 + 1) * 3;
 
-    define_region_spi(x1, y1, x2, y2, 0);
-
-    //spi_init(Pico_LCD_SPI_MOD, 6000000);
-    spi_set_baudrate(Pico_LCD_SPI_MOD, 6000000);
-    //spi_read_data_len(p, 1);
-    hw_read_spi((uint8_t *) p, 1);
     r = 0;
-    hw_read_spi((uint8_t *) p, N);
-    gpio_put(Pico_LCD_DC, 0);
-    lcd_spi_raise_cs();
-    spi_set_baudrate(Pico_LCD_SPI_MOD, LCD_SPI_SPEED);
+    for (int y = y1; y <= y2;) {
+        int rows = define_rows_spi(x1, y, x2, y2, 0);
+        int n = (x2 - x1 + 1) * rows * 3;
+
+        //spi_init(Pico_LCD_SPI_MOD, 6000000);
+        spi_set_baudrate(Pico_LCD_SPI_MOD, 6000000);
+        //spi_read_data_len(p, 1);
+        hw_read_spi((uint8_t *) p + r, 1);
+        hw_read_spi((uint8_t *) p + r, n);
+        gpio_put(Pico_LCD_DC, 0);
+        lcd_spi_raise_cs();
+        spi_set_baudrate(Pico_LCD_SPI_MOD, LCD_SPI_SPEED);
+        r += n;
+        y += rows;
+    }
     r = 0;
 
     while (N) {
@@ -143,9 +263,36 @@ void read_buffer_spi(int x1, int y1, int x2, int y2, unsigned char *p) {
     }
 }
 
+// Send a buffer through the SPI TX FIFO with DMA and wait until it is out
+static void dma_send_spi(const uint8_t *buf, size_t len) {
+    // Configure DMA channel for SPI transfer
+    dma_channel_config c = dma_channel_get_default_config(dma_tx_channel);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_dreq(&c, spi_get_dreq(Pico_LCD_SPI_MOD, true));
+
+    // Start DMA transfer
+    dma_channel_configure(
+        dma_tx_channel,
+        &c,
+        &spi_get_hw(Pico_LCD_SPI_MOD)->dr,  // Write to SPI TX FIFO
+        buf,                                  // Read from buffer
+        len,                                  // Transfer count
+        true                                  // Start immediately
+    );
+
+    // Wait for DMA to complete
+    dma_channel_wait_for_finish_blocking(dma_tx_channel);
+
+    // Wait for SPI to finish transmitting
+    while (spi_is_busy(Pico_LCD_SPI_MOD)) tight_loop_contents();
+    spi_bytes += len;
+}
+
 void draw_buffer_spi(int x1, int y1, int x2, int y2, unsigned char *p) {
     int t;
 
+    text_run_flush();
+
     // Boundary checking
     if (x2 <= x1) {
         t = x1;
@@ -188,34 +335,23 @@ void draw_buffer_spi(int x1, int y1, int x2, int y2, unsigned char *p) {
             dma_buffer[i * 3 + 2] = (b5 << 3) | (b5 >> 2);  // Blue
         }
 
-        define_region_spi(x1, y1, x2, y2, 1);
-
-        // Configure DMA channel for SPI transfer
-        dma_channel_config c = dma_channel_get_default_config(dma_tx_channel);
-        channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
-        channel_config_set_dreq(&c, spi_get_dreq(Pico_LCD_SPI_MOD, true));
-
-        // Start DMA transfer
-        dma_channel_configure(
-            dma_tx_channel,
-            &c,
-            &spi_get_hw(Pico_LCD_SPI_MOD)->dr,  // Write to SPI TX FIFO
-            dma_buffer,                           // Read from buffer
-            rgb888_size,                          // Transfer count
-            true                                  // Start immediately
-        );
-
-        // Wait for DMA to complete
-        dma_channel_wait_for_finish_blocking(dma_tx_channel);
-
-        // Wait for SPI to finish transmitting
-        while (spi_is_busy(Pico_LCD_SPI_MOD)) tight_loop_contents();
+        size_t row_bytes = (size_t) (x2 - x1 + 1) * 3;
+        for (int y = y1; y <= y2;) {
+            int rows = define_rows_spi(x1, y, x2, y2, 1);
+            dma_send_spi(dma_buffer + (y - y1) * row_bytes, rows * row_bytes);
+            y += rows;
+        }
 
     } else {
         // Fallback to non-DMA transfer (for large buffers or if DMA not available)
-        define_region_spi(x1, y1, x2, y2, 1);
+        int row_end = -1;
 
         for (int i = 0; i < pixelCount; i++) {
+            int y = y1 + i / (x2 - x1 + 1);
+            if (y > row_end) {
+                row_end = y + define_rows_spi(x1, y, x2, y2, 1) - 1;
+            }
+
             uint16_t pixel = pixelBuffer[i];
 
             // Extract RGB565 components
@@ -233,8 +369,11 @@ void draw_buffer_spi(int x1, int y1, int x2, int y2, unsigned char *p) {
     }
 #else
     // For non-ILI9488 displays (original 16-bit mode)
-    define_region_spi(x1, y1, x2, y2, 1);
-    hw_send_spi(p, pixelCount * 2);
+    for (int y = y1; y <= y2;) {
+        int rows = define_rows_spi(x1, y, x2, y2, 1);
+        hw_send_spi(p + (y - y1) * (x2 - x1 + 1) * 2, (x2 - x1 + 1) * rows * 2);
+        y += rows;
+    }
 #endif
 
     lcd_spi_raise_cs();
@@ -256,6 +395,7 @@ void draw_bitmap_spi(int x1, int y1, int width, int height, int scale, int fc, i
         unsigned int rgb;
     } c;
 
+    text_run_flush();
     if (x1 >= hres || y1 >= vres || x1 + width * scale < 0 || y1 + height * scale < 0)return;
     // adjust when part of the bitmap is outside the displayable coordinates
     vertCoord = y1;
@@ -278,7 +418,7 @@ void draw_bitmap_spi(int x1, int y1, int width, int height, int scale, int fc, i
 
 #endif
     //printf("draw_bitmap_spi-> XStart %d, y1 %d, XEnd %d, YEnd %d\n",XStart,y1,XEnd,YEnd);
-    define_region_spi(XStart, y1, XEnd, YEnd, 1);
+    int row_end = -1;
 
     n = 0;
     for (i = 0; i < height; i++) {                                   // step thru the font scan line by line
@@ -288,6 +428,9 @@ void draw_bitmap_spi(int x1, int y1, int width, int height, int scale, int fc, i
                 lcd_spi_raise_cs();                                  //set CS high
                 return;
             }
+            if (vertCoord - 1 > row_end) {                           // (re)define the region, split at the scroll wrap
+                row_end = vertCoord - 1 + define_rows_spi(XStart, vertCoord - 1, XEnd, YEnd, 1) - 1;
+            }
             horizCoord = x1;
             for (k = 0; k < width; k++) {                            // step through each bit in a scan line
                 for (m = 0; m < scale; m++) {                        // repeat pixels to scale in the x axis
@@ -324,12 +467,14 @@ void draw_bitmap_spi(int x1, int y1, int width, int height, int scale, int fc, i
 void draw_rect_spi(int x1, int y1, int x2, int y2, int c) {
     // convert the colours to 565 format
     unsigned char col[3];
+
+    text_run_flush();
     if (x1 == x2 && y1 == y2) {
         if (x1 < 0) return;
         if (x1 >= hres) return;
         if (y1 < 0) return;
         if (y1 >= vres) return;
-        define_region_spi(x1, y1, x2, y2, 1);
+        define_region_spi(x1, vscroll_row(y1), x2, vscroll_row(y2), 1);
 #ifdef ILI9488
         col[0] = (c >> 16);
         col[1] = (c >> 8) & 0xFF;
@@ -358,7 +503,6 @@ void draw_rect_spi(int x1, int y1, int x2, int y2, int c) {
         if (y1 >= vres) y1 = vres - 1;
         if (y2 < 0) y2 = 0;
         if (y2 >= vres) y2 = vres - 1;
-        define_region_spi(x1, y1, x2, y2, 1);
 #ifdef ILI9488
         i = x2 - x1 + 1;
         i *= 3;
@@ -371,8 +515,12 @@ void draw_rect_spi(int x1, int y1, int x2, int y2, int c) {
             p[t + 1] = col[1];
             p[t + 2] = col[2];
         }
-        for (y = y1; y <= y2; y++) {
-            spi_write_fast(Pico_LCD_SPI_MOD, p, i);
+        for (y = y1; y <= y2;) {
+            int rows = define_rows_spi(x1, y, x2, y2, 1);
+            for (; rows > 0; rows--, y++) {
+                spi_write_fast(Pico_LCD_SPI_MOD, p, i);
+            }
+            spi_finish(Pico_LCD_SPI_MOD);
         }
 #endif
     }
@@ -380,6 +528,88 @@ void draw_rect_spi(int x1, int y1, int x2, int y2, int c) {
     lcd_spi_raise_cs();
 }
 
+// Build the 4 bit -> 4 pixel expansion table for a colour pair
+static void glyph_expand_set_colours(int fc, int bc) {
+    if (glyph_expand_valid && fc == glyph_expand_fc && bc == glyph_expand_bc) return;
+
+    for (int n = 0; n < 16; n++) {
+        for (int k = 0; k < 4; k++) {
+            int c = (n & (0x8 >> k)) ? fc : bc;
+            glyph_expand[n][k * 3] = c >> 16;
+            glyph_expand[n][k * 3 + 1] = (c >> 8) & 0xFF;
+            glyph_expand[n][k * 3 + 2] = c & 0xFF;
+        }
+    }
+    glyph_expand_fc = fc;
+    glyph_expand_bc = bc;
+    glyph_expand_valid = true;
+}
+
+// Draw the pending glyph run: expand every scan line of the run into the
+// DMA buffer, then send it with one region define and one DMA transfer
+static void text_run_flush(void) {
+    int len = text_run_len;
+    if (len == 0) return;
+    text_run_len = 0;
+
+    int width = gui_font_width, height = gui_font_height;
+    size_t pitch = (size_t) len * width * 3;
+    uint8_t *p = dma_buffer;
+
+    glyph_expand_set_colours(text_run_fc, text_run_bc);
+    for (int i = 0; i < height; i++) {
+        for (int n = 0; n < len; n++) {
+            uint16_t bits = glyph_rows[(text_run[n] - MainFont[2]) * height + i];
+            for (int k = 0; k < width; k += 4) {
+                int pixels = (width - k < 4) ? width - k : 4;
+                memcpy(p, glyph_expand[(bits >> (12 - k)) & 0xF], pixels * 3);
+                p += pixels * 3;
+            }
+        }
+    }
+
+    for (int y = 0; y < height;) {
+        int rows = define_rows_spi(text_run_x, text_run_y + y, text_run_x + len * width - 1,
+                                   text_run_y + height - 1, 1);
+        dma_send_spi(dma_buffer + y * pitch, rows * pitch);
+        y += rows;
+    }
+    lcd_spi_raise_cs();
+}
+
+// Queue a glyph at the current position. Returns false if it has to be
+// drawn on its own (partly off screen, transparent background, no DMA).
+static bool text_run_append(int fc, int bc, char c) {
+    int width = gui_font_width, height = gui_font_height;
+
+    if (!text_runs_enabled || glyph_rows == NULL || dma_buffer == NULL || dma_tx_channel < 0 || bc == -1)
+        return false;
+    if (current_x < 0 || current_y < 0 || current_x + width > hres || current_y + height > vres)
+        return false;
+    if ((size_t) hres * height * 3 > dma_buffer_size)
+        return false;
+
+    // A glyph that doesn't continue the pending run starts a new one
+    if (text_run_len > 0 &&
+        (current_y != text_run_y || current_x != text_run_x + text_run_len * width ||
+         fc != text_run_fc || bc != text_run_bc)) {
+        text_run_flush();
+    }
+    if (text_run_len == 0) {
+        text_run_x = current_x;
+        text_run_y = current_y;
+        text_run_fc = fc;
+        text_run_bc = bc;
+    }
+    text_run[text_run_len++] = (unsigned char) c;
+    return true;
+}
+
+// Draw any console text still pending in the glyph run
+void lcd_text_flush(void) {
+    text_run_flush();
+}
+
 /******************************************************************************************
  Print a char on the LCD display
  Any characters not in the font will print as a space.
@@ -399,6 +629,10 @@ void lcd_print_char( int fc, int bc, char c, int orientation) {
     //printf("fp %d, c %d ,height %d width %d\n",fp,c, height,width);
 
     if (c >= fp[2] && c < fp[2] + fp[3]) {
+        if (text_run_append(fc, bc, c)) {
+            if (orientation == ORIENT_NORMAL) current_x += width * scale;
+            return;
+        }
         p = fp + 4 + (int) (((c - fp[2]) * height * width) / 8);
         //printf("p = %d\n",p);
         np = p;
@@ -417,6 +651,14 @@ unsigned char scrollbuff[LCD_WIDTH * 3];
 
 void scroll_lcd_spi(int lines) {
     if (lines == 0)return;
+    if (vscroll_enabled) {
+        // Move the start line and only draw the rows that scroll in
+        if (vscroll_top != 0 || vscroll_height != vres) lcd_vscroll_define(0, vres);
+        lcd_vscroll_by(lines);
+        if (lines > 0) draw_rect_spi(0, vres - lines, hres - 1, vres - 1, gui_bcolour);
+        else draw_rect_spi(0, 0, hres - 1, -lines - 1, gui_bcolour);
+        return;
+    }
     if (lines >= 0) {
         for (int i = 0; i < vres - lines; i++) {
             read_buffer_spi(0, i + lines, hres - 1, i + lines, scrollbuff);
@@ -478,7 +720,8 @@ void display_put_c(char c) {
  *
 ****////
 char lcd_put_char(char c, int flush) {
-    lcd_putc(0, c);
+    display_put_c(c);
+    if (flush) text_run_flush();
     if (isprint(c)) lcd_char_pos++;
     if (c == '\r') {
         lcd_char_pos = 1;
@@ -502,6 +745,78 @@ void lcd_clear() {
 
 void lcd_putc(uint8_t devn, uint8_t c) {
     display_put_c(c);
+    text_run_flush();
+}
+
+// Time console text drawn per char (draw_bitmap_spi) and in glyph runs, in chars/s
+void lcd_text_benchmark(uint32_t *per_char, uint32_t *runs_rate) {
+    static const char text[] = "The quick brown fox jumps over the lazy dog. 0123456789 ";
+    uint32_t rate[2];
+
+    for (int runs = 0; runs < 2; runs++) {
+        uint32_t chars = 0;
+        text_runs_enabled = runs;
+
+        uint64_t start = time_us_64();
+        for (current_y = 0; current_y + gui_font_height <= vres; current_y += gui_font_height) {
+            for (current_x = 0; current_x + gui_font_width <= hres;) {
+                lcd_print_char(gui_fcolour, gui_bcolour, text[chars++ % (sizeof(text) - 1)], ORIENT_NORMAL);
+            }
+        }
+        text_run_flush();
+        uint32_t elapsed = (uint32_t) (time_us_64() - start);
+
+        rate[runs] = (uint32_t) ((uint64_t) chars * 1000000 / (elapsed ? elapsed : 1));
+    }
+    text_runs_enabled = true;
+    *per_char = rate[0];
+    *runs_rate = rate[1];
+
+    lcd_clear();
+    current_x = current_y = 0;
+}
+
+// Scroll the console one text row at a time by redrawing and with the
+// hardware start line; SPI bytes and time per scrolled line for each
+void lcd_scroll_benchmark(uint32_t *redraw_bytes, uint32_t *redraw_us, uint32_t *hw_bytes, uint32_t *hw_us) {
+    const int steps = 8;
+    uint32_t bytes[2], us[2];
+    int saved_top = vscroll_top, saved_height = vscroll_height, saved_offset = vscroll_offset;
+
+    for (int hw = 0; hw < 2; hw++) {
+        vscroll_enabled = hw;
+        lcd_clear();
+        current_x = current_y = 0;
+        for (int i = 0; i < vres / gui_font_height; i++) {
+            lcd_print_string("Scroll benchmark line\n");
+        }
+
+        uint32_t bytes_start = spi_bytes;
+        uint64_t start = time_us_64();
+        for (int i = 0; i < steps; i++) {
+            scroll_lcd_spi(gui_font_height);
+        }
+        us[hw] = (uint32_t) (time_us_64() - start);
+        bytes[hw] = spi_bytes - bytes_start;
+    }
+    vscroll_enabled = true;
+
+    int lines = steps * gui_font_height;
+    *redraw_bytes = bytes[0] / lines;
+    *redraw_us = us[0] / lines;
+    *hw_bytes = bytes[1] / lines;
+    *hw_us = us[1] / lines;
+
+    lcd_clear();
+    current_x = current_y = 0;
+
+    // Put back the scroll area LVGL's hardware scrolling left (it keeps its own copy)
+    if (saved_height > 0) {
+        lcd_vscroll_define(saved_top, saved_height);
+        lcd_vscroll_by(saved_offset);
+    } else {
+        lcd_vscroll_define(0, vres);
+    }
 }
 
 int lcd_getc(uint8_t devn) {
@@ -517,10 +832,12 @@ unsigned char __not_in_flash_func(hw1_swap_spi)(unsigned char data_out) {
 }
 
 void hw_read_spi(unsigned char *buff, int cnt) {
+    spi_bytes += cnt;
     spi_read_blocking(Pico_LCD_SPI_MOD, 0xff, buff, cnt);
 }
 
 void hw_send_spi(const unsigned char *buff, int cnt) {
+    spi_bytes += cnt;
 
     spi_write_blocking(Pico_LCD_SPI_MOD, buff, cnt);
 
@@ -39,6 +39,8 @@
 #define ILI9341_PAGEADDRSET     0x2B
 #define ILI9341_MEMORYWRITE     0x2C
 #define ILI9341_RAMRD           0x2E
+#define ILI9341_VSCRDEF         0x33
+#define ILI9341_VSCRSADD        0x37
 
 #define ILI9341_Portrait        ILI9341_MADCTL_MX | ILI9341_MADCTL_BGR
 
@@ -136,6 +138,16 @@ void draw_buffer_spi(int x1, int y1, int x2, int y2, unsigned char *p);
 
 extern char lcd_put_char(char c, int flush);
 extern void lcd_print_string(char* s);
+extern void lcd_text_flush(void);
+extern void lcd_text_benchmark(uint32_t *per_char, uint32_t *runs_rate);
+extern void lcd_scroll_benchmark(uint32_t *redraw_bytes, uint32_t *redraw_us, uint32_t *hw_bytes, uint32_t *hw_us);
+
+// Hardware vertical scrolling. Drawing keeps using screen coordinates;
+// rows inside the scroll area are mapped to where they are in frame memory.
+extern void lcd_vscroll_define(int top, int height);
+extern void lcd_vscroll_by(int lines);
+extern bool lcd_vscroll_active(void);
+extern uint32_t lcd_spi_bytes(void);
 
 extern void lcd_spi_init();
 extern void lcd_init();
@@ -0,0 +1,1045 @@
+#include "bench.h"
+#include "bench_fixtures.h"
+#include "psram_helper.h"
+#include "wifi_config.h"
+#include "news_api.h"
+#include "weather_api.h"
+#include "telegram_api.h"
+#include "tls_arena.h"
+#include "tls_profile.h"
+#include "tls_rx_queue.h"
+#include "sha256_engine.h"
+#include "blend_rgb565.h"
+#include "ui_vlist.h"
+#include "console.h"
+#include "log.h"
+#include "version.h"
+#include "lcdspi/lcdspi.h"
+#include "lv_port_disp_picocalc_ILI9488.h"
+#include "lvgl.h"
+#include "libs/lodepng/lodepng.h"
+#include "pico/stdlib.h"
+#include "pico/cyw43_arch.h"
+#include "hardware/clocks.h"
+#include "hardware/regs/addressmap.h"
+#include "mbedtls/ssl.h"
+#include "mbedtls/ctr_drbg.h"
+#include "mbedtls/x509_crt.h"
+#include "mbedtls/pk.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_LCD_W          320
+#define BENCH_LCD_H          320
+#define BENCH_STRIP_H        160            // Same strip height as the LVGL draw buffer
+#define BENCH_TILE           64             // Partial update size
+#define BENCH_FLASH_STREAM   (256 * 1024)   // Larger than the XIP cache
+#define BENCH_FLASH_UNCACHED (64 * 1024)
+#define BENCH_NEWS_ARTICLES  20
+#define BENCH_FORECASTS      40             // Entries in a real 5-day forecast
+#define BENCH_UPDATES        15             // One full message list
+#define BENCH_TLS_PIPE_SIZE  4096
+#define BENCH_TLS_HOST       "bench.local"
+#define BENCH_RX_STREAM      (64 * 1024)    // Synthetic ciphertext fed through each receive path
+#define BENCH_RX_MAX_RECORD  4096           // Largest record body in the stream
+#define BENCH_RX_LINEAR      16384          // The linear buffer the old receive path used
+#define BENCH_CONSOLE_TICK_MS 50
+#define BENCH_SCROLL_ROWS    40             // Label rows in the hardware scroll test list
+
+typedef struct {
+    const char *name;
+    void (*run)(void);
+    bool draws;
+} bench_test_t;
+
+// One direction of the in-memory TLS connection
+typedef struct {
+    uint8_t buf[BENCH_TLS_PIPE_SIZE];
+    size_t len;
+} bench_pipe_t;
+
+// One TLS peer's ends of the two pipes
+typedef struct {
+    bench_pipe_t *tx;
+    bench_pipe_t *rx;
+} bench_link_t;
+
+// Reads up to len bytes of ciphertext; 0 when nothing is queued
+typedef size_t (*bench_rx_read_t)(void *ctx, unsigned char *buf, size_t len);
+
+// TLS record reader state
+typedef struct {
+    uint8_t *rec;           // Header and body of the record being read
+    size_t have;
+    size_t need;
+    uint32_t records;
+    uint32_t sum;           // Last byte of every record, to compare the paths
+} bench_rx_reader_t;
+
+// The receive path before tls_rx_queue: segments appended to a linear
+// buffer, every read shifts what is left to the front
+typedef struct {
+    uint8_t *buf;
+    size_t len;
+    uint32_t moved;         // Bytes shifted by memmove
+} bench_linear_rx_t;
+
+static uint8_t *g_scratch = NULL;       // PSRAM, allocated on first use
+static const char *g_test = "";
+static bench_result_cb_t g_cb = NULL;
+static void *g_cb_data = NULL;
+static uint64_t g_suite_start = 0;
+static int g_tests_run = 0;
+static volatile uint32_t g_sink;        // Keeps read loops from being optimized out
+
+#ifdef OMNITOOL_BENCH
+static tls_arena_t g_client_arena;
+static tls_arena_t g_server_arena;
+#endif
+
+static lv_timer_t *g_console_timer = NULL;  // Console run in progress
+static int g_console_next;
+static int g_console_end;
+
+static void bench_command(int argc, char **argv);
+
+// Report one metric
+static void report(const char *metric, float value, const char *unit)
+{
+    printf("BENCH %s.%s %.3f %s\n", g_test, metric, value, unit);
+    if (g_cb != NULL) {
+        g_cb(g_test, metric, value, unit, g_cb_data);
+    }
+}
+
+static float mb_per_s(uint64_t bytes, uint64_t us)
+{
+    return us > 0 ? (float)bytes / (float)us : 0.0f;   // bytes/us == MB/s
+}
+
+static uint8_t *scratch(void)
+{
+    if (g_scratch == NULL) {
+        g_scratch = (uint8_t *)psram_malloc(BENCH_PSRAM_SCRATCH);
+    }
+    return g_scratch;
+}
+
+// Fill a buffer with an RGB565 gradient so the SPI path converts real data
+static void fill_pattern(uint16_t *px, int w, int h)
+{
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            px[y * w + x] = (uint16_t)(((x >> 3) << 11) | ((y >> 2) << 5) | ((x + y) >> 4));
+        }
+    }
+}
+
+// Full screen in LVGL-sized strips (source in PSRAM)
+static void bench_lcd_full(void)
+{
+    const int frames = 4;
+    uint8_t *buf = scratch();
+    if (buf == NULL) {
+        report("skipped", 0, "no_psram");
+        return;
+    }
+    fill_pattern((uint16_t *)buf, BENCH_LCD_W, BENCH_STRIP_H);
+
+    uint32_t spi0 = lcd_spi_bytes();
+    uint64_t t0 = time_us_64();
+    for (int f = 0; f < frames; f++) {
+        for (int y = 0; y < BENCH_LCD_H; y += BENCH_STRIP_H) {
+            draw_buffer_spi(0, y, BENCH_LCD_W - 1, y + BENCH_STRIP_H - 1, buf);
+        }
+    }
+    uint64_t us = time_us_64() - t0;
+    uint32_t spi_bytes = lcd_spi_bytes() - spi0;
+
+    report("fps", frames * 1e6f / (float)us, "fps");
+    report("fill", (float)frames * BENCH_LCD_W * BENCH_LCD_H / (float)us, "Mpix/s");
+    report("spi", mb_per_s(spi_bytes, us), "MB/s");
+}
+
+// Small updates from an SRAM buffer (tiles covering the screen)
+static void bench_lcd_partial(void)
+{
+    const int frames = 2;
+    uint16_t *tile = malloc(BENCH_TILE * BENCH_TILE * sizeof(uint16_t));
+    if (tile == NULL) {
+        report("skipped", 0, "no_memory");
+        return;
+    }
+    fill_pattern(tile, BENCH_TILE, BENCH_TILE);
+
+    int tiles = 0;
+    uint32_t spi0 = lcd_spi_bytes();
+    uint64_t t0 = time_us_64();
+    for (int f = 0; f < frames; f++) {
+        for (int y = 0; y < BENCH_LCD_H; y += BENCH_TILE) {
+            for (int x = 0; x < BENCH_LCD_W; x += BENCH_TILE) {
+                draw_buffer_spi(x, y, x + BENCH_TILE - 1, y + BENCH_TILE - 1, (unsigned char *)tile);
+                tiles++;
+            }
+        }
+    }
+    uint64_t us = time_us_64() - t0;
+    uint32_t spi_bytes = lcd_spi_bytes() - spi0;
+    free(tile);
+
+    report("tiles", tiles * 1e6f / (float)us, "tiles/s");
+    report("fill", (float)tiles * BENCH_TILE * BENCH_TILE / (float)us, "Mpix/s");
+    report("spi", mb_per_s(spi_bytes, us), "MB/s");
+}
+
+// Console text on the panel, one draw per char against glyph runs
+static void bench_lcd_text(void)
+{
+    uint32_t per_char, runs;
+    lcd_text_benchmark(&per_char, &runs);
+    report("per_char", (float)per_char, "chars/s");
+    report("runs", (float)runs, "chars/s");
+}
+
+// Console scrolling, redrawn against the panel's hardware start line
+static void bench_lcd_scroll(void)
+{
+    uint32_t redraw_bytes, redraw_us, hw_bytes, hw_us;
+    lcd_scroll_benchmark(&redraw_bytes, &redraw_us, &hw_bytes, &hw_us);
+    report("redraw_spi", (float)redraw_bytes, "B/line");
+    report("redraw_time", (float)redraw_us, "us/line");
+    report("hw_spi", (float)hw_bytes, "B/line");
+    report("hw_time", (float)hw_us, "us/line");
+}
+
+// LVGL scrolling a list, redrawn against hardware scrolling, on a screen
+// of its own that is thrown away afterwards
+static void bench_lvgl_scroll(void)
+{
+    lv_obj_t *prev = lv_screen_active();
+    lv_obj_t *screen = lv_obj_create(NULL);
+    lv_obj_t *list = lv_obj_create(screen);
+    lv_obj_set_size(list, LV_PCT(100), LV_PCT(100));
+    lv_obj_set_flex_flow(list, LV_FLEX_FLOW_COLUMN);
+    for (int i = 0; i < BENCH_SCROLL_ROWS; i++) {
+        lv_label_set_text_fmt(lv_label_create(list), "Benchmark row %d", i);
+    }
+    lv_port_disp_hw_scroll_attach(list);
+    lv_screen_load(screen);
+
+    uint32_t redraw_bytes, hw_bytes;
+    bool scrolled = lv_port_disp_hw_scroll_benchmark(list, &redraw_bytes, &hw_bytes);
+
+    lv_screen_load(prev);
+    lv_obj_delete(screen);
+
+    if (!scrolled) {
+        report("skipped", 0, "no_scroll");
+        return;
+    }
+    report("redraw_spi", (float)redraw_bytes, "B/line");
+    report("hw_spi", (float)hw_bytes, "B/line");
+}
+
+// Time len-byte copies, reps times
+static uint64_t time_copies(void *dst, const void *src, size_t len, int reps)
+{
+    uint64_t t0 = time_us_64();
+    for (int i = 0; i < reps; i++) {
+        memcpy(dst, src, len);
+    }
+    return time_us_64() - t0;
+}
+
+// memcpy bandwidth between SRAM and PSRAM
+static void bench_memcpy(void)
+{
+    const size_t half = BENCH_PSRAM_SCRATCH / 2;   // Each bigger than the XIP cache
+    uint8_t *psram = scratch();
+    uint8_t *a = malloc(BENCH_SRAM_BLOCK);
+    uint8_t *b = malloc(BENCH_SRAM_BLOCK);
+    if (psram == NULL || a == NULL || b == NULL) {
+        report("skipped", 0, "no_memory");
+        free(a);
+        free(b);
+        return;
+    }
+    memset(a, 0x5a, BENCH_SRAM_BLOCK);
+    memset(psram, 0xa5, BENCH_PSRAM_SCRATCH);
+
+    uint64_t us = time_copies(b, a, BENCH_SRAM_BLOCK, 64);
+    report("sram", mb_per_s(64ull * BENCH_SRAM_BLOCK, us), "MB/s");
+
+    us = time_copies(psram + half, psram, half, 8);
+    report("psram", mb_per_s(8ull * half, us), "MB/s");
+
+    // Stream through all of the PSRAM buffer so reads miss the cache
+    uint64_t t0 = time_us_64();
+    for (int rep = 0; rep < 4; rep++) {
+        for (size_t off = 0; off < BENCH_PSRAM_SCRATCH; off += BENCH_SRAM_BLOCK) {
+            memcpy(a, psram + off, BENCH_SRAM_BLOCK);
+        }
+    }
+    report("psram_to_sram", mb_per_s(4ull * BENCH_PSRAM_SCRATCH, time_us_64() - t0), "MB/s");
+
+    t0 = time_us_64();
+    for (int rep = 0; rep < 4; rep++) {
+        for (size_t off = 0; off < BENCH_PSRAM_SCRATCH; off += BENCH_SRAM_BLOCK) {
+            memcpy(psram + off, a, BENCH_SRAM_BLOCK);
+        }
+    }
+    report("sram_to_psram", mb_per_s(4ull * BENCH_PSRAM_SCRATCH, time_us_64() - t0), "MB/s");
+
+    free(a);
+    free(b);
+}
+
+// Sum words from an address range
+static uint64_t time_read(const uint32_t *p, size_t bytes)
+{
+    uint32_t sum = 0;
+    uint64_t t0 = time_us_64();
+    for (size_t i = 0; i < bytes / 4; i += 4) {
+        sum += p[i] + p[i + 1] + p[i + 2] + p[i + 3];
+    }
+    uint64_t us = time_us_64() - t0;
+    g_sink = sum;
+    return us;
+}
+
+// XIP flash reads of the firmware image, through the cache and around it
+static void bench_flash(void)
+{
+    uint64_t us = time_read((const uint32_t *)XIP_BASE, BENCH_FLASH_STREAM);
+    report("xip_stream", mb_per_s(BENCH_FLASH_STREAM, us), "MB/s");
+
+    us = time_read((const uint32_t *)XIP_NOCACHE_NOALLOC_BASE, BENCH_FLASH_UNCACHED);
+    report("xip_uncached", mb_per_s(BENCH_FLASH_UNCACHED, us), "MB/s");
+}
+
+// calculate_crc32 (stall record, capture replay checksums)
+static void bench_crc32(void)
+{
+    uint8_t *buf = malloc(BENCH_SRAM_BLOCK);
+    if (buf == NULL) {
+        report("skipped", 0, "no_memory");
+        return;
+    }
+    for (int i = 0; i < BENCH_SRAM_BLOCK; i++) {
+        buf[i] = (uint8_t)(i * 31 + 7);
+    }
+
+    uint32_t crc = 0;
+    uint64_t t0 = time_us_64();
+    for (int rep = 0; rep < 4; rep++) {
+        crc ^= calculate_crc32(buf, BENCH_SRAM_BLOCK);
+    }
+    uint64_t us = time_us_64() - t0;
+    g_sink = crc;
+    free(buf);
+
+    report("throughput", mb_per_s(4ull * BENCH_SRAM_BLOCK, us), "MB/s");
+}
+
+// sha256_engine (WiFi config digest), hardware block vs portable path
+static void bench_sha256(void)
+{
+    float hw_mb_s, sw_mb_s;
+    sha256_engine_benchmark(&hw_mb_s, &sw_mb_s);
+    if (sha256_engine_hw_available()) {
+        report("hardware", hw_mb_s, "MB/s");
+    }
+    report("software", sw_mb_s, "MB/s");
+}
+
+// Deferred logging: a queued message against a printf of the same line
+static void bench_log(void)
+{
+    uint32_t log_ns, printf_ns, drain_us;
+    log_benchmark(&log_ns, &printf_ns, &drain_us);
+    report("queued", (float)log_ns / 1000.0f, "us/msg");
+    report("printf", (float)printf_ns / 1000.0f, "us/msg");
+    report("drain", (float)drain_us, "us");
+}
+
+// LVGL's RGB565 blend kernels, reference C loops against the fast ones
+static void bench_blend565(void)
+{
+    static const char *kernels[] = {"fill", "mask", "image"};
+    static const uint8_t opas[] = {255, 128};
+    char metric[24];
+
+    for (int kernel = 0; kernel < BLEND565_KERNEL_COUNT; kernel++) {
+        for (size_t o = 0; o < sizeof(opas); o++) {
+            const char *mode = opas[o] >= BLEND565_OPA_COVER ? "cover" : "opa";
+            float ref_mpx_s, fast_mpx_s;
+            blend565_benchmark(kernel, opas[o], &ref_mpx_s, &fast_mpx_s);
+
+            snprintf(metric, sizeof(metric), "%s_%s_ref", kernels[kernel], mode);
+            report(metric, ref_mpx_s, "Mpix/s");
+            snprintf(metric, sizeof(metric), "%s_%s_fast", kernels[kernel], mode);
+            report(metric, fast_mpx_s, "Mpix/s");
+        }
+    }
+}
+
+// NewsAPI top-headlines body
+static char *build_news_fixture(size_t *len)
+{
+    const size_t size = 512 + BENCH_NEWS_ARTICLES * 640;
+    char *json = malloc(size);
+    if (json == NULL) {
+        return NULL;
+    }
+
+    size_t n = (size_t)snprintf(json, size, "{\"status\":\"ok\",\"totalResults\":%d,\"articles\":[",
+                                BENCH_NEWS_ARTICLES);
+    for (int i = 0; i < BENCH_NEWS_ARTICLES && n < size; i++) {
+        n += (size_t)snprintf(json + n, size - n,
+            "%s{\"source\":{\"id\":null,\"name\":\"Example News %d\"},"
+            "\"author\":\"Staff Reporter\","
+            "\"title\":\"Headline %d: council approves \\\"new\\\" transit plan after long debate - Example News\","
+            "\"description\":\"The plan adds %d bus routes and extends service hours. Officials said work "
+            "starts next spring, with the first routes opening by autumn.\","
+            "\"url\":\"https://news.example.com/articles/%d\","
+            "\"urlToImage\":\"https://news.example.com/images/%d.jpg\","
+            "\"publishedAt\":\"2024-05-%02dT08:30:00Z\","
+            "\"content\":\"Residents packed the hall on Tuesday as the council voted... [+2400 chars]\"}",
+            i ? "," : "", i % 7, i, i + 3, i, i, i % 28 + 1);
+    }
+    n += (size_t)snprintf(json + n, size - n, "]}");
+    *len = n;
+    return json;
+}
+
+// OpenWeatherMap 5-day forecast body
+static char *build_forecast_fixture(size_t *len)
+{
+    const size_t size = 512 + BENCH_FORECASTS * 480;
+    char *json = malloc(size);
+    if (json == NULL) {
+        return NULL;
+    }
+
+    size_t n = (size_t)snprintf(json, size, "{\"cod\":\"200\",\"message\":0,\"cnt\":%d,\"list\":[",
+                                BENCH_FORECASTS);
+    for (int i = 0; i < BENCH_FORECASTS && n < size; i++) {
+        n += (size_t)snprintf(json + n, size - n,
+            "%s{\"dt\":%d,\"main\":{\"temp\":%d.%02d,\"feels_like\":%d.%02d,\"temp_min\":10.1,"
+            "\"temp_max\":14.9,\"pressure\":1012,\"sea_level\":1012,\"grnd_level\":1001,"
+            "\"humidity\":%d,\"temp_kf\":0.4},\"weather\":[{\"id\":500,\"main\":\"Rain\","
+            "\"description\":\"light rain\",\"icon\":\"10d\"}],\"clouds\":{\"all\":75},"
+            "\"wind\":{\"speed\":4.12,\"deg\":230,\"gust\":8.2},\"visibility\":10000,\"pop\":0.42,"
+            "\"rain\":{\"3h\":0.31},\"sys\":{\"pod\":\"d\"},\"dt_txt\":\"2024-05-01 12:00:00\"}",
+            i ? "," : "", 1714564800 + i * 10800, 10 + i % 8, i * 7 % 100, 9 + i % 8, i * 3 % 100,
+            60 + i % 35);
+    }
+    n += (size_t)snprintf(json + n, size - n,
+        "],\"city\":{\"id\":2643743,\"name\":\"London\",\"coord\":{\"lat\":51.5085,\"lon\":-0.1257},"
+        "\"country\":\"GB\",\"population\":1000000,\"timezone\":3600}}");
+    *len = n;
+    return json;
+}
+
+// Telegram getUpdates body
+static char *build_updates_fixture(size_t *len)
+{
+    const size_t size = 64 + BENCH_UPDATES * 480;
+    char *json = malloc(size);
+    if (json == NULL) {
+        return NULL;
+    }
+
+    size_t n = (size_t)snprintf(json, size, "{\"ok\":true,\"result\":[");
+    for (int i = 0; i < BENCH_UPDATES && n < size; i++) {
+        n += (size_t)snprintf(json + n, size - n,
+            "%s{\"update_id\":%d,\"message\":{\"message_id\":%d,\"from\":{\"id\":123456789,"
+            "\"is_bot\":false,\"first_name\":\"Alex\",\"username\":\"alex_%d\",\"language_code\":\"en\"},"
+            "\"chat\":{\"id\":123456789,\"first_name\":\"Alex\",\"username\":\"alex_%d\",\"type\":\"private\"},"
+            "\"date\":%d,\"text\":\"Message %d: are we still on for \\\"lunch\\\" at 12:30?\\nI can bring "
+            "the notes from yesterday's meeting.\"}}",
+            i ? "," : "", 700000000 + i, 4000 + i, i % 3, i % 3, 1714564800 + i * 60, i);
+    }
+    n += (size_t)snprintf(json + n, size - n, "]}");
+    *len = n;
+    return json;
+}
+
+// Time parse() over a fixture
+static void run_parser(char *(*build)(size_t *), int (*parse)(const char *), int reps)
+{
+    size_t len = 0;
+    char *json = build(&len);
+    if (json == NULL) {
+        report("skipped", 0, "no_memory");
+        return;
+    }
+
+    int items = 0;
+    uint64_t t0 = time_us_64();
+    for (int i = 0; i < reps; i++) {
+        items = parse(json);
+    }
+    uint64_t us = time_us_64() - t0;
+    free(json);
+
+    report("items", (float)items, "items");
+    report("time", (float)us / reps / 1000.0f, "ms");
+    report("throughput", mb_per_s((uint64_t)len * reps, us), "MB/s");
+}
+
+static void bench_json_news(void)
+{
+    run_parser(build_news_fixture, news_api_parse_fixture, 10);
+}
+
+static void bench_json_forecast(void)
+{
+    run_parser(build_forecast_fixture, weather_api_parse_fixture, 10);
+}
+
+static void bench_json_telegram(void)
+{
+    run_parser(build_updates_fixture, telegram_api_parse_fixture, 10);
+}
+
+// ui_vlist scrolled end to end off-screen; the pool and heap must not grow
+// with the item count
+static void vlist(uint32_t count)
+{
+    ui_vlist_bench_t result;
+    ui_vlist_benchmark(count, &result);
+    report("rows_live", (float)result.rows_live, "rows");
+    report("heap", (float)result.heap_bytes, "B");
+    report("step", (float)result.step_us, "us");
+    report("binds", (float)result.binds, "rows");
+}
+
+static void bench_vlist_10(void)
+{
+    vlist(10);
+}
+
+static void bench_vlist_1000(void)
+{
+    vlist(1000);
+}
+
+// LodePNG (LVGL's PNG decoder) on an embedded map tile
+static void bench_png(void)
+{
+    const int reps = 4;
+    unsigned w = 0, h = 0;
+    uint64_t us = 0;
+
+    for (int i = 0; i < reps; i++) {
+        unsigned char *out = NULL;
+        uint64_t t0 = time_us_64();
+        unsigned err = lodepng_decode32(&out, &w, &h, bench_tile_png, bench_tile_png_size);
+        us += time_us_64() - t0;
+        if (err != 0) {
+            report("error", (float)err, "lodepng");
+            return;
+        }
+        lv_free(out);
+    }
+
+    report("time", (float)us / reps / 1000.0f, "ms");
+    report("decode", (float)w * h * reps / (float)us, "Mpix/s");
+}
+
+// Client offers for the suite variants. Each pins one suite so the result
+// is that suite's cost. P-256 stays in the P-384 list because it is also
+// the curve of the server's certificate key; the server takes the
+// client's first curve for ECDHE.
+static const int g_tls_gcm128[] = {MBEDTLS_TLS_ECDHE_ECDSA_WITH_AES_128_GCM_SHA256, 0};
+static const int g_tls_ccm128[] = {MBEDTLS_TLS_ECDHE_ECDSA_WITH_AES_128_CCM, 0};
+static const int g_tls_gcm256[] = {MBEDTLS_TLS_ECDHE_ECDSA_WITH_AES_256_GCM_SHA384, 0};
+static const uint16_t g_tls_p256[] = {
+    MBEDTLS_SSL_IANA_TLS_GROUP_SECP256R1, MBEDTLS_SSL_IANA_TLS_GROUP_NONE
+};
+static const uint16_t g_tls_p384[] = {
+    MBEDTLS_SSL_IANA_TLS_GROUP_SECP384R1, MBEDTLS_SSL_IANA_TLS_GROUP_SECP256R1,
+    MBEDTLS_SSL_IANA_TLS_GROUP_NONE
+};
+
+#ifdef OMNITOOL_BENCH
+// Memory pipe BIO for the TLS peers
+static int pipe_send(void *ctx, const unsigned char *buf, size_t len)
+{
+    bench_pipe_t *pipe = ((bench_link_t *)ctx)->tx;
+    size_t n = BENCH_TLS_PIPE_SIZE - pipe->len;
+    if (n == 0) {
+        return MBEDTLS_ERR_SSL_WANT_WRITE;
+    }
+    if (n > len) {
+        n = len;
+    }
+    memcpy(pipe->buf + pipe->len, buf, n);
+    pipe->len += n;
+    return (int)n;
+}
+
+static int pipe_recv(void *ctx, unsigned char *buf, size_t len)
+{
+    bench_pipe_t *pipe = ((bench_link_t *)ctx)->rx;
+    if (pipe->len == 0) {
+        return MBEDTLS_ERR_SSL_WANT_READ;
+    }
+    size_t n = pipe->len < len ? pipe->len : len;
+    memcpy(buf, pipe->buf, n);
+    memmove(pipe->buf, pipe->buf + n, pipe->len - n);
+    pipe->len -= n;
+    return (int)n;
+}
+
+// Fixed "entropy" so every run negotiates with the same random values
+static int fixed_entropy(void *ctx, unsigned char *out, size_t len)
+{
+    (void)ctx;
+    for (size_t i = 0; i < len; i++) {
+        out[i] = (unsigned char)(i * 13 + 101);
+    }
+    return 0;
+}
+
+// Step one side of the handshake; false on a real error
+static bool handshake_step(mbedtls_ssl_context *ssl, tls_arena_t *arena, uint64_t *us)
+{
+    if (mbedtls_ssl_is_handshake_over(ssl)) {
+        return true;
+    }
+    tls_arena_t *prev = tls_arena_select(arena);
+    uint64_t t0 = time_us_64();
+    int ret = mbedtls_ssl_handshake_step(ssl);
+    *us += time_us_64() - t0;
+    tls_arena_select(prev);
+    if (ret != 0 && ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) {
+        printf("Bench TLS: handshake step failed: -0x%04x\n", -ret);
+        return false;
+    }
+    return true;
+}
+#endif
+
+// Full TLS 1.2 handshake (ECDHE-ECDSA, certificate verified) against a
+// server running in the same loop, connected by memory pipes. suites and
+// groups restrict the client's offer; NULL uses the default preferences.
+// The server side of mbedTLS is only built with OMNITOOL_BENCH.
+static void tls_handshake(const int *suites, const uint16_t *groups)
+{
+#ifdef OMNITOOL_BENCH
+    if (!tls_arena_init(&g_client_arena, "bench client")) {
+        report("skipped", 0, "no_arena");
+        return;
+    }
+    if (!tls_arena_init(&g_server_arena, "bench server")) {
+        tls_arena_deinit(&g_client_arena);
+        report("skipped", 0, "no_arena");
+        return;
+    }
+
+    bench_pipe_t *to_server = malloc(sizeof(bench_pipe_t));
+    bench_pipe_t *to_client = malloc(sizeof(bench_pipe_t));
+    if (to_server == NULL || to_client == NULL) {
+        free(to_server);
+        free(to_client);
+        tls_arena_deinit(&g_client_arena);
+        tls_arena_deinit(&g_server_arena);
+        report("skipped", 0, "no_memory");
+        return;
+    }
+    to_server->len = 0;
+    to_client->len = 0;
+    bench_link_t client_link = {to_server, to_client};
+    bench_link_t server_link = {to_client, to_server};
+
+    // Keep lwIP callbacks (which select their own TLS arena) out until we are done
+    cyw43_arch_lwip_begin();
+
+    mbedtls_ssl_context client, server;
+    mbedtls_ssl_config client_conf, server_conf;
+    mbedtls_ctr_drbg_context drbg;
+    mbedtls_x509_crt cert;
+    mbedtls_pk_context key;
+    uint64_t client_us = 0, server_us = 0;
+    bool ok = false;
+
+    tls_arena_t *prev = tls_arena_select(&g_server_arena);
+    mbedtls_ssl_init(&client);
+    mbedtls_ssl_init(&server);
+    mbedtls_ssl_config_init(&client_conf);
+    mbedtls_ssl_config_init(&server_conf);
+    mbedtls_ctr_drbg_init(&drbg);
+    mbedtls_x509_crt_init(&cert);
+    mbedtls_pk_init(&key);
+
+    const char *pers = "bench_tls";
+    if (mbedtls_ctr_drbg_seed(&drbg, fixed_entropy, NULL, (const unsigned char *)pers, strlen(pers)) != 0 ||
+        mbedtls_x509_crt_parse_der(&cert, bench_server_cert_der, bench_server_cert_der_size) != 0 ||
+        mbedtls_pk_parse_key(&key, bench_server_key_der, bench_server_key_der_size, NULL, 0,
+                             mbedtls_ctr_drbg_random, &drbg) != 0) {
+        printf("Bench TLS: failed to load the server credentials\n");
+        goto cleanup;
+    }
+
+    // Server
+    if (mbedtls_ssl_config_defaults(&server_conf, MBEDTLS_SSL_IS_SERVER, MBEDTLS_SSL_TRANSPORT_STREAM,
+                                    MBEDTLS_SSL_PRESET_DEFAULT) != 0 ||
+        mbedtls_ssl_conf_own_cert(&server_conf, &cert, &key) != 0) {
+        goto cleanup;
+    }
+    mbedtls_ssl_conf_rng(&server_conf, mbedtls_ctr_drbg_random, &drbg);
+    if (mbedtls_ssl_setup(&server, &server_conf) != 0) {
+        goto cleanup;
+    }
+    mbedtls_ssl_set_bio(&server, &server_link, pipe_send, pipe_recv, NULL);
+
+    // Client, configured like the network modules but verifying the peer
+    tls_arena_select(&g_client_arena);
+    if (mbedtls_ssl_config_defaults(&client_conf, MBEDTLS_SSL_IS_CLIENT, MBEDTLS_SSL_TRANSPORT_STREAM,
+                                    MBEDTLS_SSL_PRESET_DEFAULT) != 0) {
+        goto cleanup;
+    }
+    mbedtls_ssl_conf_authmode(&client_conf, MBEDTLS_SSL_VERIFY_REQUIRED);
+    mbedtls_ssl_conf_ca_chain(&client_conf, &cert, NULL);
+    mbedtls_ssl_conf_rng(&client_conf, mbedtls_ctr_drbg_random, &drbg);
+    if (suites != NULL) {
+        mbedtls_ssl_conf_ciphersuites(&client_conf, suites);
+        mbedtls_ssl_conf_groups(&client_conf, groups);
+    } else {
+        tls_profile_apply_preferences(&client_conf);
+    }
+    if (mbedtls_ssl_setup(&client, &client_conf) != 0 ||
+        mbedtls_ssl_set_hostname(&client, BENCH_TLS_HOST) != 0) {
+        goto cleanup;
+    }
+    mbedtls_ssl_set_bio(&client, &client_link, pipe_send, pipe_recv, NULL);
+
+    uint64_t t0 = time_us_64();
+    for (int steps = 0; steps < 200; steps++) {
+        if (!handshake_step(&client, &g_client_arena, &client_us) ||
+            !handshake_step(&server, &g_server_arena, &server_us)) {
+            break;
+        }
+        if (mbedtls_ssl_is_handshake_over(&client) && mbedtls_ssl_is_handshake_over(&server)) {
+            ok = true;
+            break;
+        }
+    }
+    uint64_t total_us = time_us_64() - t0;
+
+    if (ok) {
+        report("handshake", total_us / 1000.0f, "ms");
+        report("client", client_us / 1000.0f, "ms");
+        report("server", server_us / 1000.0f, "ms");
+        printf("Bench TLS: %s\n", mbedtls_ssl_get_ciphersuite(&client));
+    } else {
+        report("failed", 1, "error");
+    }
+
+cleanup:
+    tls_arena_select(&g_client_arena);
+    mbedtls_ssl_free(&client);
+    mbedtls_ssl_config_free(&client_conf);
+    tls_arena_select(&g_server_arena);
+    mbedtls_ssl_free(&server);
+    mbedtls_ssl_config_free(&server_conf);
+    mbedtls_x509_crt_free(&cert);
+    mbedtls_pk_free(&key);
+    mbedtls_ctr_drbg_free(&drbg);
+    // Give back the arena slots the network modules need
+    tls_arena_deinit(&g_client_arena);
+    tls_arena_deinit(&g_server_arena);
+    tls_arena_select(prev);
+
+    cyw43_arch_lwip_end();
+
+    free(to_server);
+    free(to_client);
+#else
+    (void)suites;
+    (void)groups;
+    report("skipped", 0, "no_tls_server");
+#endif
+}
+
+// What the network modules negotiate
+static void bench_tls(void)
+{
+    tls_handshake(NULL, NULL);
+}
+
+static void bench_tls_gcm128(void)
+{
+    tls_handshake(g_tls_gcm128, g_tls_p256);
+}
+
+static void bench_tls_ccm128(void)
+{
+    tls_handshake(g_tls_ccm128, g_tls_p256);
+}
+
+static void bench_tls_p384(void)
+{
+    tls_handshake(g_tls_gcm256, g_tls_p384);
+}
+
+// Application data records of random length (fixed seed)
+static size_t build_record_stream(uint8_t *buf, size_t size)
+{
+    uint32_t seed = 0x1234567;
+    size_t n = 0;
+
+    while (n + 5 + BENCH_RX_MAX_RECORD <= size) {
+        seed = seed * 1664525u + 1013904223u;
+        size_t len = 16 + (seed >> 8) % (BENCH_RX_MAX_RECORD - 16);
+        buf[n] = 23;
+        buf[n + 1] = 3;
+        buf[n + 2] = 3;
+        buf[n + 3] = (uint8_t)(len >> 8);
+        buf[n + 4] = (uint8_t)len;
+        for (size_t i = 0; i < len; i++) {
+            buf[n + 5 + i] = (uint8_t)(seed + i);
+        }
+        n += 5 + len;
+    }
+    return n;
+}
+
+// Read records the way mbedTLS fetches them: the 5-byte header, then the
+// body, each in as many reads as the queued data allows
+static void rx_reader_drain(bench_rx_reader_t *r, bench_rx_read_t read, void *ctx)
+{
+    for (;;) {
+        size_t n = read(ctx, r->rec + r->have, r->need - r->have);
+        if (n == 0) {
+            return;
+        }
+        r->have += n;
+        if (r->have < r->need) {
+            continue;
+        }
+        if (r->need == 5) {
+            r->need = 5 + (((size_t)r->rec[3] << 8) | r->rec[4]);
+        } else {
+            r->sum += r->rec[r->need - 1];
+            r->records++;
+            r->have = 0;
+            r->need = 5;
+        }
+    }
+}
+
+static size_t linear_read(void *ctx, unsigned char *buf, size_t len)
+{
+    bench_linear_rx_t *l = (bench_linear_rx_t *)ctx;
+    size_t n = len < l->len ? len : l->len;
+
+    memcpy(buf, l->buf, n);
+    if (n < l->len) {
+        memmove(l->buf, l->buf + n, l->len - n);
+        l->moved += l->len - n;
+    }
+    l->len -= n;
+    return n;
+}
+
+static size_t queue_read(void *ctx, unsigned char *buf, size_t len)
+{
+    return tls_rx_queue_read((tls_rx_queue_t *)ctx, buf, len);
+}
+
+// TLS receive path: the same record stream, delivered in TCP_MSS segments,
+// through the old linear buffer and through tls_rx_queue's pbuf chain
+static void bench_tls_rx(void)
+{
+    uint8_t *stream = scratch();
+    uint8_t *rec = malloc(5 + BENCH_RX_MAX_RECORD);
+    bench_linear_rx_t linear = {malloc(BENCH_RX_LINEAR), 0, 0};
+    if (stream == NULL || rec == NULL || linear.buf == NULL) {
+        free(rec);
+        free(linear.buf);
+        report("skipped", 0, "no_memory");
+        return;
+    }
+    size_t total = build_record_stream(stream, BENCH_RX_STREAM);
+
+    bench_rx_reader_t lin = {rec, 0, 5, 0, 0};
+    uint64_t t0 = time_us_64();
+    for (size_t off = 0; off < total; off += TCP_MSS) {
+        size_t seg = total - off < TCP_MSS ? total - off : TCP_MSS;
+        memcpy(linear.buf + linear.len, stream + off, seg);   // At most one record + one segment
+        linear.len += seg;
+        rx_reader_drain(&lin, linear_read, &linear);
+    }
+    uint64_t linear_us = time_us_64() - t0;
+
+    // Pool pbufs stand in for the driver's; hold the lwIP lock while we use them
+    bench_rx_reader_t que = {rec, 0, 5, 0, 0};
+    tls_rx_queue_t queue = {0};
+    uint64_t queue_us = 0;
+    bool ok = true;
+
+    cyw43_arch_lwip_begin();
+    tls_rx_queue_init(&queue, NULL);
+    for (size_t off = 0; off < total; off += TCP_MSS) {
+        size_t seg = total - off < TCP_MSS ? total - off : TCP_MSS;
+        struct pbuf *p = pbuf_alloc(PBUF_RAW, (u16_t)seg, PBUF_POOL);
+        if (p == NULL) {
+            ok = false;
+            break;
+        }
+        pbuf_take(p, stream + off, (u16_t)seg);   // The driver's copy, not part of the path
+        t0 = time_us_64();
+        tls_rx_queue_push(&queue, p);
+        rx_reader_drain(&que, queue_read, &queue);
+        queue_us += time_us_64() - t0;
+    }
+    tls_rx_queue_reset(&queue);
+    cyw43_arch_lwip_end();
+
+    free(rec);
+    free(linear.buf);
+
+    if (!ok) {
+        report("skipped", 0, "no_pbufs");
+        return;
+    }
+    if (que.records != lin.records || que.sum != lin.sum) {
+        report("mismatch", 1, "error");
+        return;
+    }
+    report("records", (float)lin.records, "records");
+    report("linear", mb_per_s(total, linear_us), "MB/s");
+    report("queue", mb_per_s(total, queue_us), "MB/s");
+    report("memmove", (float)linear.moved / 1024.0f, "KB");
+}
+
+static const bench_test_t g_tests[] = {
+    {"lcd_full",      bench_lcd_full,      true},
+    {"lcd_partial",   bench_lcd_partial,   true},
+    {"lcd_text",      bench_lcd_text,      true},
+    {"lcd_scroll",    bench_lcd_scroll,    true},
+    {"lvgl_scroll",   bench_lvgl_scroll,   true},
+    {"memcpy",        bench_memcpy,        false},
+    {"flash",         bench_flash,         false},
+    {"crc32",         bench_crc32,         false},
+    {"sha256",        bench_sha256,        false},
+    {"blend565",      bench_blend565,      false},
+    {"log",           bench_log,           false},
+    {"json_news",     bench_json_news,     false},
+    {"json_forecast", bench_json_forecast, false},
+    {"json_telegram", bench_json_telegram, false},
+    {"png",           bench_png,           false},
+    {"vlist_10",      bench_vlist_10,      false},
+    {"vlist_1000",    bench_vlist_1000,    false},
+    {"tls",           bench_tls,           false},
+    {"tls_gcm128",    bench_tls_gcm128,    false},
+    {"tls_ccm128",    bench_tls_ccm128,    false},
+    {"tls_p384",      bench_tls_p384,      false},
+    {"tls_rx",        bench_tls_rx,        false},
+};
+
+#define BENCH_TEST_COUNT ((int)(sizeof(g_tests) / sizeof(g_tests[0])))
+
+int bench_test_count(void)
+{
+    return BENCH_TEST_COUNT;
+}
+
+const char *bench_test_name(int index)
+{
+    return (index >= 0 && index < BENCH_TEST_COUNT) ? g_tests[index].name : "";
+}
+
+bool bench_test_draws(int index)
+{
+    return index >= 0 && index < BENCH_TEST_COUNT && g_tests[index].draws;
+}
+
+void bench_begin(void)
+{
+    log_flush();   // Keep queued log lines out of the report
+    g_suite_start = time_us_64();
+    g_tests_run = 0;
+    printf("BENCH_BEGIN version=%s build=%d clk_hz=%lu\n", VERSION_STRING, BUILD_NUMBER,
+           (unsigned long)clock_get_hz(clk_sys));
+}
+
+void bench_run_test(int index, bench_result_cb_t cb, void *user_data)
+{
+    if (index < 0 || index >= BENCH_TEST_COUNT) {
+        return;
+    }
+    g_test = g_tests[index].name;
+    g_cb = cb;
+    g_cb_data = user_data;
+
+    g_tests[index].run();
+
+    g_cb = NULL;
+    g_tests_run++;
+}
+
+void bench_end(void)
+{
+    printf("BENCH_END tests=%d elapsed_ms=%lu\n", g_tests_run,
+           (unsigned long)((time_us_64() - g_suite_start) / 1000));
+}
+
+// Console run: one test per LVGL timer tick, so the main loop keeps running
+static void console_timer_cb(lv_timer_t *timer)
+{
+    bench_run_test(g_console_next, NULL, NULL);
+    if (bench_test_draws(g_console_next)) {
+        lv_obj_invalidate(lv_screen_active());
+    }
+    if (++g_console_next >= g_console_end) {
+        bench_end();
+        lv_timer_delete(timer);
+        g_console_timer = NULL;
+    }
+}
+
+// Console command: bench list | bench all | bench <test>
+static void bench_command(int argc, char **argv)
+{
+    const char *name = argc > 1 ? argv[1] : "";
+
+    if (g_console_timer != NULL) {
+        LOG_W("Bench: a run is already in progress\n");
+        return;
+    }
+    if (strcmp(name, "list") == 0) {
+        log_flush();
+        for (int i = 0; i < BENCH_TEST_COUNT; i++) {
+            printf("  %s%s\n", g_tests[i].name, g_tests[i].draws ? " (draws)" : "");
+        }
+        return;
+    }
+
+    if (strcmp(name, "all") == 0) {
+        g_console_next = 0;
+        g_console_end = BENCH_TEST_COUNT;
+    } else {
+        int i = 0;
+        while (i < BENCH_TEST_COUNT && strcmp(name, g_tests[i].name) != 0) {
+            i++;
+        }
+        if (i == BENCH_TEST_COUNT) {
+            LOG_W("Bench: usage: bench list | bench all | bench <test>\n");
+            return;
+        }
+        g_console_next = i;
+        g_console_end = i + 1;
+    }
+    bench_begin();
+    g_console_timer = lv_timer_create(console_timer_cb, BENCH_CONSOLE_TICK_MS, NULL);
+}
+
+void bench_init(void)
+{
+    console_register("bench", bench_command, "bench list | bench all | bench <test>");
+}
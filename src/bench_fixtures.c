@@ -0,0 +1,102 @@
+#include "bench_fixtures.h"
+
+// 64x64 RGBA PNG in the style of a precipitation overlay (colour bands, alpha, thin lines)
+const uint8_t bench_tile_png[] = {
+    0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52,
+    0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x40, 0x08, 0x06, 0x00, 0x00, 0x00, 0xaa, 0x69, 0x71,
+    0xde, 0x00, 0x00, 0x03, 0x08, 0x49, 0x44, 0x41, 0x54, 0x78, 0xda, 0xd5, 0x5b, 0x4b, 0x4e, 0xc5,
+    0x30, 0x0c, 0xf4, 0xc1, 0x38, 0x09, 0x87, 0xe0, 0x24, 0x1c, 0x82, 0x35, 0xc7, 0x61, 0xcd, 0x21,
+    0x58, 0xb3, 0x79, 0xd0, 0x27, 0x3d, 0x94, 0x56, 0x89, 0x63, 0xcf, 0x8c, 0xd3, 0x52, 0x29, 0x2c,
+    0x9e, 0x44, 0x1b, 0xcf, 0x4c, 0xfc, 0x49, 0x1c, 0xbb, 0xdd, 0x6e, 0x6f, 0x4f, 0x2f, 0x9f, 0xe5,
+    0xe3, 0xf9, 0xfd, 0xeb, 0x6f, 0x6c, 0xdf, 0x7c, 0xfd, 0xf8, 0xa6, 0x47, 0xfb, 0xce, 0xd9, 0xd8,
+    0xbe, 0xd9, 0xfb, 0xdd, 0xb6, 0x3f, 0x19, 0x43, 0x50, 0xc0, 0x8e, 0x1f, 0xce, 0x18, 0xea, 0x01,
+    0x96, 0x01, 0x41, 0x02, 0x40, 0x76, 0xf4, 0x90, 0x57, 0xb0, 0xef, 0x01, 0x30, 0x62, 0xbb, 0x0b,
+    0x40, 0x05, 0xdb, 0x28, 0xfb, 0xf6, 0xfb, 0x6c, 0xdf, 0xb4, 0xe6, 0x51, 0x2f, 0x85, 0x14, 0x00,
+    0x08, 0xdb, 0x88, 0xf1, 0x16, 0x78, 0xbc, 0xe5, 0x11, 0x31, 0x74, 0x34, 0x27, 0x53, 0xb3, 0xed,
+    0x01, 0xd0, 0x9b, 0xbc, 0x25, 0x1e, 0x54, 0x01, 0x3d, 0x92, 0x68, 0x05, 0x44, 0x00, 0x53, 0x30,
+    0xdf, 0x3e, 0xa8, 0x33, 0xf4, 0xe6, 0x67, 0x2b, 0xc2, 0x5e, 0x2f, 0xf4, 0x19, 0xf8, 0x20, 0xce,
+    0xd0, 0x9b, 0xa7, 0x55, 0x85, 0x3e, 0x8f, 0xfd, 0x28, 0xdb, 0x19, 0x10, 0x10, 0x05, 0x84, 0x01,
+    0x60, 0x42, 0x1f, 0x2b, 0xfb, 0x28, 0x00, 0x9e, 0x33, 0x4c, 0x01, 0xc0, 0x3a, 0x43, 0x84, 0xf9,
+    0xac, 0x33, 0xcc, 0xaa, 0xc0, 0x53, 0x35, 0x9d, 0x08, 0xb5, 0x80, 0xb1, 0xb2, 0x67, 0x9d, 0x61,
+    0x76, 0x19, 0x48, 0x33, 0x41, 0x2f, 0xde, 0xb3, 0x6c, 0x47, 0x55, 0xe0, 0xd5, 0x01, 0x12, 0x00,
+    0xbc, 0x17, 0x45, 0x8c, 0x47, 0xd9, 0x66, 0x01, 0xe8, 0xd9, 0xb8, 0xab, 0x05, 0x18, 0x15, 0x78,
+    0xc6, 0x2b, 0xd9, 0x56, 0x39, 0xc3, 0x6e, 0x31, 0xe4, 0x65, 0x4c, 0x0a, 0xd9, 0x2b, 0xd8, 0x56,
+    0x84, 0xc3, 0x61, 0x35, 0x18, 0x0d, 0x19, 0x2b, 0x12, 0x1d, 0xd6, 0x19, 0x42, 0x00, 0x1c, 0x65,
+    0x93, 0x31, 0xbc, 0x22, 0xd1, 0xa9, 0x70, 0x84, 0xa3, 0x32, 0xd9, 0x90, 0x12, 0xb2, 0x3a, 0xd1,
+    0xc9, 0x00, 0x46, 0x2b, 0x80, 0xa9, 0xa7, 0x2b, 0x13, 0x1d, 0x56, 0x01, 0xd1, 0x32, 0xd9, 0x22,
+    0x31, 0x54, 0x55, 0xd3, 0x57, 0x38, 0x43, 0x89, 0x02, 0x32, 0xff, 0x3c, 0x33, 0xbe, 0x3a, 0xf4,
+    0xf5, 0x00, 0x68, 0x9d, 0x21, 0x05, 0xc0, 0xe3, 0x45, 0x51, 0xc3, 0xab, 0x13, 0x9d, 0x2a, 0x05,
+    0xb4, 0xaa, 0x36, 0x66, 0x43, 0x72, 0x35, 0xdb, 0x91, 0x3d, 0x43, 0x4a, 0x01, 0xd9, 0xb1, 0x9a,
+    0x6d, 0x44, 0x01, 0x33, 0x67, 0x68, 0xe8, 0xde, 0xfc, 0x19, 0x6c, 0xab, 0x33, 0xc1, 0xbb, 0x1d,
+    0x55, 0xcc, 0xaf, 0x58, 0x1e, 0xe8, 0x0e, 0xf1, 0x0e, 0x80, 0xd1, 0x8b, 0xaa, 0x9c, 0x5e, 0xe5,
+    0xa6, 0x08, 0x92, 0xd0, 0x85, 0x36, 0x1c, 0x67, 0x86, 0x9f, 0xe5, 0x0c, 0x59, 0xf9, 0xdf, 0xed,
+    0xea, 0x4d, 0xbe, 0x9a, 0x71, 0x05, 0x60, 0x59, 0xe3, 0x8f, 0xcb, 0x03, 0xb6, 0xef, 0x0a, 0xa1,
+    0x4f, 0x21, 0xff, 0x65, 0xce, 0xfc, 0x8a, 0xa1, 0x2f, 0x0c, 0xc0, 0x55, 0xd8, 0x56, 0xb3, 0x5f,
+    0xa6, 0x80, 0xff, 0x10, 0xfa, 0x86, 0x00, 0x5c, 0x95, 0x6d, 0xf5, 0x16, 0xd8, 0x03, 0x30, 0x5a,
+    0x01, 0x57, 0x08, 0x7d, 0xd9, 0xa3, 0xf0, 0x53, 0x9c, 0xe0, 0xea, 0xaa, 0xcf, 0x3b, 0x0a, 0x87,
+    0x01, 0x38, 0x7b, 0x79, 0x30, 0x47, 0x60, 0x12, 0x00, 0xce, 0x5c, 0x1e, 0x99, 0xa3, 0x70, 0x09,
+    0x00, 0x57, 0x73, 0x86, 0x11, 0xe3, 0x99, 0x6d, 0x7c, 0xb8, 0x21, 0xa1, 0x1a, 0x30, 0x8f, 0xf9,
+    0x36, 0xf4, 0xb1, 0x27, 0x58, 0x90, 0xf1, 0x4c, 0x85, 0x88, 0x24, 0x3a, 0x0c, 0xf3, 0xb3, 0x56,
+    0xbd, 0x94, 0xe1, 0xb3, 0x0e, 0xcf, 0xaa, 0x44, 0xa7, 0x07, 0x80, 0xea, 0x0c, 0x13, 0x66, 0x3d,
+    0xa2, 0x0a, 0x66, 0x7b, 0x1b, 0x65, 0x3f, 0xea, 0x0c, 0xa7, 0x00, 0xa8, 0xfa, 0x79, 0x3d, 0x85,
+    0x44, 0x14, 0xc6, 0x48, 0x3f, 0xa2, 0x02, 0x19, 0xfb, 0x15, 0x80, 0x45, 0x13, 0x1d, 0x1a, 0x80,
+    0xcc, 0xe4, 0x33, 0x07, 0x26, 0xea, 0x06, 0x68, 0x75, 0xdf, 0xf2, 0x4e, 0x01, 0x19, 0xa3, 0x33,
+    0xf5, 0xb6, 0xaa, 0x05, 0x5e, 0xd1, 0xc9, 0x1a, 0xde, 0x14, 0x55, 0xb6, 0xa3, 0x47, 0xef, 0x07,
+    0x64, 0xda, 0x5d, 0x95, 0x7d, 0xcb, 0x53, 0xe3, 0xd1, 0x7a, 0x9b, 0x05, 0x4c, 0x29, 0x7d, 0x08,
+    0x80, 0x2c, 0x23, 0x48, 0xaf, 0x7e, 0x74, 0xa8, 0x3a, 0x59, 0xa7, 0x00, 0x78, 0x87, 0xa3, 0x59,
+    0x26, 0xd8, 0xab, 0x2c, 0x95, 0x0a, 0x68, 0x37, 0x45, 0xa8, 0xb4, 0x13, 0x69, 0xa4, 0x62, 0xd9,
+    0x67, 0x9c, 0x61, 0x68, 0x09, 0x54, 0x31, 0x80, 0x2e, 0x0f, 0xe5, 0x25, 0x0e, 0x08, 0x00, 0xe5,
+    0x85, 0x0a, 0xd4, 0x19, 0x56, 0x38, 0xc0, 0x2e, 0x00, 0x4a, 0xf4, 0xa3, 0x5d, 0xa5, 0x4a, 0x15,
+    0x20, 0x9b, 0x22, 0xe6, 0xd5, 0xdb, 0xab, 0x2e, 0x53, 0x44, 0x96, 0x47, 0xd5, 0x37, 0x87, 0x0a,
+    0xa8, 0xbc, 0x4b, 0xa8, 0x70, 0x8a, 0x99, 0x6f, 0xba, 0xc7, 0xe3, 0xaa, 0x7a, 0x9b, 0xbd, 0x4b,
+    0x58, 0xb5, 0x2c, 0x66, 0xdd, 0x6e, 0x96, 0x5d, 0xff, 0x67, 0x3a, 0xc3, 0x2c, 0x10, 0xa9, 0x0e,
+    0x91, 0x2a, 0xf6, 0x8f, 0x80, 0x9d, 0x91, 0x4a, 0xbb, 0xbb, 0xc2, 0x1e, 0x00, 0x15, 0x77, 0x09,
+    0x15, 0x93, 0x57, 0x8c, 0x10, 0x00, 0xea, 0xbb, 0x84, 0x4c, 0xf9, 0xac, 0x04, 0x6c, 0xb7, 0x4b,
+    0xd5, 0x3b, 0x65, 0x5d, 0x19, 0xfa, 0xaa, 0xaf, 0xcd, 0xcf, 0xbe, 0xf9, 0x03, 0xb6, 0xff, 0x84,
+    0xe6, 0xd3, 0xc4, 0x43, 0xaa, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae, 0x42, 0x60,
+    0x82,
+};
+const size_t bench_tile_png_size = sizeof(bench_tile_png);
+
+// Server key for the in-memory TLS peer: P-256, SEC1 DER. Test-only, not a secret.
+const uint8_t bench_server_key_der[] = {
+    0x30, 0x77, 0x02, 0x01, 0x01, 0x04, 0x20, 0xbf, 0x4a, 0x42, 0xde, 0x9c, 0x64, 0xe6, 0xe9, 0xe4,
+    0xd5, 0xc6, 0xa5, 0x50, 0x0b, 0xd9, 0xab, 0x9e, 0xb2, 0x42, 0x66, 0x11, 0xe7, 0x83, 0x87, 0x12,
+    0xbc, 0x43, 0x1c, 0x14, 0xb0, 0x6d, 0x07, 0xa0, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d,
+    0x03, 0x01, 0x07, 0xa1, 0x44, 0x03, 0x42, 0x00, 0x04, 0x84, 0x98, 0xe5, 0x21, 0x4f, 0xa4, 0xc2,
+    0x5c, 0x18, 0xec, 0xdd, 0x7e, 0x15, 0x1b, 0x45, 0x1c, 0x7b, 0x5f, 0xe9, 0xd7, 0xe4, 0x39, 0xfe,
+    0xa2, 0xa3, 0x71, 0x9b, 0x58, 0xdf, 0xa2, 0x35, 0xe6, 0xf1, 0xc6, 0x4e, 0x02, 0x43, 0x66, 0x29,
+    0x3c, 0xec, 0xe5, 0xf9, 0x41, 0x84, 0x28, 0x32, 0x3e, 0x1f, 0x2c, 0x27, 0xbb, 0x57, 0x35, 0x7c,
+    0xf5, 0x63, 0x08, 0x0f, 0xd4, 0x2d, 0x38, 0xf9, 0x30,
+};
+const size_t bench_server_key_der_size = sizeof(bench_server_key_der);
+
+// Self-signed certificate for bench_server_key_der, CN=bench.local, DER
+const uint8_t bench_server_cert_der[] = {
+    0x30, 0x82, 0x01, 0x83, 0x30, 0x82, 0x01, 0x29, 0xa0, 0x03, 0x02, 0x01, 0x02, 0x02, 0x14, 0x58,
+    0xc2, 0xb5, 0xb6, 0x60, 0x5d, 0x87, 0x3a, 0xdf, 0x9b, 0x72, 0x36, 0x94, 0x76, 0x75, 0x6e, 0x1c,
+    0x56, 0x9c, 0x59, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03, 0x02, 0x30,
+    0x16, 0x31, 0x14, 0x30, 0x12, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x0b, 0x62, 0x65, 0x6e, 0x63,
+    0x68, 0x2e, 0x6c, 0x6f, 0x63, 0x61, 0x6c, 0x30, 0x20, 0x17, 0x0d, 0x32, 0x36, 0x31, 0x30, 0x31,
+    0x38, 0x32, 0x32, 0x30, 0x39, 0x33, 0x33, 0x5a, 0x18, 0x0f, 0x32, 0x31, 0x32, 0x36, 0x30, 0x39,
+    0x32, 0x34, 0x32, 0x32, 0x30, 0x39, 0x33, 0x33, 0x5a, 0x30, 0x16, 0x31, 0x14, 0x30, 0x12, 0x06,
+    0x03, 0x55, 0x04, 0x03, 0x0c, 0x0b, 0x62, 0x65, 0x6e, 0x63, 0x68, 0x2e, 0x6c, 0x6f, 0x63, 0x61,
+    0x6c, 0x30, 0x59, 0x30, 0x13, 0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01, 0x06, 0x08,
+    0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00, 0x04, 0x84, 0x98, 0xe5, 0x21,
+    0x4f, 0xa4, 0xc2, 0x5c, 0x18, 0xec, 0xdd, 0x7e, 0x15, 0x1b, 0x45, 0x1c, 0x7b, 0x5f, 0xe9, 0xd7,
+    0xe4, 0x39, 0xfe, 0xa2, 0xa3, 0x71, 0x9b, 0x58, 0xdf, 0xa2, 0x35, 0xe6, 0xf1, 0xc6, 0x4e, 0x02,
+    0x43, 0x66, 0x29, 0x3c, 0xec, 0xe5, 0xf9, 0x41, 0x84, 0x28, 0x32, 0x3e, 0x1f, 0x2c, 0x27, 0xbb,
+    0x57, 0x35, 0x7c, 0xf5, 0x63, 0x08, 0x0f, 0xd4, 0x2d, 0x38, 0xf9, 0x30, 0xa3, 0x53, 0x30, 0x51,
+    0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d, 0x0e, 0x04, 0x16, 0x04, 0x14, 0x22, 0x2c, 0x0d, 0xb0, 0xa1,
+    0xa7, 0x84, 0x12, 0xb6, 0x7c, 0xc3, 0x4f, 0xc1, 0x05, 0x87, 0xab, 0x08, 0xca, 0x52, 0x9e, 0x30,
+    0x1f, 0x06, 0x03, 0x55, 0x1d, 0x23, 0x04, 0x18, 0x30, 0x16, 0x80, 0x14, 0x22, 0x2c, 0x0d, 0xb0,
+    0xa1, 0xa7, 0x84, 0x12, 0xb6, 0x7c, 0xc3, 0x4f, 0xc1, 0x05, 0x87, 0xab, 0x08, 0xca, 0x52, 0x9e,
+    0x30, 0x0f, 0x06, 0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff, 0x04, 0x05, 0x30, 0x03, 0x01, 0x01,
+    0xff, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03, 0x02, 0x03, 0x48, 0x00,
+    0x30, 0x45, 0x02, 0x20, 0x01, 0xde, 0x69, 0x1d, 0x86, 0xa1, 0x6f, 0x50, 0x0c, 0x04, 0x09, 0x56,
+    0x10, 0xeb, 0x77, 0x19, 0x93, 0x6d, 0x85, 0xdf, 0x53, 0xc1, 0x5d, 0x1b, 0xf3, 0xc0, 0x46, 0xa4,
+    0x3d, 0xde, 0xb8, 0x0c, 0x02, 0x21, 0x00, 0xd1, 0x2b, 0x6c, 0xdb, 0xda, 0x19, 0x2c, 0xf4, 0xc1,
+    0x77, 0x7d, 0x43, 0x00, 0x8c, 0x55, 0x06, 0x42, 0xf7, 0x97, 0x77, 0x65, 0xf0, 0xa0, 0x3c, 0xfa,
+    0x06, 0x37, 0xc7, 0x58, 0x6b, 0x89, 0xdd,
+};
+const size_t bench_server_cert_der_size = sizeof(bench_server_cert_der);
@@ -13,6 +13,10 @@
 #include "pico/multicore.h"
 #include "pico/mutex.h"
 #include "ble_config.h"
+#include "job_queue.h"
+#include "trace.h"
+#include "log.h"
+#include "profiler.h"
 #include "btstack.h"
 
 // UUID conversion helpers
@@ -30,6 +34,7 @@ static ble_connection_state_t connection_state = {0};
 static ble_data_received_callback_t data_callback = NULL;
 static bool initialized = false;
 static bool scanning = false;
+static ble_link_stats_t link_stats = {0};   // Written on core1, read as a snapshot
 
 // BTStack state
 static btstack_packet_callback_registration_t hci_event_callback_registration;
@@ -37,6 +42,7 @@ static btstack_packet_callback_registration_t sm_event_callback_registration;
 
 // Forward declarations
 static void packet_handler(uint8_t packet_type, uint16_t channel, uint8_t *packet, uint16_t size);
+static void handle_packet(uint8_t packet_type, uint16_t channel, uint8_t *packet, uint16_t size);
 static void handle_gatt_client_event(uint8_t packet_type, uint16_t channel, uint8_t *packet, uint16_t size);
 static bool parse_advertisement_data(const uint8_t *adv_data, uint8_t adv_len,
                                      char *name, size_t name_len, sps_device_type_t *sps_type);
@@ -67,11 +73,11 @@ static void init_service_uuids(void) {
 
 void ble_init(void) {
     if (initialized) {
-        printf("BLE already initialized\n");
+        LOG_I("BLE already initialized\n");
         return;
     }
 
-    printf("Initializing BLE...\n");
+    LOG_I("Initializing BLE...\n");
 
     // Initialize service UUIDs
     init_service_uuids();
@@ -83,7 +89,7 @@ void ble_init(void) {
     mutex_exit(&ble_mutex);
 
     initialized = true;
-    printf("BLE initialization complete\n");
+    LOG_I("BLE initialization complete\n");
 }
 
 bool ble_is_initialized(void) {
@@ -95,7 +101,9 @@ bool ble_is_initialized(void) {
 // =============================================================================
 
 void ble_core1_entry(void) {
-    printf("BLE Core1 started\n");
+    LOG_I("BLE Core1 started\n");
+    trace_core_init();
+    profiler_core_init();
 
     // Initialize BTStack
     l2cap_init();
@@ -114,16 +122,12 @@ void ble_core1_entry(void) {
     // Turn on Bluetooth
     hci_power_control(HCI_POWER_ON);
 
-    printf("BTStack initialized on Core1\n");
+    LOG_I("BTStack initialized on Core1\n");
 
-    // Main event loop for Core1
-    while (true) {
-        // Process BTStack events
-        btstack_run_loop_execute();
-
-        // Small delay to prevent busy-waiting
-        sleep_ms(1);
-    }
+    // BTStack events are delivered through the cyw43 async context, so
+    // btstack_run_loop_execute() would only idle here. Use core1 for
+    // offloaded jobs instead (never returns).
+    job_queue_worker_run();
 }
 
 // =============================================================================
@@ -132,16 +136,16 @@ void ble_core1_entry(void) {
 
 bool ble_start_scan(void) {
     if (!initialized) {
-        printf("BLE not initialized\n");
+        LOG_W("BLE not initialized\n");
         return false;
     }
 
     if (scanning) {
-        printf("Scan already in progress\n");
+        LOG_I("Scan already in progress\n");
         return false;
     }
 
-    printf("Starting BLE scan...\n");
+    LOG_I("Starting BLE scan...\n");
 
     mutex_enter_blocking(&ble_mutex);
     memset(&scan_state, 0, sizeof(scan_state));
@@ -153,7 +157,7 @@ bool ble_start_scan(void) {
     gap_start_scan();
 
     scanning = true;
-    printf("BLE scan started\n");
+    LOG_I("BLE scan started\n");
     return true;
 }
 
@@ -167,7 +171,7 @@ void ble_stop_scan(void) {
         scan_state.scan_active = false;
         mutex_exit(&ble_mutex);
 
-        printf("BLE scan stopped, found %d devices\n", scan_state.count);
+        LOG_I("BLE scan stopped, found %d devices\n", scan_state.count);
     }
 }
 
@@ -221,7 +225,7 @@ void ble_sort_scan_results(ble_scan_state_t *state) {
     }
 
     state->count = write_idx;
-    printf("Deduplicated scan results: %d unique devices\n", state->count);
+    LOG_I("Deduplicated scan results: %d unique devices\n", state->count);
 }
 
 // =============================================================================
@@ -258,10 +262,10 @@ static bool parse_advertisement_data(const uint8_t *adv_data, uint8_t adv_len,
                 for (int i = 0; i + 16 <= data_len; i += 16) {
                     if (memcmp(&data[i], nordic_nus_service_uuid, 16) == 0) {
                         *sps_type = SPS_TYPE_NORDIC_NUS;
-                        printf("Detected Nordic NUS service\n");
+                        LOG_I("Detected Nordic NUS service\n");
                     } else if (memcmp(&data[i], ublox_sps_service_uuid, 16) == 0) {
                         *sps_type = SPS_TYPE_UBLOX_SPS;
-                        printf("Detected u-blox SPS service\n");
+                        LOG_I("Detected u-blox SPS service\n");
                     }
                 }
                 break;
@@ -277,12 +281,12 @@ static bool parse_advertisement_data(const uint8_t *adv_data, uint8_t adv_len,
 
 bool ble_connect(const bd_addr_t address, bd_addr_type_t address_type) {
     if (!initialized) {
-        printf("BLE not initialized\n");
+        LOG_W("BLE not initialized\n");
         return false;
     }
 
     if (connection_state.connected) {
-        printf("Already connected to a device\n");
+        LOG_I("Already connected to a device\n");
         return false;
     }
 
@@ -291,7 +295,7 @@ bool ble_connect(const bd_addr_t address, bd_addr_type_t address_type) {
         ble_stop_scan();
     }
 
-    printf("Connecting to BLE device...\n");
+    LOG_I("Connecting to BLE device...\n");
 
     mutex_enter_blocking(&ble_mutex);
     memcpy(connection_state.device_address, address, 6);
@@ -304,7 +308,7 @@ bool ble_connect(const bd_addr_t address, bd_addr_type_t address_type) {
     // Initiate connection
     uint8_t status = gap_connect(address, address_type);
     if (status != ERROR_CODE_SUCCESS) {
-        printf("Failed to initiate connection: 0x%02x\n", status);
+        LOG_E("Failed to initiate connection: 0x%02x\n", status);
         return false;
     }
 
@@ -335,11 +339,11 @@ ble_connection_state_t* ble_get_connection_state(void) {
 
 bool ble_discover_sps_service(void) {
     if (!connection_state.connected) {
-        printf("Not connected to any device\n");
+        LOG_W("Not connected to any device\n");
         return false;
     }
 
-    printf("Discovering SPS services...\n");
+    LOG_I("Discovering SPS services...\n");
 
     // Discover primary services (will be handled in GATT event handler)
     uint8_t status = gatt_client_discover_primary_services(
@@ -348,7 +352,7 @@ bool ble_discover_sps_service(void) {
     );
 
     if (status != ERROR_CODE_SUCCESS) {
-        printf("Failed to start service discovery: 0x%02x\n", status);
+        LOG_E("Failed to start service discovery: 0x%02x\n", status);
         return false;
     }
 
@@ -372,12 +376,12 @@ bool ble_is_sps_ready(void) {
 
 bool ble_sps_send_data(const uint8_t *data, uint16_t length) {
     if (!ble_is_sps_ready()) {
-        printf("SPS not ready for data transfer\n");
+        LOG_W("SPS not ready for data transfer\n");
         return false;
     }
 
     if (connection_state.rx_value_handle == 0) {
-        printf("RX characteristic not available\n");
+        LOG_W("RX characteristic not available\n");
         return false;
     }
 
@@ -391,11 +395,14 @@ bool ble_sps_send_data(const uint8_t *data, uint16_t length) {
     );
 
     if (status != ERROR_CODE_SUCCESS) {
-        printf("Failed to send data: 0x%02x\n", status);
+        LOG_E("Failed to send data: 0x%02x\n", status);
+        link_stats.tx_failures++;
         return false;
     }
 
-    printf("Sent %d bytes via SPS\n", length);
+    link_stats.tx_writes++;
+    link_stats.tx_bytes += length;
+    trace_counter(TRACE_SPS_SENT, length);
     return true;
 }
 
@@ -410,17 +417,24 @@ void ble_sps_set_data_callback(ble_data_received_callback_t callback) {
 // =============================================================================
 
 static void packet_handler(uint8_t packet_type, uint16_t channel, uint8_t *packet, uint16_t size) {
+    trace_begin(TRACE_BLE_PACKET);
+    handle_packet(packet_type, channel, packet, size);
+    trace_end(TRACE_BLE_PACKET);
+}
+
+static void handle_packet(uint8_t packet_type, uint16_t channel, uint8_t *packet, uint16_t size) {
     UNUSED(channel);
     UNUSED(size);
 
     if (packet_type != HCI_EVENT_PACKET) return;
 
     uint8_t event_type = hci_event_packet_get_type(packet);
+    link_stats.hci_events++;
 
     switch (event_type) {
         case BTSTACK_EVENT_STATE:
             if (btstack_event_state_get_state(packet) == HCI_STATE_WORKING) {
-                printf("BTStack working\n");
+                LOG_I("BTStack working\n");
             }
             break;
 
@@ -453,8 +467,8 @@ static void packet_handler(uint8_t packet_type, uint16_t channel, uint8_t *packe
                 scan_state.count++;
                 mutex_exit(&ble_mutex);
 
-                printf("Found: %s (%d dBm)%s\n", name, rssi,
-                       result->has_sps_service ? " [SPS]" : "");
+                LOG_I("Found: %s (%d dBm)%s\n", name, rssi,
+                      result->has_sps_service ? " [SPS]" : "");
             }
             break;
         }
@@ -463,10 +477,12 @@ static void packet_handler(uint8_t packet_type, uint16_t channel, uint8_t *packe
             switch (hci_event_le_meta_get_subevent_code(packet)) {
                 case HCI_SUBEVENT_LE_CONNECTION_COMPLETE:
                     connection_state.connection_handle = hci_subevent_le_connection_complete_get_connection_handle(packet);
+                    link_stats.connects++;
+                    link_stats.conn_interval = hci_subevent_le_connection_complete_get_conn_interval(packet);
                     mutex_enter_blocking(&ble_mutex);
                     connection_state.connected = true;
                     mutex_exit(&ble_mutex);
-                    printf("Connected, handle: 0x%04x\n", connection_state.connection_handle);
+                    LOG_I("Connected, handle: 0x%04x\n", connection_state.connection_handle);
 
                     // Start service discovery
                     ble_discover_sps_service();
@@ -475,7 +491,10 @@ static void packet_handler(uint8_t packet_type, uint16_t channel, uint8_t *packe
             break;
 
         case HCI_EVENT_DISCONNECTION_COMPLETE:
-            printf("Disconnected\n");
+            LOG_I("Disconnected\n");
+            link_stats.disconnects++;
+            link_stats.last_disconnect_reason = hci_event_disconnection_complete_get_reason(packet);
+            link_stats.conn_interval = 0;
             mutex_enter_blocking(&ble_mutex);
             memset(&connection_state, 0, sizeof(connection_state));
             mutex_exit(&ble_mutex);
@@ -497,11 +516,11 @@ static void handle_gatt_client_event(uint8_t packet_type, uint16_t channel, uint
 
             // Check if this is Nordic NUS or u-blox SPS
             if (memcmp(service.uuid128, nordic_nus_service_uuid, 16) == 0) {
-                printf("Found Nordic NUS service\n");
+                LOG_I("Found Nordic NUS service\n");
                 connection_state.sps_service = service;
                 connection_state.sps_type = SPS_TYPE_NORDIC_NUS;
             } else if (memcmp(service.uuid128, ublox_sps_service_uuid, 16) == 0) {
-                printf("Found u-blox SPS service\n");
+                LOG_I("Found u-blox SPS service\n");
                 connection_state.sps_service = service;
                 connection_state.sps_type = SPS_TYPE_UBLOX_SPS;
             }
@@ -510,7 +529,7 @@ static void handle_gatt_client_event(uint8_t packet_type, uint16_t channel, uint
         case GATT_EVENT_QUERY_COMPLETE:
             if (connection_state.sps_type != SPS_TYPE_UNKNOWN && !connection_state.service_discovered) {
                 connection_state.service_discovered = true;
-                printf("Service discovery complete, discovering characteristics...\n");
+                LOG_I("Service discovery complete, discovering characteristics...\n");
 
                 // Discover characteristics
                 gatt_client_discover_characteristics_for_service(
@@ -520,7 +539,7 @@ static void handle_gatt_client_event(uint8_t packet_type, uint16_t channel, uint
                 );
             } else if (connection_state.service_discovered && !connection_state.characteristics_discovered) {
                 connection_state.characteristics_discovered = true;
-                printf("Characteristic discovery complete\n");
+                LOG_I("Characteristic discovery complete\n");
 
                 // Enable notifications on TX characteristic
                 if (connection_state.tx_value_handle != 0) {
@@ -540,21 +559,21 @@ static void handle_gatt_client_event(uint8_t packet_type, uint16_t channel, uint
             // Check characteristic UUID
             if (connection_state.sps_type == SPS_TYPE_NORDIC_NUS) {
                 if (memcmp(characteristic.uuid128, nordic_nus_tx_char_uuid, 16) == 0) {
-                    printf("Found Nordic TX characteristic\n");
+                    LOG_I("Found Nordic TX characteristic\n");
                     connection_state.tx_characteristic = characteristic;
                     connection_state.tx_value_handle = characteristic.value_handle;
                 } else if (memcmp(characteristic.uuid128, nordic_nus_rx_char_uuid, 16) == 0) {
-                    printf("Found Nordic RX characteristic\n");
+                    LOG_I("Found Nordic RX characteristic\n");
                     connection_state.rx_characteristic = characteristic;
                     connection_state.rx_value_handle = characteristic.value_handle;
                 }
             } else if (connection_state.sps_type == SPS_TYPE_UBLOX_SPS) {
                 if (memcmp(characteristic.uuid128, ublox_sps_fifo_char_uuid, 16) == 0) {
-                    printf("Found u-blox FIFO characteristic\n");
+                    LOG_I("Found u-blox FIFO characteristic\n");
                     connection_state.tx_characteristic = characteristic;
                     connection_state.tx_value_handle = characteristic.value_handle;
                 } else if (memcmp(characteristic.uuid128, ublox_sps_credits_char_uuid, 16) == 0) {
-                    printf("Found u-blox Credits characteristic\n");
+                    LOG_I("Found u-blox Credits characteristic\n");
                     connection_state.rx_characteristic = characteristic;
                     connection_state.rx_value_handle = characteristic.value_handle;
                 }
@@ -562,6 +581,8 @@ static void handle_gatt_client_event(uint8_t packet_type, uint16_t channel, uint
             break;
 
         case GATT_EVENT_NOTIFICATION:
+            link_stats.rx_notifications++;
+            link_stats.rx_bytes += gatt_event_notification_get_value_length(packet);
             if (data_callback != NULL) {
                 uint16_t value_length = gatt_event_notification_get_value_length(packet);
                 const uint8_t *value = gatt_event_notification_get_value(packet);
@@ -595,3 +616,7 @@ void ble_address_to_string(const bd_addr_t address, char *str, size_t len) {
              address[0], address[1], address[2],
              address[3], address[4], address[5]);
 }
+
+void ble_get_link_stats(ble_link_stats_t *stats) {
+    *stats = link_stats;
+}
@@ -0,0 +1,391 @@
+#include "blend_rgb565.h"
+#include "pico/stdlib.h"
+#include <stdio.h>
+#include <string.h>
+
+#define SPREAD_MASK 0x07E0F81Fu   // G in the upper half, R and B in the lower
+
+#define TEST_W      41
+#define TEST_H      7
+#define TEST_STRIDE 45            // Rows start at alternating alignment
+
+#define BENCH_W      320
+#define BENCH_H      40
+#define BENCH_ROUNDS 20
+
+static bool g_fast_enabled = false;
+
+// ===== Reference kernels (LVGL's C loops) =====
+
+// Same arithmetic as lv_color_16_16_mix(): c1 over c2 at mix
+static inline uint16_t mix565(uint16_t c1, uint16_t c2, uint8_t mix)
+{
+    if (mix == 255) return c1;
+    if (mix == 0) return c2;
+    if (c1 == c2) return c1;
+
+    uint32_t m = ((uint32_t)mix + 4) >> 3;
+    uint32_t bg = ((uint32_t)c2 | ((uint32_t)c2 << 16)) & SPREAD_MASK;
+    uint32_t fg = ((uint32_t)c1 | ((uint32_t)c1 << 16)) & SPREAD_MASK;
+    uint32_t result = ((((fg - bg) * m) >> 5) + bg) & SPREAD_MASK;
+    return (uint16_t)((result >> 16) | result);
+}
+
+static void fill_ref(uint16_t *dest, int32_t w, int32_t h, int32_t dest_stride,
+                     uint16_t color, uint8_t opa)
+{
+    for (int32_t y = 0; y < h; y++) {
+        for (int32_t x = 0; x < w; x++) {
+            dest[x] = (opa >= BLEND565_OPA_COVER) ? color : mix565(color, dest[x], opa);
+        }
+        dest += dest_stride;
+    }
+}
+
+static void fill_mask_ref(uint16_t *dest, int32_t w, int32_t h, int32_t dest_stride,
+                          uint16_t color, uint8_t opa, const uint8_t *mask, int32_t mask_stride)
+{
+    for (int32_t y = 0; y < h; y++) {
+        for (int32_t x = 0; x < w; x++) {
+            uint8_t m = (opa >= BLEND565_OPA_COVER) ? mask[x] : (uint8_t)((mask[x] * opa) >> 8);
+            dest[x] = mix565(color, dest[x], m);
+        }
+        dest += dest_stride;
+        mask += mask_stride;
+    }
+}
+
+static void image_ref(uint16_t *dest, int32_t w, int32_t h, int32_t dest_stride,
+                      const uint16_t *src, int32_t src_stride, uint8_t opa)
+{
+    for (int32_t y = 0; y < h; y++) {
+        for (int32_t x = 0; x < w; x++) {
+            dest[x] = (opa >= BLEND565_OPA_COVER) ? src[x] : mix565(src[x], dest[x], opa);
+        }
+        dest += dest_stride;
+        src += src_stride;
+    }
+}
+
+// ===== Fast kernels =====
+
+// mix565() with the foreground already spread and the mix already scaled
+static inline uint16_t mix_spread(uint32_t fg, uint16_t c2, uint32_t m)
+{
+    uint32_t bg = ((uint32_t)c2 | ((uint32_t)c2 << 16)) & SPREAD_MASK;
+    uint32_t result = ((((fg - bg) * m) >> 5) + bg) & SPREAD_MASK;
+    return (uint16_t)((result >> 16) | result);
+}
+
+// mix565() with the mix already scaled
+static inline uint16_t mix_pixel(uint16_t c1, uint16_t c2, uint32_t m)
+{
+    if (c1 == c2) {
+        return c1;
+    }
+    return mix_spread(((uint32_t)c1 | ((uint32_t)c1 << 16)) & SPREAD_MASK, c2, m);
+}
+
+// Solid row fill: one pixel to reach word alignment, then pixel pairs
+static inline void fill_row_solid(uint16_t *d, int32_t n, uint16_t color)
+{
+    uint32_t pair = ((uint32_t)color << 16) | color;
+
+    if (((uintptr_t)d & 2) && n > 0) {
+        *d++ = color;
+        n--;
+    }
+    uint32_t *d32 = (uint32_t *)d;
+    while (n >= 8) {
+        d32[0] = pair;
+        d32[1] = pair;
+        d32[2] = pair;
+        d32[3] = pair;
+        d32 += 4;
+        n -= 8;
+    }
+    while (n >= 2) {
+        *d32++ = pair;
+        n -= 2;
+    }
+    if (n > 0) {
+        *(uint16_t *)d32 = color;
+    }
+}
+
+static void fill_fast(uint16_t *dest, int32_t w, int32_t h, int32_t dest_stride,
+                      uint16_t color, uint8_t opa)
+{
+    if (opa >= BLEND565_OPA_COVER) {
+        for (int32_t y = 0; y < h; y++) {
+            fill_row_solid(dest, w, color);
+            dest += dest_stride;
+        }
+        return;
+    }
+
+    // Backgrounds are mostly flat: blend a pixel pair once and reuse it
+    uint32_t fg = ((uint32_t)color | ((uint32_t)color << 16)) & SPREAD_MASK;
+    uint32_t m = ((uint32_t)opa + 4) >> 3;
+    uint32_t last_in = 0;
+    uint32_t last_out = mix_spread(fg, 0, m) | ((uint32_t)mix_spread(fg, 0, m) << 16);
+
+    for (int32_t y = 0; y < h; y++) {
+        uint16_t *d = dest;
+        int32_t n = w;
+
+        if (((uintptr_t)d & 2) && n > 0) {
+            *d = mix_spread(fg, *d, m);
+            d++;
+            n--;
+        }
+        uint32_t *d32 = (uint32_t *)d;
+        for (; n >= 2; n -= 2, d32++) {
+            uint32_t in = *d32;
+            if (in != last_in) {
+                last_in = in;
+                last_out = mix_spread(fg, (uint16_t)in, m) |
+                           ((uint32_t)mix_spread(fg, (uint16_t)(in >> 16), m) << 16);
+            }
+            *d32 = last_out;
+        }
+        if (n > 0) {
+            d = (uint16_t *)d32;
+            *d = mix_spread(fg, *d, m);
+        }
+        dest += dest_stride;
+    }
+}
+
+static void fill_mask_fast(uint16_t *dest, int32_t w, int32_t h, int32_t dest_stride,
+                           uint16_t color, uint8_t opa, const uint8_t *mask, int32_t mask_stride)
+{
+    bool cover = (opa >= BLEND565_OPA_COVER);
+    uint32_t fg = ((uint32_t)color | ((uint32_t)color << 16)) & SPREAD_MASK;
+
+    for (int32_t y = 0; y < h; y++) {
+        int32_t x = 0;
+        while (x < w) {
+            // Glyph masks are mostly empty or solid: classify four bytes at once
+            if (x + 4 <= w) {
+                uint32_t m4;
+                memcpy(&m4, &mask[x], sizeof(m4));
+                if (m4 == 0) {
+                    x += 4;
+                    continue;
+                }
+                if (cover && m4 == 0xFFFFFFFFu) {
+                    dest[x] = color;
+                    dest[x + 1] = color;
+                    dest[x + 2] = color;
+                    dest[x + 3] = color;
+                    x += 4;
+                    continue;
+                }
+            }
+
+            uint8_t m = cover ? mask[x] : (uint8_t)((mask[x] * opa) >> 8);
+            if (m == 255) {
+                dest[x] = color;
+            } else if (m != 0) {
+                dest[x] = mix_spread(fg, dest[x], ((uint32_t)m + 4) >> 3);
+            }
+            x++;
+        }
+        dest += dest_stride;
+        mask += mask_stride;
+    }
+}
+
+static void image_fast(uint16_t *dest, int32_t w, int32_t h, int32_t dest_stride,
+                       const uint16_t *src, int32_t src_stride, uint8_t opa)
+{
+    if (opa >= BLEND565_OPA_COVER) {
+        for (int32_t y = 0; y < h; y++) {
+            memcpy(dest, src, (size_t)w * sizeof(uint16_t));
+            dest += dest_stride;
+            src += src_stride;
+        }
+        return;
+    }
+
+    // Pixel pairs: one load from each side and one store per two pixels,
+    // and a pair that already matches the source is skipped
+    uint32_t m = ((uint32_t)opa + 4) >> 3;
+    for (int32_t y = 0; y < h; y++) {
+        uint16_t *d = dest;
+        const uint16_t *s = src;
+        int32_t n = w;
+
+        if (((uintptr_t)d & 2) && n > 0) {
+            *d = mix_pixel(*s, *d, m);
+            d++;
+            s++;
+            n--;
+        }
+        uint32_t *d32 = (uint32_t *)d;
+        for (; n >= 2; n -= 2, d32++, s += 2) {
+            uint32_t fg;
+            memcpy(&fg, s, sizeof(fg));     // Source rows need not be word aligned
+            uint32_t bg = *d32;
+            if (fg != bg) {
+                *d32 = mix_pixel((uint16_t)fg, (uint16_t)bg, m) |
+                       ((uint32_t)mix_pixel((uint16_t)(fg >> 16), (uint16_t)(bg >> 16), m) << 16);
+            }
+        }
+        if (n > 0) {
+            d = (uint16_t *)d32;
+            *d = mix_pixel(*s, *d, m);
+        }
+        dest += dest_stride;
+        src += src_stride;
+    }
+}
+
+// ===== API =====
+
+void blend565_fill(uint16_t *dest, int32_t w, int32_t h, int32_t dest_stride,
+                   uint16_t color, uint8_t opa)
+{
+    if (g_fast_enabled) {
+        fill_fast(dest, w, h, dest_stride, color, opa);
+    } else {
+        fill_ref(dest, w, h, dest_stride, color, opa);
+    }
+}
+
+void blend565_fill_mask(uint16_t *dest, int32_t w, int32_t h, int32_t dest_stride,
+                        uint16_t color, uint8_t opa, const uint8_t *mask, int32_t mask_stride)
+{
+    if (g_fast_enabled) {
+        fill_mask_fast(dest, w, h, dest_stride, color, opa, mask, mask_stride);
+    } else {
+        fill_mask_ref(dest, w, h, dest_stride, color, opa, mask, mask_stride);
+    }
+}
+
+void blend565_image(uint16_t *dest, int32_t w, int32_t h, int32_t dest_stride,
+                    const uint16_t *src, int32_t src_stride, uint8_t opa)
+{
+    if (g_fast_enabled) {
+        image_fast(dest, w, h, dest_stride, src, src_stride, opa);
+    } else {
+        image_ref(dest, w, h, dest_stride, src, src_stride, opa);
+    }
+}
+
+bool blend565_enabled(void)
+{
+    return g_fast_enabled;
+}
+
+// Deterministic test pattern
+static uint32_t g_seed;
+
+static uint32_t next_rand(void)
+{
+    g_seed = g_seed * 1664525u + 1013904223u;
+    return g_seed >> 8;
+}
+
+// Background with flat runs (like a real screen) and noise
+static void fill_pattern(uint16_t *buf, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        buf[i] = (i % 11 < 6) ? 0x18E3 : (uint16_t)next_rand();
+    }
+}
+
+// Mask with empty, solid and anti-aliased runs
+static void mask_pattern(uint8_t *buf, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        uint32_t r = next_rand() % 4;
+        buf[i] = (r == 0) ? 0 : (r == 1) ? 255 : (uint8_t)next_rand();
+    }
+}
+
+// Run each kernel through reference and fast paths on identical buffers
+static bool self_test(void)
+{
+    static uint16_t ref[TEST_STRIDE * TEST_H + 1];
+    static uint16_t fast[TEST_STRIDE * TEST_H + 1];
+    static uint16_t src[TEST_STRIDE * TEST_H];
+    static uint8_t mask[TEST_STRIDE * TEST_H + 4];
+    static const uint8_t opas[] = {255, 253, 200, 128, 7, 1};
+    bool ok = true;
+
+    g_seed = 12345;
+    fill_pattern(src, sizeof(src) / sizeof(src[0]));
+    mask_pattern(mask, sizeof(mask));
+
+    // Start one pixel in to also cover the unaligned row head
+    for (int kernel = 0; kernel < BLEND565_KERNEL_COUNT; kernel++) {
+        for (size_t o = 0; o < sizeof(opas); o++) {
+            uint8_t opa = opas[o];
+            uint16_t color = (uint16_t)next_rand();
+
+            fill_pattern(ref, sizeof(ref) / sizeof(ref[0]));
+            memcpy(fast, ref, sizeof(ref));
+
+            if (kernel == BLEND565_KERNEL_FILL) {
+                fill_ref(ref + 1, TEST_W, TEST_H, TEST_STRIDE, color, opa);
+                fill_fast(fast + 1, TEST_W, TEST_H, TEST_STRIDE, color, opa);
+            } else if (kernel == BLEND565_KERNEL_MASK) {
+                fill_mask_ref(ref + 1, TEST_W, TEST_H, TEST_STRIDE, color, opa, mask + 1, TEST_STRIDE);
+                fill_mask_fast(fast + 1, TEST_W, TEST_H, TEST_STRIDE, color, opa, mask + 1, TEST_STRIDE);
+            } else {
+                image_ref(ref + 1, TEST_W, TEST_H, TEST_STRIDE, src, TEST_STRIDE, opa);
+                image_fast(fast + 1, TEST_W, TEST_H, TEST_STRIDE, src, TEST_STRIDE, opa);
+            }
+
+            if (memcmp(ref, fast, sizeof(ref)) != 0) {
+                printf("RGB565 blend self-test: kernel %d differs at opa %d\n", kernel, opa);
+                ok = false;
+            }
+        }
+    }
+    return ok;
+}
+
+void blend565_setup(void)
+{
+    g_fast_enabled = self_test();
+    printf("RGB565 blend kernels: %s\n", g_fast_enabled ? "fast" : "reference (self-test FAILED)");
+}
+
+// Time one kernel over the bench buffer; returns us
+static uint32_t bench_kernel(int kernel, bool fast, uint16_t *dest, const uint16_t *src,
+                             const uint8_t *mask, uint8_t opa)
+{
+    uint64_t start = time_us_64();
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        uint16_t color = (uint16_t)(0x1234 + r);
+        if (kernel == BLEND565_KERNEL_FILL) {
+            (fast ? fill_fast : fill_ref)(dest, BENCH_W, BENCH_H, BENCH_W, color, opa);
+        } else if (kernel == BLEND565_KERNEL_MASK) {
+            (fast ? fill_mask_fast : fill_mask_ref)(dest, BENCH_W, BENCH_H, BENCH_W, color, opa, mask, BENCH_W);
+        } else {
+            (fast ? image_fast : image_ref)(dest, BENCH_W, BENCH_H, BENCH_W, src, BENCH_W, opa);
+        }
+    }
+    uint32_t elapsed = (uint32_t)(time_us_64() - start);
+    return elapsed ? elapsed : 1;
+}
+
+void blend565_benchmark(int kernel, uint8_t opa, float *ref_mpx_s, float *fast_mpx_s)
+{
+    static uint16_t dest[BENCH_W * BENCH_H] __attribute__((aligned(4)));
+    static uint16_t src[BENCH_W * BENCH_H] __attribute__((aligned(4)));
+    static uint8_t mask[BENCH_W * BENCH_H] __attribute__((aligned(4)));
+    const float pixels = (float)(BENCH_W * BENCH_H * BENCH_ROUNDS);
+
+    g_seed = 1;
+    fill_pattern(src, BENCH_W * BENCH_H);
+    mask_pattern(mask, sizeof(mask));
+
+    fill_pattern(dest, BENCH_W * BENCH_H);
+    *ref_mpx_s = pixels / (float)bench_kernel(kernel, false, dest, src, mask, opa);    // px/us == Mpx/s
+    fill_pattern(dest, BENCH_W * BENCH_H);
+    *fast_mpx_s = pixels / (float)bench_kernel(kernel, true, dest, src, mask, opa);
+}
@@ -0,0 +1,77 @@
+#include "console.h"
+#include "log.h"
+#include "pico/stdlib.h"
+#include <stdio.h>
+#include <string.h>
+
+typedef struct {
+    const char *name;
+    console_cmd_fn_t fn;
+    const char *usage;
+} console_cmd_t;
+
+static console_cmd_t g_commands[CONSOLE_MAX_COMMANDS];
+static int g_command_count = 0;
+
+static char g_line[CONSOLE_LINE_MAX];
+static int g_line_len = 0;
+
+bool console_register(const char *name, console_cmd_fn_t fn, const char *usage)
+{
+    if (g_command_count >= CONSOLE_MAX_COMMANDS) {
+        LOG_W("Console: no room for command \"%s\"\n", name);
+        return false;
+    }
+    g_commands[g_command_count].name = name;
+    g_commands[g_command_count].fn = fn;
+    g_commands[g_command_count].usage = usage;
+    g_command_count++;
+    return true;
+}
+
+// Split a line and run its command
+static void run_line(char *line)
+{
+    char *argv[CONSOLE_MAX_ARGS];
+    int argc = 0;
+
+    for (char *tok = strtok(line, " \t"); tok != NULL && argc < CONSOLE_MAX_ARGS;
+         tok = strtok(NULL, " \t")) {
+        argv[argc++] = tok;
+    }
+    if (argc == 0) {
+        return;
+    }
+
+    if (strcmp(argv[0], "help") == 0) {
+        log_flush();
+        for (int i = 0; i < g_command_count; i++) {
+            printf("  %s\n", g_commands[i].usage);
+        }
+        return;
+    }
+
+    for (int i = 0; i < g_command_count; i++) {
+        if (strcmp(argv[0], g_commands[i].name) == 0) {
+            g_commands[i].fn(argc, argv);
+            return;
+        }
+    }
+    LOG_W("Console: unknown command \"%s\" (try help)\n", argv[0]);
+}
+
+void console_poll(void)
+{
+    int c;
+    while ((c = getchar_timeout_us(0)) != PICO_ERROR_TIMEOUT) {
+        if (c == '\r' || c == '\n') {
+            g_line[g_line_len] = '\0';
+            if (g_line_len > 0) {
+                run_line(g_line);
+            }
+            g_line_len = 0;
+        } else if (g_line_len < CONSOLE_LINE_MAX - 1) {
+            g_line[g_line_len++] = (char)c;
+        }
+    }
+}
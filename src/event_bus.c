@@ -0,0 +1,138 @@
+#include "event_bus.h"
+#include "pico/stdlib.h"
+#include "pico/util/queue.h"
+#include "log.h"
+#include <stddef.h>
+
+// Subscription
+typedef struct {
+    event_source_t source;
+    event_handler_t handler;
+    void *user_data;
+} subscriber_t;
+
+static queue_t g_queue;
+static bool g_initialized = false;
+static subscriber_t g_subscribers[EVENT_BUS_MAX_SUBSCRIBERS];
+static volatile uint32_t g_progress_bytes[EVENT_SOURCE_COUNT];   // Latest byte count per source
+static volatile bool g_progress_queued[EVENT_SOURCE_COUNT];      // A progress event is in the queue
+static uint32_t g_dropped = 0;              // Events lost to a full queue (atomic)
+static uint32_t g_dropped_reported = 0;
+
+static const char *g_source_names[EVENT_SOURCE_COUNT] = {"news", "weather", "telegram"};
+
+// Initialize the bus
+void event_bus_init(void)
+{
+    if (g_initialized) {
+        return;
+    }
+    queue_init(&g_queue, sizeof(app_event_t), EVENT_BUS_QUEUE_SIZE);
+    g_initialized = true;
+}
+
+// Post an event
+bool event_bus_post(event_source_t source, event_type_t type, int state)
+{
+    if (!g_initialized || source >= EVENT_SOURCE_COUNT) {
+        return false;
+    }
+
+    app_event_t event = {
+        .source = source,
+        .type = type,
+        .state = state,
+        .bytes = 0,
+        .posted_us = time_us_32(),
+    };
+    if (!queue_try_add(&g_queue, &event)) {
+        __atomic_fetch_add(&g_dropped, 1, __ATOMIC_RELAXED);   // Posted from both cores and IRQs
+        return false;
+    }
+    return true;
+}
+
+// Post a progress update (only one per source waits in the queue)
+void event_bus_post_progress(event_source_t source, int state, uint32_t bytes)
+{
+    if (source >= EVENT_SOURCE_COUNT) {
+        return;
+    }
+
+    g_progress_bytes[source] = bytes;
+    if (g_progress_queued[source]) {
+        return;
+    }
+    g_progress_queued[source] = true;
+    if (!event_bus_post(source, EVENT_FETCH_PROGRESS, state)) {
+        g_progress_queued[source] = false;
+    }
+}
+
+// Subscribe to one source
+bool event_bus_subscribe(event_source_t source, event_handler_t handler, void *user_data)
+{
+    for (int i = 0; i < EVENT_BUS_MAX_SUBSCRIBERS; i++) {
+        if (g_subscribers[i].handler == NULL) {
+            g_subscribers[i].source = source;
+            g_subscribers[i].handler = handler;
+            g_subscribers[i].user_data = user_data;
+            return true;
+        }
+    }
+    LOG_W("Event bus: no free subscriber slot\n");
+    return false;
+}
+
+// Remove every subscription of handler
+void event_bus_unsubscribe(event_handler_t handler)
+{
+    for (int i = 0; i < EVENT_BUS_MAX_SUBSCRIBERS; i++) {
+        if (g_subscribers[i].handler == handler) {
+            g_subscribers[i].handler = NULL;
+            g_subscribers[i].user_data = NULL;
+        }
+    }
+}
+
+// Deliver queued events
+uint32_t event_bus_dispatch(void)
+{
+    if (!g_initialized) {
+        return 0;
+    }
+
+    // Bounded, so events posted by handlers wait for the next iteration
+    uint32_t dispatched = 0;
+    app_event_t event;
+    while (dispatched < EVENT_BUS_QUEUE_SIZE && queue_try_remove(&g_queue, &event)) {
+        if (event.type == EVENT_FETCH_PROGRESS) {
+            g_progress_queued[event.source] = false;
+            event.bytes = g_progress_bytes[event.source];
+        }
+
+        // Handlers may (un)subscribe; a cleared slot is simply skipped
+        for (int i = 0; i < EVENT_BUS_MAX_SUBSCRIBERS; i++) {
+            subscriber_t *sub = &g_subscribers[i];
+            if (sub->handler != NULL && sub->source == event.source) {
+                sub->handler(&event, sub->user_data);
+            }
+        }
+
+        if (event.type == EVENT_FETCH_COMPLETED || event.type == EVENT_FETCH_ERROR) {
+            LOG_I("Event bus: %s %s delivered %lu us after post\n",
+                  g_source_names[event.source],
+                  event.type == EVENT_FETCH_COMPLETED ? "completed" : "error",
+                  (unsigned long)(time_us_32() - event.posted_us));
+        }
+        dispatched++;
+    }
+
+    uint32_t dropped = __atomic_load_n(&g_dropped, __ATOMIC_RELAXED);
+    if (dropped != g_dropped_reported) {
+        LOG_W("Event bus: %lu events dropped (queue full)\n", (unsigned long)(dropped - g_dropped_reported));
+        g_dropped_reported = dropped;
+    }
+
+    return dispatched;
+}
@@ -0,0 +1,216 @@
+#include "job_queue.h"
+#include "log.h"
+#include "pico/stdlib.h"
+#include "pico/util/queue.h"
+#include "hardware/sync.h"
+#include <stddef.h>
+
+// Queued job, timestamped as it moves between the cores
+typedef struct {
+    const char *name;
+    job_fn_t run;
+    job_fn_t done;
+    void *arg;
+    uint32_t submitted_us;
+    uint32_t started_us;
+    uint32_t finished_us;
+} job_t;
+
+// Stats for one report window
+typedef struct {
+    uint32_t window_start_us;
+    uint32_t jobs;
+    uint64_t wait_us;        // Submit to start on core1
+    uint32_t wait_max_us;
+    uint64_t run_us;         // Time on core1 (also its busy time)
+    uint32_t run_max_us;
+    uint32_t done_max_us;    // Submit to done callback on core0
+    const char *slowest;     // Job with the longest run
+    uint64_t core0_busy_us;
+} job_stats_t;
+
+static queue_t g_urgent;         // core0 -> core1, taken before g_pending
+static queue_t g_pending;        // core0 -> core1
+static queue_t g_finished;       // core1 -> core0, jobs with a done callback
+static bool g_initialized = false;
+static volatile bool g_worker_running = false;
+static volatile bool g_normal_running = false;  // Core1 is inside a g_pending job
+static job_stats_t g_stats;      // Run stats are added by core1, under g_stats_lock
+static uint64_t g_total_run_us;  // Since boot, also under g_stats_lock
+static uint32_t g_total_jobs;
+static spin_lock_t *g_stats_lock;
+
+// Initialize the queues
+void job_queue_init(void)
+{
+    if (g_initialized) {
+        return;
+    }
+    queue_init(&g_urgent, sizeof(job_t), JOB_QUEUE_URGENT_SIZE);
+    queue_init(&g_pending, sizeof(job_t), JOB_QUEUE_SIZE);
+    // One extra slot so core1 never waits for core0 with a job in hand
+    queue_init(&g_finished, sizeof(job_t), JOB_QUEUE_SIZE + 1);
+    g_stats_lock = spin_lock_init(spin_lock_claim_unused(true));
+    g_stats.window_start_us = time_us_32();
+    g_initialized = true;
+}
+
+// Run one job on core1 and account for it
+static void run_job(job_t *job)
+{
+    job->started_us = time_us_32();
+    job->run(job->arg);
+    job->finished_us = time_us_32();
+
+    uint32_t wait = job->started_us - job->submitted_us;
+    uint32_t run = job->finished_us - job->started_us;
+
+    uint32_t irq = spin_lock_blocking(g_stats_lock);
+    g_stats.jobs++;
+    g_stats.wait_us += wait;
+    g_stats.run_us += run;
+    g_total_run_us += run;
+    g_total_jobs++;
+    if (wait > g_stats.wait_max_us) g_stats.wait_max_us = wait;
+    if (run >= g_stats.run_max_us) {
+        g_stats.run_max_us = run;
+        g_stats.slowest = job->name;
+    }
+    spin_unlock(g_stats_lock, irq);
+
+    // Jobs without a callback (e.g. draw tasks core0 is spinning on)
+    // never wait here for the main loop
+    if (job->done != NULL) {
+        queue_add_blocking(&g_finished, job);
+    }
+}
+
+// Core1 worker loop
+void job_queue_worker_run(void)
+{
+    LOG_I("Job queue worker started on core%d\n", (int)get_core_num());
+    g_worker_running = true;
+
+    while (true) {
+        job_t job;
+        if (queue_try_remove(&g_urgent, &job)) {
+            run_job(&job);
+        } else if (queue_try_remove(&g_pending, &job)) {
+            g_normal_running = true;
+            run_job(&job);
+            g_normal_running = false;
+        } else {
+            __wfe();   // Adding to a queue sends an event
+        }
+    }
+}
+
+// Queue a job
+bool job_queue_submit(const char *name, job_fn_t run, job_fn_t done, void *arg)
+{
+    if (!g_initialized || !g_worker_running || run == NULL) {
+        return false;
+    }
+
+    job_t job = {
+        .name = name,
+        .run = run,
+        .done = done,
+        .arg = arg,
+        .submitted_us = time_us_32(),
+    };
+    if (!queue_try_add(&g_pending, &job)) {
+        LOG_W("Job queue full, %s runs inline\n", name);
+        return false;
+    }
+    return true;
+}
+
+// Queue a job ahead of the normal ones
+bool job_queue_submit_urgent(const char *name, job_fn_t run, void *arg)
+{
+    // Core1 is busy with a normal job: the caller is faster doing it itself
+    if (!g_initialized || !g_worker_running || run == NULL || g_normal_running) {
+        return false;
+    }
+
+    job_t job = {
+        .name = name,
+        .run = run,
+        .arg = arg,
+        .submitted_us = time_us_32(),
+    };
+    return queue_try_add(&g_urgent, &job);
+}
+
+// Log and reset the window stats
+static void report(uint32_t now)
+{
+    uint32_t irq = spin_lock_blocking(g_stats_lock);
+    job_stats_t stats = g_stats;
+    g_stats = (job_stats_t){0};
+    g_stats.window_start_us = now;
+    spin_unlock(g_stats_lock, irq);
+
+    uint32_t window_us = now - stats.window_start_us;
+
+    if (stats.jobs > 0) {
+        LOG_I("Jobs: %lu done, wait avg %lu max %lu us, run avg %lu max %lu us (%s), done latency max %lu us\n",
+              (unsigned long)stats.jobs,
+              (unsigned long)(stats.wait_us / stats.jobs), (unsigned long)stats.wait_max_us,
+              (unsigned long)(stats.run_us / stats.jobs), (unsigned long)stats.run_max_us,
+              stats.slowest, (unsigned long)stats.done_max_us);
+        LOG_I("Core busy over %lu ms: core0 %lu%%, core1 %lu%%\n",
+              (unsigned long)(window_us / 1000),
+              (unsigned long)(stats.core0_busy_us * 100 / window_us),
+              (unsigned long)(stats.run_us * 100 / window_us));
+    }
+}
+
+// Run completion callbacks and report
+void job_queue_poll(void)
+{
+    if (!g_initialized) {
+        return;
+    }
+
+    job_t job;
+    while (queue_try_remove(&g_finished, &job)) {
+        job.done(job.arg);
+
+        uint32_t done = time_us_32() - job.submitted_us;
+        uint32_t irq = spin_lock_blocking(g_stats_lock);
+        if (done > g_stats.done_max_us) g_stats.done_max_us = done;
+        spin_unlock(g_stats_lock, irq);
+    }
+
+    uint32_t now = time_us_32();
+    if (now - g_stats.window_start_us >= JOB_QUEUE_REPORT_INTERVAL_MS * 1000u) {
+        report(now);
+    }
+}
+
+// Add main loop busy time for core0
+void job_queue_core0_busy(uint32_t busy_us)
+{
+    if (!g_initialized) {
+        return;
+    }
+    uint32_t irq = spin_lock_blocking(g_stats_lock);
+    g_stats.core0_busy_us += busy_us;
+    spin_unlock(g_stats_lock, irq);
+}
+
+// Core1 busy time and jobs run since boot
+void job_queue_get_totals(uint64_t *core1_busy_us, uint32_t *jobs)
+{
+    if (!g_initialized) {
+        *core1_busy_us = 0;
+        *jobs = 0;
+        return;
+    }
+    uint32_t irq = spin_lock_blocking(g_stats_lock);
+    *core1_busy_us = g_total_run_us;
+    *jobs = g_total_jobs;
+    spin_unlock(g_stats_lock, irq);
+}
@@ -0,0 +1,219 @@
+#include "latency_trace.h"
+#include "ui_theme.h"
+#include "pico/stdlib.h"
+#include <stdio.h>
+#include <string.h>
+
+// Stages of one trace
+typedef enum {
+    STAGE_SCAN,
+    STAGE_LVGL,
+    STAGE_WAIT,
+    STAGE_DRAW,
+    STAGE_TOTAL,
+    STAGE_COUNT
+} stage_t;
+
+// Trace progress
+typedef enum {
+    TRACE_IDLE,
+    TRACE_WAIT_INVALIDATE,
+    TRACE_WAIT_REFRESH,
+    TRACE_WAIT_FLUSH
+} trace_state_t;
+
+static const char *g_stage_names[STAGE_COUNT] = {"scan", "lvgl", "wait", "draw", "total"};
+
+static trace_state_t g_state = TRACE_IDLE;
+static uint32_t g_key_us;
+static uint32_t g_indev_us;
+static uint32_t g_invalidate_us;
+static uint32_t g_refresh_us;
+static lv_area_t g_area;             // First area invalidated for the key
+
+static uint32_t g_samples[STAGE_COUNT][LATENCY_TRACE_SAMPLES];
+static uint32_t g_sample_count = 0;  // Total traces (ring index = count % size)
+static uint32_t g_since_dump = 0;
+static uint32_t g_dropped = 0;       // Keys that redrew nothing in time
+
+static lv_obj_t *g_overlay = NULL;
+static lv_timer_t *g_overlay_timer = NULL;
+static bool g_overlay_dirty = false;     // New samples since the last overlay update
+
+// First invalidation after the key
+static void invalidate_cb(lv_event_t *e)
+{
+    if (g_state != TRACE_WAIT_INVALIDATE) {
+        return;
+    }
+    const lv_area_t *area = lv_event_get_param(e);
+    g_area = *area;
+    g_invalidate_us = time_us_32();
+    g_state = TRACE_WAIT_REFRESH;
+}
+
+// Refresh that will draw the invalidated area
+static void refresh_start_cb(lv_event_t *e)
+{
+    (void)e;
+    if (g_state == TRACE_WAIT_REFRESH) {
+        g_refresh_us = time_us_32();
+        g_state = TRACE_WAIT_FLUSH;
+    }
+}
+
+// Initialize
+void latency_trace_init(void)
+{
+    lv_display_t *disp = lv_display_get_default();
+    if (disp == NULL) {
+        return;
+    }
+    lv_display_add_event_cb(disp, invalidate_cb, LV_EVENT_INVALIDATE_AREA, NULL);
+    lv_display_add_event_cb(disp, refresh_start_cb, LV_EVENT_REFR_START, NULL);
+}
+
+// Start a trace
+void latency_trace_key(uint32_t key_us)
+{
+    uint32_t now = time_us_32();
+
+    if (g_state != TRACE_IDLE) {
+        if (now - g_indev_us < LATENCY_TRACE_TIMEOUT_MS * 1000u) {
+            return;   // Still tracing the previous key
+        }
+        g_dropped++;
+    }
+    g_key_us = key_us;
+    g_indev_us = now;
+    g_state = TRACE_WAIT_INVALIDATE;
+}
+
+// Value at percentile p of a sorted window
+static uint32_t percentile(const uint32_t *sorted, uint32_t n, uint32_t p)
+{
+    return sorted[(n - 1) * p / 100];
+}
+
+// Copy one stage's sample window into out, sorted; returns the sample count
+static uint32_t sort_stage(stage_t stage, uint32_t *out)
+{
+    uint32_t n = g_sample_count < LATENCY_TRACE_SAMPLES ? g_sample_count : LATENCY_TRACE_SAMPLES;
+
+    memcpy(out, g_samples[stage], n * sizeof(uint32_t));
+    for (uint32_t i = 1; i < n; i++) {
+        uint32_t v = out[i];
+        uint32_t j = i;
+        while (j > 0 && out[j - 1] > v) {
+            out[j] = out[j - 1];
+            j--;
+        }
+        out[j] = v;
+    }
+    return n;
+}
+
+// Refresh the overlay text (ms with one decimal)
+static void update_overlay(void)
+{
+    static uint32_t sorted[LATENCY_TRACE_SAMPLES];
+    char text[192];
+    int len = snprintf(text, sizeof(text), "key->photon ms p50/p95/p99");
+
+    for (int s = 0; s < STAGE_COUNT && len < (int)sizeof(text); s++) {
+        uint32_t n = sort_stage(s, sorted);
+        if (n == 0) {
+            break;
+        }
+        uint32_t p[3] = {percentile(sorted, n, 50), percentile(sorted, n, 95), percentile(sorted, n, 99)};
+        len += snprintf(text + len, sizeof(text) - len, "\n%s %lu.%lu/%lu.%lu/%lu.%lu", g_stage_names[s],
+                        (unsigned long)(p[0] / 1000), (unsigned long)(p[0] % 1000 / 100),
+                        (unsigned long)(p[1] / 1000), (unsigned long)(p[1] % 1000 / 100),
+                        (unsigned long)(p[2] / 1000), (unsigned long)(p[2] % 1000 / 100));
+    }
+    lv_label_set_text(g_overlay, text);
+}
+
+// Overlay timer: traces end inside the flush callback, where LVGL objects
+// must not be changed, so the text is refreshed from here
+static void overlay_timer_cb(lv_timer_t *timer)
+{
+    (void)timer;
+    if (g_overlay_dirty) {
+        g_overlay_dirty = false;
+        update_overlay();
+    }
+}
+
+// A flush finished: end the trace if it drew the key's area
+void latency_trace_flush_done(const lv_area_t *area)
+{
+    lv_area_t common;
+
+    if (g_state != TRACE_WAIT_FLUSH || !lv_area_intersect(&common, area, &g_area)) {
+        return;
+    }
+
+    uint32_t now = time_us_32();
+    uint32_t i = g_sample_count % LATENCY_TRACE_SAMPLES;
+    g_samples[STAGE_SCAN][i] = g_indev_us - g_key_us;
+    g_samples[STAGE_LVGL][i] = g_invalidate_us - g_indev_us;
+    g_samples[STAGE_WAIT][i] = g_refresh_us - g_invalidate_us;
+    g_samples[STAGE_DRAW][i] = now - g_refresh_us;
+    g_samples[STAGE_TOTAL][i] = now - g_key_us;
+    g_sample_count++;
+    g_state = TRACE_IDLE;
+
+    // The overlay's own redraw happens with no trace running
+    g_overlay_dirty = true;
+    if (++g_since_dump >= LATENCY_TRACE_DUMP_EVERY) {
+        latency_trace_dump();
+    }
+}
+
+// Print percentiles
+void latency_trace_dump(void)
+{
+    static uint32_t sorted[LATENCY_TRACE_SAMPLES];
+
+    g_since_dump = 0;
+    if (g_sample_count == 0) {
+        printf("Key-to-photon: no samples\n");
+        return;
+    }
+
+    printf("Key-to-photon over %lu keys (%lu dropped), us p50/p95/p99:",
+           (unsigned long)(g_sample_count < LATENCY_TRACE_SAMPLES ? g_sample_count : LATENCY_TRACE_SAMPLES),
+           (unsigned long)g_dropped);
+    for (int s = 0; s < STAGE_COUNT; s++) {
+        uint32_t n = sort_stage(s, sorted);
+        printf(" %s %lu/%lu/%lu", g_stage_names[s],
+               (unsigned long)percentile(sorted, n, 50),
+               (unsigned long)percentile(sorted, n, 95),
+               (unsigned long)percentile(sorted, n, 99));
+    }
+    printf("\n");
+}
+
+// Show or hide the overlay
+void latency_trace_toggle_overlay(void)
+{
+    if (g_overlay != NULL) {
+        lv_timer_delete(g_overlay_timer);
+        lv_obj_delete(g_overlay);
+        g_overlay_timer = NULL;
+        g_overlay = NULL;
+        return;
+    }
+
+    g_overlay = lv_label_create(lv_layer_top());
+    lv_obj_set_style_text_font(g_overlay, FONT_SMALL, 0);
+    lv_obj_set_style_text_color(g_overlay, lv_color_hex(THEME_TEXT_TERTIARY), 0);
+    lv_obj_set_style_bg_color(g_overlay, lv_color_hex(THEME_BG_PRIMARY), 0);
+    lv_obj_set_style_bg_opa(g_overlay, LV_OPA_80, 0);
+    lv_obj_set_style_pad_all(g_overlay, 2, 0);
+    lv_obj_align(g_overlay, LV_ALIGN_BOTTOM_RIGHT, 0, 0);
+    lv_label_set_text(g_overlay, "key->photon: press keys");
+    g_overlay_dirty = (g_sample_count > 0);
+    g_overlay_timer = lv_timer_create(overlay_timer_cb, 250, NULL);
+}
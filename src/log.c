@@ -0,0 +1,486 @@
+#include "log.h"
+#include "pico/stdlib.h"
+#include "hardware/uart.h"
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#define LOG_SPEC_MAX 32   // Longest conversion spec after '*' expansion
+
+// Argument types a conversion spec can consume
+typedef enum {
+    ARG_NONE,       // "%%" or a spec that is printed as text
+    ARG_INT,
+    ARG_LONG,
+    ARG_LLONG,
+    ARG_SIZE,
+    ARG_PTRDIFF,
+    ARG_PTR,
+    ARG_DOUBLE,
+    ARG_STRING
+} arg_kind_t;
+
+// One parsed conversion spec
+typedef struct {
+    int len;            // Characters from '%' to the conversion letter
+    arg_kind_t kind;
+    bool star_width;
+    bool star_prec;
+    int prec;           // Literal precision, -1 if none
+} log_spec_t;
+
+// One queued message
+typedef struct {
+    uint32_t seq;       // Slot sequence (see log_write)
+    const char *fmt;
+    uint32_t time_us;
+    uint8_t level;
+    uint8_t core;
+    uint8_t nconv;      // Conversions stored; fewer than in fmt if truncated
+    bool truncated;
+    uint8_t args[LOG_ARG_BYTES];
+    char strings[LOG_STRING_BYTES];
+} log_record_t;
+
+static log_record_t g_ring[LOG_RING_RECORDS];
+static uint32_t g_head = 0;         // Next slot to claim (producers, atomic)
+static uint32_t g_tail = 0;         // Next slot to print (main loop only)
+static uint32_t g_dropped = 0;      // Messages lost to a full ring (atomic)
+static uint32_t g_dropped_reported = 0;
+
+static char g_line[LOG_LINE_MAX + 1];   // Formatted line, without the line ending
+
+static const char g_level_chars[] = "-EWID";
+
+// Parse the conversion spec at p (which points at '%')
+static void parse_spec(const char *p, log_spec_t *s)
+{
+    const char *q = p + 1;
+
+    s->kind = ARG_NONE;
+    s->star_width = false;
+    s->star_prec = false;
+    s->prec = -1;
+
+    while (*q != '\0' && strchr("-+ #0", *q) != NULL) {
+        q++;
+    }
+    if (*q == '*') {
+        s->star_width = true;
+        q++;
+    } else {
+        while (*q >= '0' && *q <= '9') {
+            q++;
+        }
+    }
+    if (*q == '.') {
+        q++;
+        if (*q == '*') {
+            s->star_prec = true;
+            q++;
+        } else {
+            s->prec = 0;
+            while (*q >= '0' && *q <= '9') {
+                s->prec = s->prec * 10 + (*q++ - '0');
+            }
+        }
+    }
+
+    arg_kind_t int_kind = ARG_INT;
+    if (q[0] == 'h') {
+        q += (q[1] == 'h') ? 2 : 1;
+    } else if (q[0] == 'l' && q[1] == 'l') {
+        int_kind = ARG_LLONG;
+        q += 2;
+    } else if (q[0] == 'l') {
+        int_kind = ARG_LONG;
+        q++;
+    } else if (q[0] == 'j') {
+        int_kind = ARG_LLONG;
+        q++;
+    } else if (q[0] == 'z') {
+        int_kind = ARG_SIZE;
+        q++;
+    } else if (q[0] == 't') {
+        int_kind = ARG_PTRDIFF;
+        q++;
+    }
+
+    if (*q == '\0') {
+        s->len = (int)(q - p);
+        s->star_width = s->star_prec = false;   // Malformed: printed as text
+        return;
+    }
+
+    switch (*q) {
+        case 'd': case 'i': case 'u': case 'x': case 'X': case 'o':
+            s->kind = int_kind;
+            break;
+        case 'c':
+            s->kind = ARG_INT;
+            break;
+        case 's':
+            s->kind = ARG_STRING;
+            break;
+        case 'p':
+            s->kind = ARG_PTR;
+            break;
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+            s->kind = ARG_DOUBLE;
+            break;
+        default:
+            s->star_width = s->star_prec = false;   // "%%", %n, unknown
+            break;
+    }
+    s->len = (int)(q + 1 - p);
+}
+
+// Size of the value a spec stores
+static size_t arg_size(arg_kind_t kind)
+{
+    switch (kind) {
+        case ARG_INT:     return sizeof(int);
+        case ARG_LONG:    return sizeof(long);
+        case ARG_LLONG:   return sizeof(long long);
+        case ARG_SIZE:    return sizeof(size_t);
+        case ARG_PTRDIFF: return sizeof(ptrdiff_t);
+        case ARG_PTR:     return sizeof(void *);
+        case ARG_DOUBLE:  return sizeof(double);
+        default:          return 0;
+    }
+}
+
+// Append a value to the record's argument bytes (4-byte aligned)
+static bool push_arg(log_record_t *rec, size_t *off, const void *value, size_t size)
+{
+    size_t at = (*off + 3) & ~(size_t)3;
+    if (at + size > LOG_ARG_BYTES) {
+        return false;
+    }
+    memcpy(&rec->args[at], value, size);
+    *off = at + size;
+    return true;
+}
+
+// Read the next value back out of the argument bytes
+static void pop_arg(const log_record_t *rec, size_t *off, void *value, size_t size)
+{
+    size_t at = (*off + 3) & ~(size_t)3;
+    memcpy(value, &rec->args[at], size);
+    *off = at + size;
+}
+
+// Copy the arguments fmt consumes from ap into rec
+static void capture_args(log_record_t *rec, const char *fmt, va_list ap)
+{
+    size_t off = 0;
+    size_t soff = 0;
+
+    rec->nconv = 0;
+    rec->truncated = false;
+
+    for (const char *p = fmt; *p != '\0'; p++) {
+        if (*p != '%') {
+            continue;
+        }
+
+        log_spec_t s;
+        parse_spec(p, &s);
+        p += s.len - 1;
+        if (s.kind == ARG_NONE) {
+            continue;
+        }
+
+        bool ok = true;
+        if (s.star_width) {
+            int width = va_arg(ap, int);
+            ok = push_arg(rec, &off, &width, sizeof(width));
+        }
+        if (ok && s.star_prec) {
+            s.prec = va_arg(ap, int);
+            ok = push_arg(rec, &off, &s.prec, sizeof(s.prec));
+        }
+
+        switch (s.kind) {
+            case ARG_INT:     { int v = va_arg(ap, int);             ok = ok && push_arg(rec, &off, &v, sizeof(v)); break; }
+            case ARG_LONG:    { long v = va_arg(ap, long);           ok = ok && push_arg(rec, &off, &v, sizeof(v)); break; }
+            case ARG_LLONG:   { long long v = va_arg(ap, long long); ok = ok && push_arg(rec, &off, &v, sizeof(v)); break; }
+            case ARG_SIZE:    { size_t v = va_arg(ap, size_t);       ok = ok && push_arg(rec, &off, &v, sizeof(v)); break; }
+            case ARG_PTRDIFF: { ptrdiff_t v = va_arg(ap, ptrdiff_t); ok = ok && push_arg(rec, &off, &v, sizeof(v)); break; }
+            case ARG_PTR:     { void *v = va_arg(ap, void *);        ok = ok && push_arg(rec, &off, &v, sizeof(v)); break; }
+            case ARG_DOUBLE:  { double v = va_arg(ap, double);       ok = ok && push_arg(rec, &off, &v, sizeof(v)); break; }
+            case ARG_STRING: {
+                const char *str = va_arg(ap, const char *);
+                if (str == NULL) {
+                    str = "(null)";
+                }
+                size_t room = LOG_STRING_BYTES - soff;
+                if (!ok || room < 2) {
+                    ok = false;
+                    break;
+                }
+                // Bounded by the precision, so "%.*s" may point at unterminated data
+                size_t limit = (s.prec >= 0 && (size_t)s.prec < room - 1) ? (size_t)s.prec : room - 1;
+                size_t n = 0;
+                while (n < limit && str[n] != '\0') {
+                    n++;
+                }
+                memcpy(&rec->strings[soff], str, n);
+                rec->strings[soff + n] = '\0';
+                soff += n + 1;
+                break;
+            }
+            default:
+                break;
+        }
+
+        if (!ok) {
+            rec->truncated = true;
+            return;
+        }
+        rec->nconv++;
+    }
+}
+
+// Queue a message. Slots follow the bounded MPMC queue scheme: a slot is free
+// for position pos when its seq equals pos, and holds a message once seq is
+// pos + 1, so producers on both cores and in IRQs never wait for each other.
+void log_write(uint8_t level, const char *fmt, ...)
+{
+    uint32_t pos = __atomic_load_n(&g_head, __ATOMIC_RELAXED);
+    log_record_t *rec;
+
+    for (;;) {
+        rec = &g_ring[pos & (LOG_RING_RECORDS - 1)];
+        uint32_t seq = __atomic_load_n(&rec->seq, __ATOMIC_ACQUIRE);
+        int32_t diff = (int32_t)(seq - pos);
+
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&g_head, &pos, pos + 1, true,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (diff < 0) {
+            __atomic_fetch_add(&g_dropped, 1, __ATOMIC_RELAXED);
+            return;
+        } else {
+            pos = __atomic_load_n(&g_head, __ATOMIC_RELAXED);
+        }
+    }
+
+    rec->fmt = fmt;
+    rec->time_us = time_us_32();
+    rec->level = level;
+    rec->core = (uint8_t)get_core_num();
+
+    va_list ap;
+    va_start(ap, fmt);
+    capture_args(rec, fmt, ap);
+    va_end(ap);
+
+    __atomic_store_n(&rec->seq, pos + 1, __ATOMIC_RELEASE);
+}
+
+// Format one conversion, expanding '*' from the stored arguments
+static int format_arg(const log_record_t *rec, const char *p, const log_spec_t *s,
+                      size_t *off, const char **str, char *out, size_t size)
+{
+    char spec[LOG_SPEC_MAX];
+    int n = 0;
+
+    for (int i = 0; i < s->len && n < LOG_SPEC_MAX - 12; i++) {
+        if (p[i] == '*') {
+            int v;
+            pop_arg(rec, off, &v, sizeof(v));
+            n += snprintf(&spec[n], LOG_SPEC_MAX - n, "%d", v);
+        } else {
+            spec[n++] = p[i];
+        }
+    }
+    spec[n] = '\0';
+
+    switch (s->kind) {
+        case ARG_STRING: {
+            const char *v = *str;
+            *str += strlen(v) + 1;
+            return snprintf(out, size, spec, v);
+        }
+        case ARG_DOUBLE: {
+            double v;
+            pop_arg(rec, off, &v, sizeof(v));
+            return snprintf(out, size, spec, v);
+        }
+        case ARG_LLONG: {
+            long long v;
+            pop_arg(rec, off, &v, sizeof(v));
+            return snprintf(out, size, spec, v);
+        }
+        case ARG_LONG: {
+            long v;
+            pop_arg(rec, off, &v, sizeof(v));
+            return snprintf(out, size, spec, v);
+        }
+        case ARG_SIZE: {
+            size_t v;
+            pop_arg(rec, off, &v, sizeof(v));
+            return snprintf(out, size, spec, v);
+        }
+        case ARG_PTRDIFF: {
+            ptrdiff_t v;
+            pop_arg(rec, off, &v, sizeof(v));
+            return snprintf(out, size, spec, v);
+        }
+        case ARG_PTR: {
+            void *v;
+            pop_arg(rec, off, &v, sizeof(v));
+            return snprintf(out, size, spec, v);
+        }
+        default: {
+            int v;
+            pop_arg(rec, off, &v, arg_size(ARG_INT));
+            return snprintf(out, size, spec, v);
+        }
+    }
+}
+
+// Format a record into g_line: "[  12.345 I0] message"
+static void format_record(const log_record_t *rec)
+{
+    const size_t size = LOG_LINE_MAX + 1;
+    size_t n;
+    size_t off = 0;
+    const char *str = rec->strings;
+    int conv = 0;
+
+    n = (size_t)snprintf(g_line, size, "[%5lu.%03lu %c%u] ",
+                         (unsigned long)(rec->time_us / 1000000),
+                         (unsigned long)((rec->time_us / 1000) % 1000),
+                         g_level_chars[rec->level < sizeof(g_level_chars) - 1 ? rec->level : 0],
+                         rec->core);
+
+    for (const char *p = rec->fmt; *p != '\0' && n < size - 1; p++) {
+        if (*p != '%') {
+            if (*p != '\n' || p[1] != '\0') {   // The line ending is added below
+                g_line[n++] = *p;
+            }
+            continue;
+        }
+
+        log_spec_t s;
+        parse_spec(p, &s);
+        if (s.kind == ARG_NONE) {
+            if (p[1] == '%') {
+                g_line[n++] = '%';
+            } else {
+                size_t len = (size_t)s.len < size - 1 - n ? (size_t)s.len : size - 1 - n;
+                memcpy(&g_line[n], p, len);
+                n += len;
+            }
+            p += s.len - 1;
+            continue;
+        }
+
+        if (conv == rec->nconv) {
+            n += (size_t)snprintf(&g_line[n], size - n, "...");
+            break;
+        }
+        int w = format_arg(rec, p, &s, &off, &str, &g_line[n], size - n);
+        if (w > 0) {
+            n += (size_t)w;
+        }
+        conv++;
+        p += s.len - 1;
+    }
+
+    if (n > size - 1) {
+        n = size - 1;
+    }
+    g_line[n] = '\0';
+}
+
+// Load the next line to send; false if nothing is queued
+static bool next_line(void)
+{
+    uint32_t dropped = __atomic_load_n(&g_dropped, __ATOMIC_RELAXED);
+    if (dropped != g_dropped_reported) {
+        snprintf(g_line, sizeof(g_line), "[log] %lu messages dropped",
+                 (unsigned long)(dropped - g_dropped_reported));
+        g_dropped_reported = dropped;
+        return true;
+    }
+
+    log_record_t *rec = &g_ring[g_tail & (LOG_RING_RECORDS - 1)];
+    if (__atomic_load_n(&rec->seq, __ATOMIC_ACQUIRE) != g_tail + 1) {
+        return false;
+    }
+
+    format_record(rec);
+    __atomic_store_n(&rec->seq, g_tail + LOG_RING_RECORDS, __ATOMIC_RELEASE);
+    g_tail++;
+    return true;
+}
+
+// True once the UART TX FIFO has emptied
+static bool uart_tx_idle(void)
+{
+    return (uart_get_hw(uart_default)->fr & UART_UARTFR_TXFE_BITS) != 0;
+}
+
+// Initialize
+void log_init(void)
+{
+    for (uint32_t i = 0; i < LOG_RING_RECORDS; i++) {
+        g_ring[i].seq = i;
+    }
+    g_head = 0;
+    g_tail = 0;
+}
+
+// Lines go to stdio whole: puts() writes one under stdio's lock, so printf
+// output from elsewhere can only land between them. A line is only started
+// once the last one has left the TX FIFO, so a call blocks for at most the
+// part of one line that doesn't fit in the FIFO.
+void log_drain(void)
+{
+    while (uart_tx_idle() && next_line()) {
+        puts(g_line);
+    }
+}
+
+void log_flush(void)
+{
+    while (next_line()) {
+        puts(g_line);
+    }
+    uart_tx_wait_blocking(uart_default);
+}
+
+// Benchmark: queued message vs synchronous printf of the same line
+void log_benchmark(uint32_t *log_ns, uint32_t *printf_ns, uint32_t *drain_us)
+{
+    const int log_calls = LOG_RING_RECORDS / 2;
+    const int printf_calls = 8;
+
+    log_flush();
+
+    uint64_t t0 = time_us_64();
+    for (int i = 0; i < log_calls; i++) {
+        log_write(LOG_LEVEL_INFO, "log bench %d of %d, value 0x%08lx", i, log_calls, (unsigned long)t0);
+    }
+    uint32_t log_us = (uint32_t)(time_us_64() - t0);
+
+    // Format and send them now so the printf run starts with an empty FIFO
+    t0 = time_us_64();
+    log_flush();
+    *drain_us = (uint32_t)(time_us_64() - t0);
+
+    t0 = time_us_64();
+    for (int i = 0; i < printf_calls; i++) {
+        printf("printf bench %d of %d, value 0x%08lx\n", i, printf_calls, (unsigned long)t0);
+    }
+    uint32_t printf_us = (uint32_t)(time_us_64() - t0);
+
+    *log_ns = log_us * 1000u / log_calls;
+    *printf_ns = printf_us * 1000u / printf_calls;
+}
@@ -14,6 +14,9 @@
 #include <stdio.h>
 #include "lcdspi/lcdspi.h"
 #include "psram_helper.h"
+#include "latency_trace.h"
+#include "trace.h"
+#include "runtime_stats.h"
 
 
 
@@ -32,9 +35,18 @@
 
 #define BYTE_PER_PIXEL (LV_COLOR_FORMAT_GET_SIZE(LV_COLOR_FORMAT_RGB565)) /*will be 2 for RGB565 */
 
+#define HW_SCROLL_MIN_ROWS      16  /* Smaller areas are just redrawn */
+#define HW_SCROLL_BENCH_STEPS   8
+#define HW_SCROLL_BENCH_DY      16
+
 /**********************
  *      TYPEDEFS
  **********************/
+/* State of an object that scrolls with the panel's hardware scrolling */
+typedef struct {
+    lv_obj_t * obj;
+    int32_t scroll_y;       /* Scroll position the panel content matches */
+} hw_scroll_t;
 
 /**********************
  *  STATIC PROTOTYPES
@@ -43,9 +55,18 @@ static void disp_init(void);
 
 static void disp_flush(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map);
 
+static void hw_scroll_obj_event_cb(lv_event_t * e);
+static void hw_scroll_invalidate_cb(lv_event_t * e);
+
 /**********************
  *  STATIC VARIABLES
  **********************/
+static lv_area_t g_hw_scroll_band;          /* Rows that are the panel's scroll area */
+static bool g_hw_scroll_band_set = false;
+static lv_area_t g_hw_scroll_drop;          /* Whole-band invalidation to drop after a hardware scroll */
+static lv_area_t g_hw_scroll_exposed;       /* Rows that scrolled in (already invalidated) */
+static bool g_hw_scroll_drop_pending = false;
+static bool g_hw_scroll_enabled = true;
 
 /**********************
  *      MACROS
@@ -76,6 +97,53 @@ void lv_port_disp_init(void)
     printf("Display buffer: %zu KB in internal SRAM (for best performance)\n", sizeof(buf_1) / 1024);
 
     lv_display_set_buffers(disp, buf_1, NULL, sizeof(buf_1), LV_DISPLAY_RENDER_MODE_PARTIAL);
+
+    lv_display_add_event_cb(disp, hw_scroll_invalidate_cb, LV_EVENT_INVALIDATE_AREA, NULL);
+}
+
+void lv_port_disp_hw_scroll_attach(lv_obj_t * obj)
+{
+    hw_scroll_t * s = lv_malloc(sizeof(hw_scroll_t));
+    if(s == NULL) {
+        return;
+    }
+    s->obj = obj;
+    s->scroll_y = lv_obj_get_scroll_y(obj);
+
+    lv_obj_add_event_cb(obj, hw_scroll_obj_event_cb, LV_EVENT_SCROLL, s);
+    lv_obj_add_event_cb(obj, hw_scroll_obj_event_cb, LV_EVENT_DELETE, s);
+}
+
+bool lv_port_disp_hw_scroll_benchmark(lv_obj_t * obj, uint32_t * redraw_bytes, uint32_t * hw_bytes)
+{
+    lv_display_t * disp = lv_display_get_default();
+    uint32_t bytes[2];
+    int32_t lines[2];
+
+    for(int hw = 0; hw < 2; hw++) {
+        g_hw_scroll_enabled = hw;
+        lv_refr_now(disp);
+
+        int32_t y0 = lv_obj_get_scroll_y(obj);
+        uint32_t bytes_start = lcd_spi_bytes();
+        for(int i = 0; i < HW_SCROLL_BENCH_STEPS; i++) {
+            lv_obj_scroll_by_bounded(obj, 0, -HW_SCROLL_BENCH_DY, LV_ANIM_OFF);
+            lv_refr_now(disp);
+        }
+        bytes[hw] = lcd_spi_bytes() - bytes_start;
+        lines[hw] = lv_obj_get_scroll_y(obj) - y0;
+
+        lv_obj_scroll_to_y(obj, y0, LV_ANIM_OFF);
+        lv_refr_now(disp);
+    }
+    g_hw_scroll_enabled = true;
+
+    if(lines[0] <= 0 || lines[1] <= 0) {
+        return false;   /* Nothing to scroll */
+    }
+    *redraw_bytes = bytes[0] / lines[0];
+    *hw_bytes = bytes[1] / lines[1];
+    return true;
 }
 
 /**********************
@@ -111,17 +179,180 @@ void disp_disable_update(void)
  *'lv_display_flush_ready()' has to be called when it's finished.*/
 static void disp_flush(lv_display_t * disp_drv, const lv_area_t * area, uint8_t * px_map)
 {
+    /* Anything invalidated from here on is a real change */
+    g_hw_scroll_drop_pending = false;
+
+    trace_begin(TRACE_DISP_FLUSH);
     if(disp_flush_enabled) 
     {
         /* Use the lcdspi function to transfer the rendered area to the screen */
+        uint64_t t0 = time_us_64();
         draw_buffer_spi(area->x1, area->y1, area->x2, area->y2, px_map);
+        latency_trace_flush_done(area);
+        runtime_stats_flush((uint32_t)(time_us_64() - t0),
+                            lv_area_get_size(area) * BYTE_PER_PIXEL,
+                            lv_display_flush_is_last(disp_drv));
     }
+    trace_end(TRACE_DISP_FLUSH);
 
     /*IMPORTANT!!!
      *Inform the graphics library that you are ready with the flushing*/
     lv_display_flush_ready(disp_drv);
 }
 
+/* Invalidate full-width screen rows y1..y2 */
+static void invalidate_rows(int32_t y1, int32_t y2)
+{
+    lv_area_t a = {0, y1, MY_DISP_HOR_RES - 1, y2};
+    if(y1 <= y2) {
+        lv_obj_invalidate_area(lv_screen_active(), &a);
+    }
+}
+
+/* Rows of the object that shift uniformly when its content scrolls: inside
+ * the border and clear of the corner radius. Everything else on the same
+ * screen rows has to be plain background. Returns false if it can't be used. */
+static bool hw_scroll_band(lv_obj_t * obj, lv_area_t * band)
+{
+    lv_obj_t * screen = lv_obj_get_screen(obj);
+    if(screen != lv_screen_active()) {
+        return false;
+    }
+    if(lv_obj_get_style_bg_grad_dir(obj, LV_PART_MAIN) != LV_GRAD_DIR_NONE ||
+       lv_obj_get_style_bg_grad_dir(screen, LV_PART_MAIN) != LV_GRAD_DIR_NONE) {
+        return false;
+    }
+
+    int32_t inset = lv_obj_get_style_border_width(obj, LV_PART_MAIN) +
+                    LV_MIN(lv_obj_get_style_radius(obj, LV_PART_MAIN), lv_obj_get_height(obj));
+    lv_obj_get_coords(obj, band);
+    band->y1 = LV_MAX(band->y1 + inset, 0);
+    band->y2 = LV_MIN(band->y2 - inset, MY_DISP_VER_RES - 1);
+    if(lv_area_get_height(band) < HW_SCROLL_MIN_ROWS) {
+        return false;
+    }
+
+    /* No other top level object may draw on these rows */
+    for(uint32_t i = 0; i < lv_obj_get_child_count(screen); i++) {
+        lv_obj_t * child = lv_obj_get_child(screen, i);
+        if(child == obj || lv_obj_has_flag(child, LV_OBJ_FLAG_HIDDEN)) {
+            continue;
+        }
+        lv_obj_t * parent = obj;
+        while(parent != NULL && parent != child) {
+            parent = lv_obj_get_parent(parent);
+        }
+        if(parent == child) {
+            continue;   /* Ancestor of the scrolling object */
+        }
+        lv_area_t c;
+        lv_obj_get_coords(child, &c);
+        if(c.y2 >= band->y1 && c.y1 <= band->y2) {
+            return false;
+        }
+    }
+
+    /* Top layer overlays (performance, latency, dialogs) only matter on the band's rows */
+    lv_obj_t * top = lv_layer_top();
+    for(uint32_t i = 0; i < lv_obj_get_child_count(top); i++) {
+        lv_obj_t * child = lv_obj_get_child(top, i);
+        if(lv_obj_has_flag(child, LV_OBJ_FLAG_HIDDEN)) {
+            continue;
+        }
+        lv_area_t c;
+        lv_obj_get_coords(child, &c);
+        if(c.y2 >= band->y1 && c.y1 <= band->y2) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Shift the panel instead of redrawing: move the scroll area by the scroll
+ * delta, then only invalidate what doesn't simply move with the rows */
+static void hw_scroll_obj_event_cb(lv_event_t * e)
+{
+    hw_scroll_t * s = lv_event_get_user_data(e);
+
+    if(lv_event_get_code(e) == LV_EVENT_DELETE) {
+        /* Frame memory keeps its row mapping; other screens draw through it */
+        lv_free(s);
+        return;
+    }
+
+    g_hw_scroll_drop_pending = false;
+
+    int32_t y = lv_obj_get_scroll_y(s->obj);
+    int32_t dy = y - s->scroll_y;   /* > 0: content moved up */
+    s->scroll_y = y;
+
+    lv_area_t band;
+    if(dy == 0 || !g_hw_scroll_enabled || !hw_scroll_band(s->obj, &band) ||
+       LV_ABS(dy) >= lv_area_get_height(&band)) {
+        return;   /* LVGL redraws the object as usual */
+    }
+
+    if(!g_hw_scroll_band_set || band.y1 != g_hw_scroll_band.y1 || band.y2 != g_hw_scroll_band.y2) {
+        /* A new scroll area resets the start line: redraw the old rows once,
+         * LVGL redraws the object itself after this event */
+        if(g_hw_scroll_band_set && lcd_vscroll_active()) {
+            invalidate_rows(g_hw_scroll_band.y1, g_hw_scroll_band.y2);
+        }
+        lcd_vscroll_define(band.y1, lv_area_get_height(&band));
+        g_hw_scroll_band = band;
+        g_hw_scroll_band_set = true;
+        return;
+    }
+
+    lcd_vscroll_by(dy);
+
+    /* Rows that scrolled in, the object's rows outside the band and its scrollbar */
+    lv_area_t coords;
+    lv_obj_get_coords(s->obj, &coords);
+    g_hw_scroll_exposed = band;
+    if(dy > 0) {
+        g_hw_scroll_exposed.y1 = band.y2 - dy + 1;
+    }
+    else {
+        g_hw_scroll_exposed.y2 = band.y1 - dy - 1;
+    }
+    invalidate_rows(g_hw_scroll_exposed.y1, g_hw_scroll_exposed.y2);
+    invalidate_rows(coords.y1, band.y1 - 1);
+    invalidate_rows(band.y2 + 1, coords.y2);
+
+    lv_area_t hor, ver;
+    lv_obj_get_scrollbar_area(s->obj, &hor, &ver);
+    if(lv_area_get_width(&ver) > 0) {
+        ver.y1 = band.y1;
+        ver.y2 = band.y2;
+        lv_obj_invalidate_area(lv_screen_active(), &ver);
+    }
+
+    /* LVGL invalidates the whole object right after this event */
+    g_hw_scroll_drop = band;
+    g_hw_scroll_drop_pending = true;
+}
+
+/* Drop the whole-object invalidation that follows a hardware scroll */
+static void hw_scroll_invalidate_cb(lv_event_t * e)
+{
+    lv_area_t * area = lv_event_get_param(e);
+
+    if(!g_hw_scroll_drop_pending) {
+        return;
+    }
+
+    if(area->y1 <= g_hw_scroll_drop.y1 && area->y2 >= g_hw_scroll_drop.y2 &&
+       area->x1 <= g_hw_scroll_drop.x1 && area->x2 >= g_hw_scroll_drop.x2) {
+        /* Shrink it to a pixel that is already invalid so it merges away */
+        area->x1 = g_hw_scroll_exposed.x1;
+        area->x2 = g_hw_scroll_exposed.x1;
+        area->y1 = g_hw_scroll_exposed.y1;
+        area->y2 = g_hw_scroll_exposed.y1;
+        g_hw_scroll_drop_pending = false;
+    }
+}
+
 #else /*Enable this file at the top*/
 
 /*This dummy typedef exists purely to silence -Wpedantic.*/
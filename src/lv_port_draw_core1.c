@@ -0,0 +1,224 @@
+/**
+ * @file lv_port_draw_core1.c
+ *
+ * Second LVGL draw unit that renders on core1.
+ *
+ * The project runs LVGL without an OS (LV_OS_NONE), so the software draw
+ * unit renders each task inline on core0 and LVGL cannot spawn draw threads.
+ * This unit takes part in the same dispatch loop instead: it picks an
+ * available task, hands it to core1 as a job and returns at once, so the
+ * software unit can render the next independent task on core0 meanwhile.
+ * When core1 finishes it marks the task ready and requests a new dispatch,
+ * which ends LVGL's wait in lv_draw_dispatch_wait_for_request().
+ *
+ * Only tasks that render without touching the LVGL heap are offloaded
+ * (plain fills and borders without radius or gradient), since the heap,
+ * image decoders and caches are not safe to use from core1 without an OS.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_port_draw_core1.h"
+#include "src/draw/lv_draw_private.h"
+#include "src/draw/sw/lv_draw_sw.h"
+#include "hardware/sync.h"
+#include "pico/stdlib.h"
+#include "job_queue.h"
+#include "log.h"
+#include <stdio.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#ifndef DRAW_UNIT_ID_SW
+    #define DRAW_UNIT_ID_SW 1   /* Software unit id, as in lv_draw_sw.c */
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    lv_draw_unit_t base_unit;
+    lv_draw_task_t * volatile task_act;     /* Task being rendered by core1 */
+    volatile uint32_t tasks_core1;          /* Tasks rendered on core1 */
+    uint32_t tasks_inline;                  /* Taken, but rendered on core0 (core1 busy) */
+} draw_core1_unit_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static int32_t draw_core1_evaluate(lv_draw_unit_t * draw_unit, lv_draw_task_t * task);
+static int32_t draw_core1_dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static draw_core1_unit_t * g_unit = NULL;
+static volatile bool g_enabled = true;
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_port_draw_core1_init(void)
+{
+    if(g_unit != NULL) {
+        return;
+    }
+
+    g_unit = lv_draw_create_unit(sizeof(draw_core1_unit_t));
+    g_unit->base_unit.evaluate_cb = draw_core1_evaluate;
+    g_unit->base_unit.dispatch_cb = draw_core1_dispatch;
+
+    printf("LVGL core1 draw unit registered\n");
+}
+
+void lv_port_draw_core1_set_enabled(bool enabled)
+{
+    g_enabled = enabled;
+}
+
+/* Average time of full-screen redraws of the active screen */
+static uint32_t time_full_redraws(lv_display_t * disp)
+{
+    lv_obj_t * screen = lv_display_get_screen_active(disp);
+    uint64_t total = 0;
+
+    for(int i = 0; i < DRAW_CORE1_BENCH_FRAMES; i++) {
+        lv_obj_invalidate(screen);
+        uint64_t t0 = time_us_64();
+        lv_refr_now(disp);
+        total += time_us_64() - t0;
+    }
+    return (uint32_t)(total / DRAW_CORE1_BENCH_FRAMES);
+}
+
+void lv_port_draw_core1_report_frame_time(const char * name)
+{
+    lv_display_t * disp = lv_display_get_default();
+    if(g_unit == NULL || disp == NULL) {
+        return;
+    }
+
+    bool was_enabled = g_enabled;
+
+    g_enabled = false;
+    uint32_t one_unit = time_full_redraws(disp);
+
+    g_enabled = true;
+    uint32_t core1_before = g_unit->tasks_core1;
+    uint32_t two_units = time_full_redraws(disp);
+    uint32_t core1_tasks = (g_unit->tasks_core1 - core1_before) / DRAW_CORE1_BENCH_FRAMES;
+
+    g_enabled = was_enabled;
+
+    LOG_I("Frame %s: 1 draw unit %lu us, 2 draw units %lu us (%lu tasks/frame on core1, %lu inline so far)\n",
+          name, (unsigned long)one_unit, (unsigned long)two_units,
+          (unsigned long)core1_tasks, (unsigned long)g_unit->tasks_inline);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/* Tasks that render with the software blender alone: no masks, gradients or heap */
+static bool task_is_offloadable(const lv_draw_task_t * t)
+{
+    switch(t->type) {
+        case LV_DRAW_TASK_TYPE_FILL: {
+                const lv_draw_fill_dsc_t * dsc = t->draw_dsc;
+                return dsc->radius == 0 && dsc->grad.dir == LV_GRAD_DIR_NONE;
+            }
+        case LV_DRAW_TASK_TYPE_BORDER: {
+                const lv_draw_border_dsc_t * dsc = t->draw_dsc;
+                return dsc->radius == 0;
+            }
+        default:
+            return false;
+    }
+}
+
+static void execute_drawing(lv_draw_task_t * t)
+{
+    switch(t->type) {
+        case LV_DRAW_TASK_TYPE_FILL:
+            lv_draw_sw_fill(t, t->draw_dsc, &t->area);
+            break;
+        case LV_DRAW_TASK_TYPE_BORDER:
+            lv_draw_sw_border(t, t->draw_dsc, &t->area);
+            break;
+        default:
+            break;
+    }
+}
+
+/* Hand the finished task back to the dispatcher. Nothing may touch the task
+ * after it is marked ready: core0 frees it on its next dispatch. */
+static void finish_task(draw_core1_unit_t * u)
+{
+    lv_draw_task_t * t = u->task_act;
+    u->task_act = NULL;
+    __dmb();
+    t->state = LV_DRAW_TASK_STATE_READY;
+    __dmb();
+    lv_draw_dispatch_request();
+}
+
+/* Job: render the unit's task on core1 */
+static void render_job(void * arg)
+{
+    draw_core1_unit_t * u = arg;
+    execute_drawing(u->task_act);
+    u->tasks_core1++;
+    finish_task(u);
+}
+
+static int32_t draw_core1_evaluate(lv_draw_unit_t * draw_unit, lv_draw_task_t * task)
+{
+    /* Tasks stay preferred by the software unit; this unit takes offloadable
+     * ones from that pool in dispatch, whichever core is free first */
+    LV_UNUSED(draw_unit);
+    LV_UNUSED(task);
+    return 0;
+}
+
+static int32_t draw_core1_dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer)
+{
+    draw_core1_unit_t * u = (draw_core1_unit_t *)draw_unit;
+
+    if(!g_enabled) {
+        return LV_DRAW_UNIT_IDLE;
+    }
+
+    /* Return immediately if core1 is still on the previous task */
+    if(u->task_act != NULL) {
+        return 0;
+    }
+
+    lv_draw_task_t * t = lv_draw_get_next_available_task(layer, NULL, DRAW_UNIT_ID_SW);
+    while(t != NULL && !task_is_offloadable(t)) {
+        t = lv_draw_get_next_available_task(layer, t, DRAW_UNIT_ID_SW);
+    }
+    if(t == NULL) {
+        return LV_DRAW_UNIT_IDLE;
+    }
+
+    /* The layer buffer is allocated here, on core0 */
+    if(lv_draw_layer_alloc_buf(layer) == NULL) {
+        return LV_DRAW_UNIT_IDLE;
+    }
+
+    t->state = LV_DRAW_TASK_STATE_IN_PROGRESS;
+    t->draw_unit = draw_unit;
+    u->task_act = t;
+
+    if(!job_queue_submit_urgent("draw", render_job, u)) {
+        /* Core1 is busy or unavailable: render here rather than stall the frame */
+        execute_drawing(t);
+        u->tasks_inline++;
+        finish_task(u);
+    }
+
+    return 1;
+}
@@ -13,21 +13,40 @@
 #include <string.h>
 #include <pico/stdio.h>
 #include "lv_port_indev_picocalc_kb.h"
+#include "latency_trace.h"
+#include "trace.h"
+#include "log.h"
+#include "profiler.h"
+#include "perf_overlay.h"
 
 /*********************
  *      DEFINES
  *********************/
+#define KEY_LATENCY_REPORT_INTERVAL_MS  10000
+#define KEY_TRACE_OVERLAY               0x90    /* F10 toggles the key-to-photon overlay */
+#define KEY_TRACE_DUMP                  0x89    /* F9 dumps the hot-path trace rings */
+#define KEY_PROFILER                    0x88    /* F8 starts the sampling profiler, or stops and dumps it */
+#define KEY_PERF_OVERLAY                0x81    /* F1 toggles the performance overlay */
 
 /**********************
  *      TYPEDEFS
  **********************/
+/* Key-to-event latency: scanner receive time to delivery to LVGL */
+typedef struct {
+    uint32_t window_start_us;
+    uint32_t events;
+    uint64_t latency_us;
+    uint32_t latency_max_us;
+    uint32_t batch_max;         /* Most events delivered in one indev read */
+} key_latency_stats_t;
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void keypad_init(void);
 static void keypad_read(lv_indev_t * indev, lv_indev_data_t * data);
-static int keypad_get_key(void);
+static uint32_t keypad_translate(int r);
+static void key_latency_report(void);
 
 
 /**********************
@@ -35,6 +54,8 @@ static int keypad_get_key(void);
  **********************/
 lv_indev_t * indev_keypad;
 static lv_group_t *g;  /* Group for keyboard navigation */
+static key_latency_stats_t key_stats;
+static uint8_t pressed_as[256];  /* LVGL key sent for each pressed keyboard key */
 
 /**********************
  *      MACROS
@@ -94,165 +115,237 @@ void lv_port_indev_init(void)
 static void keypad_init(void)
 {
     init_i2c_kbd();
+    i2c_kbd_scan_start();
+    key_stats.window_start_us = time_us_32();
 }
 
+/* Deliver one queued key event per call; LVGL calls again while
+ * continue_reading is set, so a burst of keys is drained in one poll */
 static void keypad_read(lv_indev_t * indev_drv, lv_indev_data_t * data)
 {
     static uint32_t last_key = 0;
-    static bool pending_release = false;
+    static uint32_t batch = 0;
+    kbd_event_t ev;
 
-    /* Check if we need to send a release event for the previous key */
-    if(pending_release) 
-    {
-        data->state = LV_INDEV_STATE_RELEASED;
-        data->key = last_key;
-        pending_release = false;
-        return;
-    }
+    data->key = last_key;
+    data->state = LV_INDEV_STATE_RELEASED;
+    data->continue_reading = false;
 
-    /*Get whether the a key is pressed and save the pressed key*/
-    int r = keypad_get_key();
-    
-    uint32_t act_key = 0;
-    if (r > 0) 
+    while(i2c_kbd_pop_event(&ev))
     {
-        printf("Key event %x\n", r);
-        
-        /* Translate the keys to LVGL control characters according to your key definitions */
-        switch (r) {
-            case 0xb5: // Arrow Up
-                act_key = LV_KEY_UP;
-                break;
-            case 0xb6: // Arrow Down
-                act_key = LV_KEY_DOWN;
-                break;
-            case 0xb4: // Arrow Left
-                act_key = LV_KEY_LEFT;
-                break;
-            case 0xb7: // Arrow Right
-                act_key = LV_KEY_RIGHT;
-                break;
-
-            // Special Keys
-            // Row 1
-            case 0x81: case 0x82: case 0x83: case 0x84: case 0x85:
-            case 0x86: case 0x87: case 0x88: case 0x89: case 0x90:// F1-F10 Keys
-                printf("WARN: Function keys not mapped\n");
-                act_key = 0;
-                break;
-
-            // Row 2
-            case 0xB1: // ESC
-                act_key = LV_KEY_ESC;
-                break;
-            case 0x09: // TAB
-                act_key = LV_KEY_NEXT;  // Navigate to next widget in group
-                break;
-            case 0xC1: // Caps Lock
-                printf("WARN: CapLock key not mapped\n");
-                act_key = 0;
-                break;
-            case 0xD4: // DEL
-                act_key = LV_KEY_DEL;
-                break;
-            case 0x08: // Backspace
-                act_key = LV_KEY_BACKSPACE;
-                break;
-
-            // Row 2 Layer2
-            case 0xD0: // brk
-                printf("WARN: Brk key not mapped\n");
-                act_key = 0;
-                break;
-            case 0xD2: // Home
-                act_key = LV_KEY_HOME;
-                break;
-            case 0xD5: // End
-                act_key = LV_KEY_END;
-                break;
-
-            // Row 3
-            case 0x60: case 0x2F: case 0x5C: case 0x2D: case 0x3D:
-            case 0x5B: case 0x5D: // `/\-=[] Keys
-                act_key = r;
-                break;
-
-            // Row 3 Layer2
-            case 0x7E: act_key = '~'; break;
-            case 0x3F: act_key = '?'; break;
-            case 0x7C: act_key = '|'; break;
-            case 0x5F: act_key = '_'; break;
-            case 0x2B: act_key = '+'; break;
-            case 0x7B: act_key = '{'; break;
-            case 0x7D: act_key = '}'; break;
-
-            // Row 4
-            case 0x30: case 0x31: case 0x32: case 0x33: case 0x34:
-            case 0x35: case 0x36: case 0x37: case 0x38: case 0x39: // 0-9 Keys
-                act_key = r;
-                break;
-
-            // Row 4 Layer2
-            case 0x21: case 0x40: case 0x23: case 0x24: case 0x25:
-            case 0x5E: case 0x26: case 0x2A: case 0x28: case 0x29: // !@#$%^&*() Keys
-                act_key = r;
-                break;
-
-            // Row 5 Layer2
-            case 0xD1: // Insert
-                printf("WARN: Insert key not mapped\n");
-                act_key = 0;
-                break;
-
-            // Row 7 Layer 2
-            case 0x3C: act_key = '<'; break;
-            case 0x3E: act_key = '>'; break;
-
-            // Row 8
-            case 0x3B: case 0x27: case 0x3A: case 0x22: // ;:'"" Keys
-                act_key = r;
-                break;
-            case 0xA5: // CTL
-                printf("WARN: CTL key not mapped\n");
-                act_key = 0;
-                break;
-            case 0x20: // SPACE
-                act_key = r;
-                break;
-            case 0x0D: // Enter/Return
-                act_key = LV_KEY_ENTER;
-                break;
-            case 0xA1: // ALT
-                printf("WARN: ALT key not mapped\n");
-                act_key = 0;
-                break;
-            case 0xA2: case 0xA3: // RIGHT/LEFT SHIFT
-                break;
-
-            default:
-                act_key = r;
-                break;
+        uint32_t act_key;
+
+        if(ev.state == I2C_KBD_PRESSED && ev.code == KEY_TRACE_OVERLAY)
+        {
+            latency_trace_toggle_overlay();
+            continue;
+        }
+
+        if(ev.state == I2C_KBD_PRESSED && ev.code == KEY_TRACE_DUMP)
+        {
+            trace_dump();
+            continue;
+        }
+
+        if(ev.state == I2C_KBD_PRESSED && ev.code == KEY_PROFILER)
+        {
+            profiler_toggle();
+            continue;
         }
 
-        data->state = LV_INDEV_STATE_PRESSED;
+        if(ev.state == I2C_KBD_PRESSED && ev.code == KEY_PERF_OVERLAY)
+        {
+            perf_overlay_toggle();
+            continue;
+        }
+
+        if(ev.state == I2C_KBD_PRESSED)
+        {
+            trace_counter(TRACE_KEY_EVENT, ev.code);
+            act_key = keypad_translate(ev.code);
+            pressed_as[ev.key] = act_key;
+        }
+        else if(ev.state == I2C_KBD_RELEASED)
+        {
+            act_key = pressed_as[ev.key];
+            pressed_as[ev.key] = 0;
+        }
+        else
+        {
+            continue;   /* Hold: LVGL does its own long press and repeat */
+        }
+
+        if(act_key == 0)
+        {
+            continue;   /* Unmapped key */
+        }
+
+        uint32_t latency = time_us_32() - ev.time_us;
+        key_stats.events++;
+        key_stats.latency_us += latency;
+        if(latency > key_stats.latency_max_us) key_stats.latency_max_us = latency;
+        if(++batch > key_stats.batch_max) key_stats.batch_max = batch;
+
+        if(ev.state == I2C_KBD_PRESSED)
+        {
+            latency_trace_key(ev.time_us);
+        }
+
+        data->state = (ev.state == I2C_KBD_PRESSED) ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
         data->key = act_key;
         last_key = act_key;
-        pending_release = true;
-    } 
-    else 
-    {
-        data->state = LV_INDEV_STATE_RELEASED;
-        data->key = 0;
+        data->continue_reading = i2c_kbd_has_event();
+        return;
     }
+
+    batch = 0;
+    key_latency_report();
 }
 
-static int keypad_get_key(void)
-{   
-    int key_code = read_i2c_kbd();
-    if (key_code < 0) 
+/* Print and reset the latency window */
+static void key_latency_report(void)
+{
+    uint32_t now = time_us_32();
+    if(now - key_stats.window_start_us < KEY_LATENCY_REPORT_INTERVAL_MS * 1000u)
     {
-        return 0;
+        return;
     }
-    
-    return key_code;
+
+    if(key_stats.events > 0)
+    {
+        kbd_scan_stats_t scan;
+        i2c_kbd_get_scan_stats(&scan);
+        LOG_I("Keys: %lu events, latency avg %lu max %lu us, burst max %lu (scanner: %lu dropped, %lu bus errors)\n",
+              (unsigned long)key_stats.events,
+              (unsigned long)(key_stats.latency_us / key_stats.events),
+              (unsigned long)key_stats.latency_max_us,
+              (unsigned long)key_stats.batch_max,
+              (unsigned long)scan.dropped, (unsigned long)scan.bus_errors);
+    }
+    key_stats = (key_latency_stats_t){0};
+    key_stats.window_start_us = now;
+}
+
+/* Translate a keyboard key code to an LVGL key; 0 if it isn't mapped */
+static uint32_t keypad_translate(int r)
+{
+    uint32_t act_key = 0;
+
+    /* Translate the keys to LVGL control characters according to your key definitions */
+    switch (r) {
+        case 0xb5: // Arrow Up
+            act_key = LV_KEY_UP;
+            break;
+        case 0xb6: // Arrow Down
+            act_key = LV_KEY_DOWN;
+            break;
+        case 0xb4: // Arrow Left
+            act_key = LV_KEY_LEFT;
+            break;
+        case 0xb7: // Arrow Right
+            act_key = LV_KEY_RIGHT;
+            break;
+
+        // Special Keys
+        // Row 1
+        case 0x82: case 0x83: case 0x84: case 0x85:
+        case 0x86: case 0x87:// F2-F7 Keys (F1, F8-F10 are handled in keypad_read)
+            LOG_W("WARN: Function keys not mapped\n");
+            act_key = 0;
+            break;
+
+        // Row 2
+        case 0xB1: // ESC
+            act_key = LV_KEY_ESC;
+            break;
+        case 0x09: // TAB
+            act_key = LV_KEY_NEXT;  // Navigate to next widget in group
+            break;
+        case 0xC1: // Caps Lock
+            LOG_W("WARN: CapLock key not mapped\n");
+            act_key = 0;
+            break;
+        case 0xD4: // DEL
+            act_key = LV_KEY_DEL;
+            break;
+        case 0x08: // Backspace
+            act_key = LV_KEY_BACKSPACE;
+            break;
+
+        // Row 2 Layer2
+        case 0xD0: // brk
+            LOG_W("WARN: Brk key not mapped\n");
+            act_key = 0;
+            break;
+        case 0xD2: // Home
+            act_key = LV_KEY_HOME;
+            break;
+        case 0xD5: // End
+            act_key = LV_KEY_END;
+            break;
+
+        // Row 3
+        case 0x60: case 0x2F: case 0x5C: case 0x2D: case 0x3D:
+        case 0x5B: case 0x5D: // `/\-=[] Keys
+            act_key = r;
+            break;
+
+        // Row 3 Layer2
+        case 0x7E: act_key = '~'; break;
+        case 0x3F: act_key = '?'; break;
+        case 0x7C: act_key = '|'; break;
+        case 0x5F: act_key = '_'; break;
+        case 0x2B: act_key = '+'; break;
+        case 0x7B: act_key = '{'; break;
+        case 0x7D: act_key = '}'; break;
+
+        // Row 4
+        case 0x30: case 0x31: case 0x32: case 0x33: case 0x34:
+        case 0x35: case 0x36: case 0x37: case 0x38: case 0x39: // 0-9 Keys
+            act_key = r;
+            break;
+
+        // Row 4 Layer2
+        case 0x21: case 0x40: case 0x23: case 0x24: case 0x25:
+        case 0x5E: case 0x26: case 0x2A: case 0x28: case 0x29: // !@#$%^&*() Keys
+            act_key = r;
+            break;
+
+        // Row 5 Layer2
+        case 0xD1: // Insert
+            LOG_W("WARN: Insert key not mapped\n");
+            act_key = 0;
+            break;
+
+        // Row 7 Layer 2
+        case 0x3C: act_key = '<'; break;
+        case 0x3E: act_key = '>'; break;
+
+        // Row 8
+        case 0x3B: case 0x27: case 0x3A: case 0x22: // ;:'"" Keys
+            act_key = r;
+            break;
+        case 0xA5: // CTL
+            LOG_W("WARN: CTL key not mapped\n");
+            act_key = 0;
+            break;
+        case 0x20: // SPACE
+            act_key = r;
+            break;
+        case 0x0D: // Enter/Return
+            act_key = LV_KEY_ENTER;
+            break;
+        case 0xA1: // ALT
+            LOG_W("WARN: ALT key not mapped\n");
+            act_key = 0;
+            break;
+        case 0xA2: case 0xA3: // RIGHT/LEFT SHIFT
+            break;
+
+        default:
+            act_key = r;
+            break;
+    }
+
+    return act_key;
 }
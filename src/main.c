@@ -16,11 +16,25 @@
 #include "lvgl.h"
 #include "lv_port_indev_picocalc_kb.h"
 #include "lv_port_disp_picocalc_ILI9488.h"
+#include "lv_port_draw_core1.h"
 #include "wifi_config.h"
 #include "ble_config.h"
 #include "ui_screens.h"
 #include "ntp_client.h"
 #include "psram_helper.h"
+#include "sha256_engine.h"
+#include "event_bus.h"
+#include "job_queue.h"
+#include "blend_rgb565.h"
+#include "latency_trace.h"
+#include "trace.h"
+#include "log.h"
+#include "profiler.h"
+#include "console.h"
+#include "net_capture.h"
+#include "runtime_stats.h"
+#include "stall_detect.h"
+#include "bench.h"
 
 const unsigned int LEDPIN = 25;
 
@@ -28,7 +42,7 @@ const unsigned int LEDPIN = 25;
 static void sps_data_received(const uint8_t *data, uint16_t length)
 {
     // Note: This runs on Core1, need to be careful with shared data
-    printf("Received %d bytes via SPS: %.*s\n", length, length, data);
+    LOG_I("Received %d bytes via SPS: %.*s\n", length, length, data);
 
     // TODO: Add to RX textarea in SPS data screen
     // For now, just print to console
@@ -39,11 +53,36 @@ int main(void)
     // Initialize standard I/O
     stdio_init_all();
 
+    // Deferred logging for the callbacks and the main loop
+    log_init();
+
     // Initialize PSRAM early (before any large allocations)
     if (!psram_init()) {
         printf("WARNING: PSRAM initialization failed!\n");
     }
 
+    // Hot-path trace rings and profiler samples live in PSRAM;
+    // response capture allocates its buffers on "cap on"
+    trace_init();
+    profiler_init();
+    net_capture_init();
+    bench_init();
+
+    // Watch for a blocked main loop from here on (boot-time connects included)
+    stall_detect_init();
+
+    // Bring up the SHA-256 accelerator
+    sha256_engine_setup();
+
+    // Check the RGB565 blend kernels before LVGL draws anything
+    blend565_setup();
+
+    // Network modules post to the event bus from lwIP callbacks
+    event_bus_init();
+
+    // UART stats commands (subscribes to the bus for the HTTP counters)
+    runtime_stats_init();
+
     // Initialize LED
     gpio_init(LEDPIN);
     gpio_set_dir(LEDPIN, GPIO_OUT);
@@ -65,16 +104,23 @@ int main(void)
     // Initialize the keyboard input device (implementation in lv_port_indev_kbd.c)
     lv_port_indev_init();
 
+    // Trace key-to-photon latency (F10 toggles the overlay)
+    latency_trace_init();
+
     printf("system boot\n");
 
-    // Initialize BLE on Core1
+    // Initialize BLE on Core1 (core1 then serves the job queue)
     printf("Launching BLE on Core1...\n");
+    job_queue_init();
     ble_init();
     ble_sps_set_data_callback(sps_data_received);
     multicore_launch_core1(ble_core1_entry);
     sleep_ms(100);  // Give Core1 time to initialize
     printf("Core1 launched\n");
 
+    // Let LVGL render part of each frame on core1
+    lv_port_draw_core1_init();
+
     // Initialize UI context
     static ui_context_t ui_ctx;
     ui_init(&ui_ctx);
@@ -133,6 +179,9 @@ int main(void)
 
     while (1)
     {
+        uint64_t loop_start = time_us_64();
+        uint64_t task_start = loop_start;
+
         // Handle state machine
         switch (ui_ctx.current_state) 
         {
@@ -140,16 +189,16 @@ int main(void)
                 // Check if we need to start a new scan
                 if (ui_ctx.scan_requested) 
                 {
-                    printf("Starting WiFi scan (scan_requested=true)...\n");
+                    LOG_I("Starting WiFi scan (scan_requested=true)...\n");
                     ui_ctx.scan_requested = false;
                     if (!wifi_start_scan(&ui_ctx.scan_state)) 
                     {
-                        printf("ERROR: wifi_start_scan failed\n");
+                        LOG_E("ERROR: wifi_start_scan failed\n");
                         show_error_message(&ui_ctx, ERROR_SCAN_FAILED);
                     } 
                     else 
                     {
-                        printf("Scan started successfully, waiting for results...\n");
+                        LOG_I("Scan started successfully, waiting for results...\n");
                         scan_start_time = get_absolute_time();
                     }
                 }
@@ -164,7 +213,7 @@ int main(void)
                     // Check for timeout (30 seconds)
                     if (absolute_time_diff_us(scan_start_time, get_absolute_time()) > 30000000) 
                     {
-                        printf("WiFi scan timeout\n");
+                        LOG_W("WiFi scan timeout\n");
                         ui_ctx.scan_state.scan_error = true;
                         show_error_message(&ui_ctx, ERROR_SCAN_FAILED);
                         break;
@@ -175,9 +224,9 @@ int main(void)
                     {
                         // Scan complete, sort results and update UI
                         ui_ctx.scan_state.scan_complete = true;
-                        printf("WiFi scan complete, found %d networks\n", ui_ctx.scan_state.count);
+                        LOG_I("WiFi scan complete, found %d networks\n", ui_ctx.scan_state.count);
                         wifi_sort_scan_results(&ui_ctx.scan_state);
-                        printf("Updating screen with scan results...\n");
+                        LOG_I("Updating screen with scan results...\n");
                         transition_to_state(&ui_ctx, APP_STATE_WIFI_SCAN);
                     }
                 }
@@ -194,28 +243,28 @@ int main(void)
 
                     if (connected) 
                     {
-                        printf("WiFi connected successfully\n");
+                        LOG_I("WiFi connected successfully\n");
 
                         // Save configuration to flash
                         if (wifi_config_save(&ui_ctx.config))
                         {
-                            printf("WiFi config saved to flash\n");
+                            LOG_I("WiFi config saved to flash\n");
                         }
                         else
                         {
-                            printf("Warning: Could not save WiFi config\n");
+                            LOG_W("Warning: Could not save WiFi config\n");
                         }
 
                         // Initialize and sync time from NTP server
                         ntp_client_init();
                         ntp_client_request();
-                        printf("NTP time sync requested\n");
+                        LOG_I("NTP time sync requested\n");
 
                         transition_to_state(&ui_ctx, APP_STATE_MAIN_APP);
                     } 
                     else 
                     {
-                        printf("WiFi connection failed\n");
+                        LOG_E("WiFi connection failed\n");
                         show_error_message(&ui_ctx, ERROR_CONNECTION_FAILED);
                     }
                 }
@@ -234,7 +283,7 @@ int main(void)
                     // Only report if connection was lost (not if never connected)
                     if (was_connected && !is_connected)
                     {
-                        printf("WiFi connection lost\n");
+                        LOG_W("WiFi connection lost\n");
                         // Could implement auto-reconnect here
                     }
 
@@ -252,19 +301,19 @@ int main(void)
                     // Check if we need to start a new BLE scan
                     if (ui_ctx.ble_scan_requested)
                     {
-                        printf("Starting BLE scan (ble_scan_requested=true)...\n");
+                        LOG_I("Starting BLE scan (ble_scan_requested=true)...\n");
                         ui_ctx.ble_scan_requested = false;
                         last_device_count = 0;
                         scan_timeout_shown = false;
 
                         if (!ble_start_scan())
                         {
-                            printf("ERROR: ble_start_scan failed\n");
+                            LOG_E("ERROR: ble_start_scan failed\n");
                             show_error_message(&ui_ctx, ERROR_BLE_SCAN_FAILED);
                         }
                         else
                         {
-                            printf("BLE scan started successfully\n");
+                            LOG_I("BLE scan started successfully\n");
                             ble_scan_start_time = get_absolute_time();
                         }
                     }
@@ -280,7 +329,7 @@ int main(void)
                         {
                             last_device_count = ui_ctx.ble_scan_state.count;
                             ble_sort_scan_results(&ui_ctx.ble_scan_state);
-                            printf("Found %d BLE devices so far...\n", last_device_count);
+                            LOG_I("Found %d BLE devices so far...\n", last_device_count);
 
                             // Mark as incomplete so UI shows "Scanning..." with device list
                             ui_ctx.ble_scan_state.scan_complete = false;
@@ -290,12 +339,12 @@ int main(void)
                         // Check for timeout (30 seconds)
                         if (absolute_time_diff_us(ble_scan_start_time, get_absolute_time()) > 30000000)
                         {
-                            printf("BLE scan timeout reached\n");
+                            LOG_W("BLE scan timeout reached\n");
                             ble_stop_scan();
                             ble_get_scan_results(&ui_ctx.ble_scan_state);
                             ble_sort_scan_results(&ui_ctx.ble_scan_state);
                             ui_ctx.ble_scan_state.scan_complete = true;
-                            printf("BLE scan complete, found %d devices total\n", ui_ctx.ble_scan_state.count);
+                            LOG_I("BLE scan complete, found %d devices total\n", ui_ctx.ble_scan_state.count);
                             transition_to_state(&ui_ctx, APP_STATE_BLE_SCAN);
                             scan_timeout_shown = true;
                         }
@@ -306,7 +355,7 @@ int main(void)
                         ble_get_scan_results(&ui_ctx.ble_scan_state);
                         ble_sort_scan_results(&ui_ctx.ble_scan_state);
                         ui_ctx.ble_scan_state.scan_complete = true;
-                        printf("BLE scan stopped, found %d devices\n", ui_ctx.ble_scan_state.count);
+                        LOG_I("BLE scan stopped, found %d devices\n", ui_ctx.ble_scan_state.count);
                         transition_to_state(&ui_ctx, APP_STATE_BLE_SCAN);
                     }
                 }
@@ -320,7 +369,7 @@ int main(void)
 
                     if (connected)
                     {
-                        printf("BLE connection initiated\n");
+                        LOG_I("BLE connection initiated\n");
 
                         // Wait for connection to complete (with timeout)
                         int timeout = 100;  // 10 seconds
@@ -331,7 +380,7 @@ int main(void)
 
                         if (ble_is_connected())
                         {
-                            printf("BLE connected successfully\n");
+                            LOG_I("BLE connected successfully\n");
 
                             // Wait for SPS service discovery
                             timeout = 100;  // 10 seconds
@@ -342,24 +391,24 @@ int main(void)
 
                             if (ble_is_sps_ready())
                             {
-                                printf("SPS service ready\n");
+                                LOG_I("SPS service ready\n");
                                 transition_to_state(&ui_ctx, APP_STATE_SPS_DATA);
                             }
                             else
                             {
-                                printf("SPS service not found\n");
+                                LOG_W("SPS service not found\n");
                                 show_error_message(&ui_ctx, ERROR_BLE_NO_SPS_SERVICE);
                             }
                         }
                         else
                         {
-                            printf("BLE connection timeout\n");
+                            LOG_W("BLE connection timeout\n");
                             show_error_message(&ui_ctx, ERROR_BLE_CONNECTION_FAILED);
                         }
                     }
                     else
                     {
-                        printf("BLE connection failed\n");
+                        LOG_E("BLE connection failed\n");
                         show_error_message(&ui_ctx, ERROR_BLE_CONNECTION_FAILED);
                     }
                 }
@@ -370,7 +419,7 @@ int main(void)
                 // Just monitor connection status
                 if (!ble_is_connected())
                 {
-                    printf("BLE connection lost\n");
+                    LOG_W("BLE connection lost\n");
                     show_error_message(&ui_ctx, ERROR_BLE_CONNECTION_FAILED);
                 }
                 break;
@@ -379,8 +428,28 @@ int main(void)
                 break;
         }
 
+        task_start = runtime_stats_task_end(STATS_TASK_STATE, task_start);
+
+        // Finish offloaded jobs, deliver network events, then render what they changed this frame
+        job_queue_poll();
+        task_start = runtime_stats_task_end(STATS_TASK_JOBS, task_start);
+        event_bus_dispatch();
+        task_start = runtime_stats_task_end(STATS_TASK_EVENTS, task_start);
+
         // LVGL task handler
+        trace_begin(TRACE_LV_TIMER);
         lv_timer_handler();
+        trace_end(TRACE_LV_TIMER);
+        stall_detect_kick();
+        task_start = runtime_stats_task_end(STATS_TASK_LVGL, task_start);
+        job_queue_core0_busy((uint32_t)(task_start - loop_start));
+
+        // Write queued log messages while the UART FIFO has room
+        log_drain();
+        console_poll();
+        runtime_stats_poll();
+        task_start = runtime_stats_task_end(STATS_TASK_CONSOLE, task_start);
+        runtime_stats_loop((uint32_t)(task_start - loop_start));
         lv_tick_inc(5); // Increment LVGL tick by 5 milliseconds
         sleep_ms(5); // Sleep for 5 milliseconds
     }
@@ -0,0 +1,230 @@
+#include "net_capture.h"
+#include "console.h"
+#include "psram_helper.h"
+#include "wifi_config.h"
+#include "news_api.h"
+#include "weather_api.h"
+#include "telegram_api.h"
+#include "trace.h"
+#include "log.h"
+#include "pico/stdlib.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// One captured response
+typedef struct {
+    char *data;             // PSRAM, allocated when capture is first enabled
+    uint32_t size;
+    uint32_t len;           // Bytes kept
+    uint32_t received;      // Bytes seen, including any that did not fit
+    uint32_t segments;      // Receive callbacks that delivered data
+    volatile bool open;     // Between begin and end
+} net_capture_t;
+
+static const char *const g_source_names[EVENT_SOURCE_COUNT] = {"news", "weather", "telegram"};
+static const uint32_t g_source_sizes[EVENT_SOURCE_COUNT] = {
+    NET_CAPTURE_NEWS_SIZE, NET_CAPTURE_WEATHER_SIZE, NET_CAPTURE_TELEGRAM_SIZE
+};
+
+static net_capture_t g_captures[EVENT_SOURCE_COUNT];
+static char *g_replay_buffer = NULL;    // Reassembly target, sized for the largest source
+static volatile bool g_enabled = false;
+
+static void net_capture_command(int argc, char **argv);
+
+void net_capture_init(void)
+{
+    console_register("cap", net_capture_command,
+                     "cap on | cap off | cap list | cap dump <src> | cap replay <src> [seg]");
+}
+
+// Allocate the capture and replay buffers the first time capture is enabled
+static bool capture_alloc(void)
+{
+    if (g_replay_buffer != NULL) {
+        return true;
+    }
+    for (int i = 0; i < EVENT_SOURCE_COUNT; i++) {
+        if (g_captures[i].data == NULL) {
+            g_captures[i].data = (char *)psram_malloc(g_source_sizes[i]);
+            if (g_captures[i].data == NULL) {
+                return false;
+            }
+            g_captures[i].size = g_source_sizes[i];
+        }
+    }
+    g_replay_buffer = (char *)psram_malloc(NET_CAPTURE_NEWS_SIZE + 1);
+    return g_replay_buffer != NULL;
+}
+
+void net_capture_begin(event_source_t source)
+{
+    if (!g_enabled) {
+        return;
+    }
+    net_capture_t *cap = &g_captures[source];
+    cap->len = 0;
+    cap->received = 0;
+    cap->segments = 0;
+    cap->open = true;
+}
+
+void net_capture_append(event_source_t source, const void *data, size_t len)
+{
+    net_capture_t *cap = &g_captures[source];
+    if (!cap->open || len == 0) {
+        return;
+    }
+
+    uint32_t n = cap->size - cap->len;
+    if (n > len) {
+        n = (uint32_t)len;
+    }
+    memcpy(cap->data + cap->len, data, n);
+    cap->len += n;
+    cap->received += (uint32_t)len;
+    cap->segments++;
+}
+
+void net_capture_end(event_source_t source)
+{
+    net_capture_t *cap = &g_captures[source];
+    if (!cap->open) {
+        return;
+    }
+    cap->open = false;
+    LOG_I("Capture: %s response, %lu bytes in %lu segments\n", g_source_names[source],
+          (unsigned long)cap->len, (unsigned long)cap->segments);
+}
+
+// Run the source's parser on the JSON body of a reassembled response
+static int parse_response(event_source_t source, const char *response)
+{
+    const char *body = strstr(response, "\r\n\r\n");
+    if (body == NULL) {
+        return 0;
+    }
+    body += 4;
+
+    switch (source) {
+        case EVENT_SOURCE_NEWS:
+            return news_api_parse_fixture(body);
+        case EVENT_SOURCE_WEATHER:
+            return weather_api_parse_fixture(body);
+        case EVENT_SOURCE_TELEGRAM:
+            return telegram_api_parse_fixture(body);
+        default:
+            return 0;
+    }
+}
+
+// Reassemble the capture in segments (0 = random sizes), parse it and report.
+// Returns the item count.
+static int replay_pass(event_source_t source, uint32_t segment, uint32_t *crc)
+{
+    const net_capture_t *cap = &g_captures[source];
+    uint32_t seed = 0x2545F491;   // Fixed, so random runs repeat
+    uint32_t segments = 0;
+
+    for (uint32_t off = 0; off < cap->len; segments++) {
+        uint32_t n = segment;
+        if (n == 0) {
+            seed = seed * 1664525u + 1013904223u;
+            n = 1 + (seed >> 8) % NET_CAPTURE_MAX_SEGMENT;
+        }
+        if (n > cap->len - off) {
+            n = cap->len - off;
+        }
+        memcpy(g_replay_buffer + off, cap->data + off, n);
+        off += n;
+    }
+    g_replay_buffer[cap->len] = '\0';
+    *crc = calculate_crc32((const uint8_t *)g_replay_buffer, cap->len);
+
+    uint64_t t0 = time_us_64();
+    int items = parse_response(source, g_replay_buffer);
+    uint64_t parse_us = time_us_64() - t0;
+
+    printf("CAPTURE %s bytes=%lu segments=%lu items=%d crc=%08lx parse_us=%lu\n",
+           g_source_names[source], (unsigned long)cap->len, (unsigned long)segments, items,
+           (unsigned long)*crc, (unsigned long)parse_us);
+    return items;
+}
+
+int net_capture_replay(event_source_t source, uint32_t segment)
+{
+    const net_capture_t *cap = &g_captures[source];
+    if (g_replay_buffer == NULL || cap->open || cap->len == 0) {
+        return -1;
+    }
+
+    log_flush();
+    uint32_t whole_crc, segmented_crc;
+    int whole = replay_pass(source, cap->len, &whole_crc);
+    int segmented = replay_pass(source, segment, &segmented_crc);
+    bool match = whole == segmented && whole_crc == segmented_crc;
+    printf("CAPTURE %s %s\n", g_source_names[source], match ? "match" : "MISMATCH");
+    return segmented;
+}
+
+// Dump format: magic, version, source, bytes received, bytes kept, then the bytes
+static void capture_dump(event_source_t source)
+{
+    const net_capture_t *cap = &g_captures[source];
+    uint32_t header[5] = {NET_CAPTURE_MAGIC, NET_CAPTURE_VERSION, (uint32_t)source,
+                          cap->received, cap->len};
+
+    log_flush();
+    trace_hex_begin("CAPT");
+    trace_hex_write(header, sizeof(header));
+    trace_hex_write(cap->data, cap->len);
+    trace_hex_end();
+}
+
+// Source named on the command line, EVENT_SOURCE_COUNT if unknown
+static event_source_t source_from_name(const char *name)
+{
+    for (int i = 0; i < EVENT_SOURCE_COUNT; i++) {
+        if (name != NULL && strcmp(name, g_source_names[i]) == 0) {
+            return (event_source_t)i;
+        }
+    }
+    return EVENT_SOURCE_COUNT;
+}
+
+// Console command: cap on | off | list | dump <src> | replay <src> [seg]
+static void net_capture_command(int argc, char **argv)
+{
+    const char *action = argc > 1 ? argv[1] : "";
+    event_source_t source = source_from_name(argc > 2 ? argv[2] : NULL);
+
+    if (strcmp(action, "on") == 0) {
+        if (!capture_alloc()) {
+            LOG_E("Capture: no PSRAM for the capture buffers\n");
+            return;
+        }
+        g_enabled = true;
+        LOG_I("Capture: on\n");
+    } else if (strcmp(action, "off") == 0) {
+        g_enabled = false;
+        LOG_I("Capture: off\n");
+    } else if (strcmp(action, "list") == 0) {
+        log_flush();
+        for (int i = 0; i < EVENT_SOURCE_COUNT; i++) {
+            const net_capture_t *cap = &g_captures[i];
+            printf("  %-8s %6lu bytes (%lu received) in %lu segments%s\n", g_source_names[i],
+                   (unsigned long)cap->len, (unsigned long)cap->received,
+                   (unsigned long)cap->segments, cap->open ? ", in progress" : "");
+        }
+    } else if (strcmp(action, "dump") == 0 && source != EVENT_SOURCE_COUNT) {
+        capture_dump(source);
+    } else if (strcmp(action, "replay") == 0 && source != EVENT_SOURCE_COUNT) {
+        uint32_t segment = argc > 3 ? (uint32_t)strtoul(argv[3], NULL, 10) : 0;
+        if (net_capture_replay(source, segment) < 0) {
+            LOG_W("Capture: no complete %s response to replay\n", g_source_names[source]);
+        }
+    } else {
+        LOG_W("Capture: usage: cap on | off | list | dump <src> | replay <src> [seg]\n");
+    }
+}
@@ -3,6 +3,12 @@
 #include "lwip/dns.h"
 #include "lwip/pbuf.h"
 #include "lwip/tcp.h"
+#include "event_bus.h"
+#include "job_queue.h"
+#include "psram_helper.h"
+#include "trace.h"
+#include "net_capture.h"
+#include "log.h"
 #include <string.h>
 #include <stdio.h>
 
@@ -15,15 +21,56 @@ static news_data_t g_news_data = {0};
 static struct tcp_pcb *g_tcp_pcb = NULL;
 static ip_addr_t g_server_ip;
 static char g_request_buffer[512];
-static char g_response_buffer[8192];
-static uint16_t g_response_len = 0;
+static char *g_response_buffer = NULL;  // PSRAM, NEWS_RESPONSE_BUFFER_SIZE bytes
+static uint32_t g_response_len = 0;
+
+// Article store bank: fixed-size records plus the string arena they point into
+typedef struct {
+    news_article_t *records;
+    char *text;
+    uint32_t text_used;
+    uint16_t count;
+} news_bank_t;
+
+static news_bank_t g_banks[2];
+static uint8_t g_back_bank = 0;  // Bank the next response is parsed into
+
+// Outcome of the parse job (core1), published by news_parse_done() (core0)
+typedef struct {
+    bool ok;
+    char error_message[128];
+} news_parse_result_t;
+
+static news_parse_result_t g_parse_result;
 
 // Forward declarations
 static err_t tcp_client_connected(void *arg, struct tcp_pcb *tpcb, err_t err);
 static err_t tcp_client_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err);
 static void tcp_client_err(void *arg, err_t err);
 static void news_dns_found(const char *name, const ip_addr_t *ipaddr, void *arg);
-static void parse_news_response(const char *response, uint16_t len);
+static bool parse_news_response(const char *response, uint32_t len);
+static void parse_news_articles(news_bank_t *bank, const char *json_start);
+static void news_parse_job(void *arg);
+static void news_parse_done(void *arg);
+
+// Set the fetch state and post the matching event for the UI
+static void news_set_state(news_fetch_state_t state)
+{
+    g_news_data.state = state;
+    switch (state) {
+        case NEWS_STATE_FETCHING:
+            event_bus_post(EVENT_SOURCE_NEWS, EVENT_FETCH_STARTED, state);
+            break;
+        case NEWS_STATE_SUCCESS:
+            event_bus_post(EVENT_SOURCE_NEWS, EVENT_FETCH_COMPLETED, state);
+            break;
+        case NEWS_STATE_ERROR:
+            event_bus_post(EVENT_SOURCE_NEWS, EVENT_FETCH_ERROR, state);
+            break;
+        default:
+            break;
+    }
+}
 
 // Initialize news API
 void news_api_init(void)
@@ -32,11 +79,105 @@ void news_api_init(void)
     g_news_data.state = NEWS_STATE_IDLE;
 }
 
+// Allocate the response buffer and both store banks in PSRAM (once).
+// psram_malloc() cannot free, so they are carved from one block and a
+// failed allocation leaves nothing behind.
+static bool news_store_alloc(void)
+{
+    if (g_response_buffer != NULL) {
+        return true;
+    }
+
+    const size_t records_size = MAX_NEWS_ARTICLES * sizeof(news_article_t);
+    const size_t total = NEWS_RESPONSE_BUFFER_SIZE + 2 * (records_size + NEWS_TEXT_ARENA_SIZE);
+    uint8_t *block = (uint8_t *)psram_malloc(total);
+    if (block == NULL) {
+        return false;
+    }
+
+    uint8_t *p = block + NEWS_RESPONSE_BUFFER_SIZE;
+    for (int i = 0; i < 2; i++) {
+        g_banks[i].records = (news_article_t *)p;
+        p += records_size;
+        g_banks[i].text = (char *)p;
+        p += NEWS_TEXT_ARENA_SIZE;
+        g_banks[i].text[0] = '\0';
+        g_banks[i].text_used = 1;  // Offset 0 is the shared empty string
+        g_banks[i].count = 0;
+    }
+
+    g_response_buffer = (char *)block;
+    LOG_I("News store allocated in PSRAM: %d KB\n", (int)(total / 1024));
+    return true;
+}
+
+// Find the closing quote of a JSON string, skipping escaped characters
+static const char *json_string_end(const char *p)
+{
+    while (*p != '\0') {
+        if (*p == '\\' && *(p + 1) != '\0') {
+            p += 2;
+        } else if (*p == '"') {
+            return p;
+        } else {
+            p++;
+        }
+    }
+    return NULL;
+}
+
+// Append raw bytes to the bank's arena (keeps room for a terminator)
+static bool arena_append(news_bank_t *bank, const char *src, size_t len)
+{
+    if (bank->text_used + len + 1 > NEWS_TEXT_ARENA_SIZE) {
+        return false;
+    }
+    memcpy(bank->text + bank->text_used, src, len);
+    bank->text_used += len;
+    return true;
+}
+
+// Append a JSON string body, unescaping it on the way in.
+// Returns the number of characters written, or -1 if the arena is full.
+static int arena_append_json(news_bank_t *bank, const char *start, const char *end, size_t max_len)
+{
+    int written = 0;
+    const char *p = start;
+
+    while (p < end && (size_t)written < max_len) {
+        char c = *p++;
+        if (c == '\\' && p < end) {
+            char next = *p;
+            if (next == 'n') {
+                // Newlines read better as spaces in list rows
+                c = ' ';
+                p++;
+            } else if (next == '"' || next == '\\' || next == '/') {
+                c = next;
+                p++;
+            }
+            // Unknown escapes keep the backslash
+        }
+        if (!arena_append(bank, &c, 1)) {
+            return -1;
+        }
+        written++;
+    }
+    return written;
+}
+
+// Terminate the string currently being appended
+static void arena_end_string(news_bank_t *bank)
+{
+    // arena_append always leaves room for this byte
+    bank->text[bank->text_used++] = '\0';
+}
+
 // DNS callback
 static void news_dns_found(const char *name, const ip_addr_t *ipaddr, void *arg)
 {
     if (ipaddr != NULL) {
-        printf("DNS resolved: %s\n", ipaddr_ntoa(ipaddr));
+        LOG_I("DNS resolved: %s\n", ipaddr_ntoa(ipaddr));
         g_server_ip = *ipaddr;
 
         // Create TCP connection
@@ -46,22 +187,22 @@ static void news_dns_found(const char *name, const ip_addr_t *ipaddr, void *arg)
             tcp_err(g_tcp_pcb, tcp_client_err);
             err_t err = tcp_connect(g_tcp_pcb, &g_server_ip, 80, tcp_client_connected);
             if (err != ERR_OK) {
-                printf("TCP connect failed: %d\n", err);
-                g_news_data.state = NEWS_STATE_ERROR;
+                LOG_W("TCP connect failed: %d\n", err);
+                news_set_state(NEWS_STATE_ERROR);
                 snprintf(g_news_data.error_message, sizeof(g_news_data.error_message),
                          "Connection failed");
                 tcp_close(g_tcp_pcb);
                 g_tcp_pcb = NULL;
             }
         } else {
-            printf("Failed to create TCP PCB\n");
-            g_news_data.state = NEWS_STATE_ERROR;
+            LOG_W("Failed to create TCP PCB\n");
+            news_set_state(NEWS_STATE_ERROR);
             snprintf(g_news_data.error_message, sizeof(g_news_data.error_message),
                      "Failed to create connection");
         }
     } else {
-        printf("DNS lookup failed for %s\n", name);
-        g_news_data.state = NEWS_STATE_ERROR;
+        LOG_W("DNS lookup failed for %s\n", name);
+        news_set_state(NEWS_STATE_ERROR);
         snprintf(g_news_data.error_message, sizeof(g_news_data.error_message),
                  "DNS lookup failed");
     }
@@ -71,14 +212,14 @@ static void news_dns_found(const char *name, const ip_addr_t *ipaddr, void *arg)
 static err_t tcp_client_connected(void *arg, struct tcp_pcb *tpcb, err_t err)
 {
     if (err != ERR_OK) {
-        printf("Connection failed: %d\n", err);
-        g_news_data.state = NEWS_STATE_ERROR;
+        LOG_W("Connection failed: %d\n", err);
+        news_set_state(NEWS_STATE_ERROR);
         snprintf(g_news_data.error_message, sizeof(g_news_data.error_message),
                  "Connection error");
         return err;
     }
 
-    printf("Connected to NewsAPI server\n");
+    LOG_I("Connected to NewsAPI server\n");
 
     // Set up receive callback
     tcp_recv(tpcb, tcp_client_recv);
@@ -86,15 +227,15 @@ static err_t tcp_client_connected(void *arg, struct tcp_pcb *tpcb, err_t err)
     // Send HTTP GET request
     err_t write_err = tcp_write(tpcb, g_request_buffer, strlen(g_request_buffer), TCP_WRITE_FLAG_COPY);
     if (write_err != ERR_OK) {
-        printf("TCP write failed: %d\n", write_err);
-        g_news_data.state = NEWS_STATE_ERROR;
+        LOG_W("TCP write failed: %d\n", write_err);
+        news_set_state(NEWS_STATE_ERROR);
         snprintf(g_news_data.error_message, sizeof(g_news_data.error_message),
                  "Failed to send request");
         return write_err;
     }
 
     tcp_output(tpcb);
-    printf("HTTP request sent\n");
+    LOG_I("HTTP request sent\n");
 
     return ERR_OK;
 }
@@ -104,36 +245,43 @@ static err_t tcp_client_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, er
 {
     if (p == NULL) {
         // Connection closed by server
-        printf("Connection closed by server\n");
+        LOG_I("Connection closed by server\n");
         tcp_close(tpcb);
         g_tcp_pcb = NULL;
+        net_capture_end(EVENT_SOURCE_NEWS);
 
-        // Parse the response
+        // Parse the response on core1; the state stays FETCHING until the
+        // result is published, so no new fetch can reuse the buffer meanwhile
         if (g_response_len > 0) {
-            parse_news_response(g_response_buffer, g_response_len);
+            if (!job_queue_submit("news parse", news_parse_job, news_parse_done, NULL)) {
+                news_parse_job(NULL);
+                news_parse_done(NULL);
+            }
         }
 
         return ERR_OK;
     }
 
     if (err != ERR_OK) {
-        printf("Receive error: %d\n", err);
+        LOG_W("Receive error: %d\n", err);
         pbuf_free(p);
-        g_news_data.state = NEWS_STATE_ERROR;
+        news_set_state(NEWS_STATE_ERROR);
         snprintf(g_news_data.error_message, sizeof(g_news_data.error_message),
                  "Receive error");
         return err;
     }
 
     // Copy data to response buffer
-    uint16_t copy_len = p->tot_len;
-    if (g_response_len + copy_len > sizeof(g_response_buffer) - 1) {
-        copy_len = sizeof(g_response_buffer) - 1 - g_response_len;
+    uint32_t copy_len = p->tot_len;
+    if (g_response_len + copy_len > NEWS_RESPONSE_BUFFER_SIZE - 1) {
+        copy_len = NEWS_RESPONSE_BUFFER_SIZE - 1 - g_response_len;
     }
 
     pbuf_copy_partial(p, g_response_buffer + g_response_len, copy_len, 0);
+    net_capture_append(EVENT_SOURCE_NEWS, g_response_buffer + g_response_len, copy_len);
     g_response_len += copy_len;
     g_response_buffer[g_response_len] = '\0';
+    event_bus_post_progress(EVENT_SOURCE_NEWS, g_news_data.state, g_response_len);
 
     // Tell lwIP we've processed the data
     tcp_recved(tpcb, p->tot_len);
@@ -146,258 +294,239 @@ static err_t tcp_client_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, er
 // TCP error callback
 static void tcp_client_err(void *arg, err_t err)
 {
-    printf("TCP error: %d\n", err);
-    g_news_data.state = NEWS_STATE_ERROR;
+    LOG_W("TCP error: %d\n", err);
+    news_set_state(NEWS_STATE_ERROR);
     snprintf(g_news_data.error_message, sizeof(g_news_data.error_message),
              "Network error");
     g_tcp_pcb = NULL;
+    net_capture_end(EVENT_SOURCE_NEWS);
 }
 
-// Simple JSON parser for news articles
-static void parse_news_response(const char *response, uint16_t len)
+// Job: parse the response into the back bank (core1, or inline if the
+// queue is unavailable). Nothing the UI reads is touched here.
+static void news_parse_job(void *arg)
 {
-    printf("Parsing response (%d bytes)\n", len);
+    trace_begin(TRACE_JSON_PARSE);
+    g_parse_result.ok = parse_news_response(g_response_buffer, g_response_len);
+    trace_end(TRACE_JSON_PARSE);
+}
 
-    // Find the JSON body (skip HTTP headers)
-    const char *json_start = strstr(response, "\r\n\r\n");
-    if (json_start == NULL) {
-        printf("No JSON body found\n");
-        g_news_data.state = NEWS_STATE_ERROR;
-        snprintf(g_news_data.error_message, sizeof(g_news_data.error_message),
-                 "Invalid response");
+// Job done (core0): publish the parsed bank, or the error
+static void news_parse_done(void *arg)
+{
+    if (!g_parse_result.ok) {
+        memcpy(g_news_data.error_message, g_parse_result.error_message,
+               sizeof(g_news_data.error_message));
+        news_set_state(NEWS_STATE_ERROR);
         return;
     }
-    json_start += 4; // Skip past "\r\n\r\n"
 
-    // Check for error in response
-    if (strstr(json_start, "\"status\":\"error\"") != NULL) {
-        printf("API returned error status\n");
-        g_news_data.state = NEWS_STATE_ERROR;
+    // Publish the bank and switch to the other one for the next fetch
+    news_bank_t *bank = &g_banks[g_back_bank];
+    g_news_data.articles = bank->records;
+    g_news_data.text = bank->text;
+    g_news_data.count = bank->count;
+    g_back_bank ^= 1;
+    news_set_state(NEWS_STATE_SUCCESS);
+}
 
-        // Try to extract error message
-        const char *msg_start = strstr(json_start, "\"message\":\"");
-        if (msg_start != NULL) {
-            msg_start += 11;
-            const char *msg_end = strchr(msg_start, '"');
-            if (msg_end != NULL) {
-                int msg_len = msg_end - msg_start;
-                if (msg_len > 127) msg_len = 127;
-                strncpy(g_news_data.error_message, msg_start, msg_len);
-                g_news_data.error_message[msg_len] = '\0';
-            }
-        } else {
-            snprintf(g_news_data.error_message, sizeof(g_news_data.error_message),
-                     "API error");
-        }
-        return;
-    }
+// Parse the article list of a JSON body into bank
+static void parse_news_articles(news_bank_t *bank, const char *json_start)
+{
+    bank->count = 0;
+    bank->text_used = 1;
 
     // Parse articles (simple parser - looks for title fields)
-    g_news_data.count = 0;
     const char *search_pos = json_start;
 
-    while (g_news_data.count < MAX_NEWS_ARTICLES) {
+    while (bank->count < MAX_NEWS_ARTICLES) {
         // Find next "title" field
         search_pos = strstr(search_pos, "\"title\":\"");
         if (search_pos == NULL) break;
 
         search_pos += 9; // Skip past "title":"
 
-        // Find the end of the title string, handling escaped quotes
-        const char *title_end = search_pos;
-        while (*title_end != '\0') {
-            if (*title_end == '\\' && *(title_end + 1) != '\0') {
-                // Skip escaped character
-                title_end += 2;
-            } else if (*title_end == '"') {
-                // Found unescaped closing quote
-                break;
-            } else {
-                title_end++;
-            }
-        }
-        if (*title_end != '"') break;
-
-        // Copy title
-        int title_len = title_end - search_pos;
-        if (title_len > NEWS_TITLE_MAX_LEN) title_len = NEWS_TITLE_MAX_LEN;
-        strncpy(g_news_data.articles[g_news_data.count].title, search_pos, title_len);
-        g_news_data.articles[g_news_data.count].title[title_len] = '\0';
-
-        // Clean up escaped characters in title
-        int write_pos = 0;
-        for (int read_pos = 0; read_pos < title_len; read_pos++) {
-            if (g_news_data.articles[g_news_data.count].title[read_pos] == '\\' &&
-                read_pos + 1 < title_len) {
-                char next = g_news_data.articles[g_news_data.count].title[read_pos + 1];
-                if (next == '"' || next == '\\' || next == '/') {
-                    // Skip the backslash, keep the escaped character
-                    g_news_data.articles[g_news_data.count].title[write_pos++] = next;
-                    read_pos++; // Skip the escaped char
-                } else {
-                    g_news_data.articles[g_news_data.count].title[write_pos++] =
-                        g_news_data.articles[g_news_data.count].title[read_pos];
-                }
-            } else {
-                g_news_data.articles[g_news_data.count].title[write_pos++] =
-                    g_news_data.articles[g_news_data.count].title[read_pos];
-            }
-        }
-        g_news_data.articles[g_news_data.count].title[write_pos] = '\0';
+        const char *title_end = json_string_end(search_pos);
+        if (title_end == NULL) break;
+
+        news_article_t *article = &bank->records[bank->count];
+        memset(article, 0, sizeof(*article));
+        uint32_t rollback = bank->text_used;
+        bool fits = true;
+        int n;
 
         // Try to find source name (look backwards from title for source object)
         const char *source_search = search_pos - 200;
         if (source_search < json_start) source_search = json_start;
-        const char *source_start = strstr(source_search, "\"name\":\"");
-        if (source_start != NULL && source_start < search_pos) {
+        // Use the last "name" before the title so we don't pick up the previous article's
+        const char *source_start = NULL;
+        const char *name_pos = strstr(source_search, "\"name\":\"");
+        while (name_pos != NULL && name_pos < search_pos) {
+            source_start = name_pos;
+            name_pos = strstr(name_pos + 1, "\"name\":\"");
+        }
+        if (source_start != NULL) {
             source_start += 8;
-
-            // Find the end of the source string, handling escaped quotes
-            const char *source_end = source_start;
-            while (*source_end != '\0') {
-                if (*source_end == '\\' && *(source_end + 1) != '\0') {
-                    source_end += 2;
-                } else if (*source_end == '"') {
-                    break;
+            const char *source_end = json_string_end(source_start);
+            if (source_end != NULL) {
+                article->source = bank->text_used;
+                n = arena_append_json(bank, source_start, source_end, NEWS_SOURCE_MAX_LEN);
+                if (n < 0) {
+                    fits = false;
                 } else {
-                    source_end++;
+                    article->source_len = n;
+                    arena_end_string(bank);
                 }
             }
+        }
 
-            if (*source_end == '"') {
-                int source_len = source_end - source_start;
-                if (source_len > NEWS_SOURCE_MAX_LEN) source_len = NEWS_SOURCE_MAX_LEN;
-                strncpy(g_news_data.articles[g_news_data.count].source, source_start, source_len);
-                g_news_data.articles[g_news_data.count].source[source_len] = '\0';
-
-                // Clean up escaped characters in source
-                int write_pos = 0;
-                for (int read_pos = 0; read_pos < source_len; read_pos++) {
-                    if (g_news_data.articles[g_news_data.count].source[read_pos] == '\\' &&
-                        read_pos + 1 < source_len) {
-                        char next = g_news_data.articles[g_news_data.count].source[read_pos + 1];
-                        if (next == '"' || next == '\\' || next == '/') {
-                            // Skip the backslash, keep the escaped character
-                            g_news_data.articles[g_news_data.count].source[write_pos++] = next;
-                            read_pos++; // Skip the escaped char
-                        } else {
-                            g_news_data.articles[g_news_data.count].source[write_pos++] =
-                                g_news_data.articles[g_news_data.count].source[read_pos];
-                        }
-                    } else {
-                        g_news_data.articles[g_news_data.count].source[write_pos++] =
-                            g_news_data.articles[g_news_data.count].source[read_pos];
-                    }
-                }
-                g_news_data.articles[g_news_data.count].source[write_pos] = '\0';
+        // Headline for the list row: "[source]\ntitle", title points inside it
+        article->headline = bank->text_used;
+        if (fits && article->source_len > 0) {
+            fits = arena_append(bank, "[", 1) &&
+                   arena_append(bank, bank->text + article->source, article->source_len) &&
+                   arena_append(bank, "]\n", 2);
+        }
+        if (fits) {
+            article->title = bank->text_used;
+            n = arena_append_json(bank, search_pos, title_end, NEWS_TITLE_MAX_LEN);
+            if (n < 0) {
+                fits = false;
+            } else {
+                article->title_len = n;
+                arena_end_string(bank);
             }
         }
 
         // Try to find description (look forward from title)
         const char *desc_start = strstr(title_end, "\"description\":\"");
-        if (desc_start != NULL && desc_start < title_end + 1000) {
+        if (fits && desc_start != NULL && desc_start < title_end + 1000) {
             desc_start += 15; // Skip past "description":"
-
-            // Find the end of the description string, handling escaped quotes
-            const char *desc_end = desc_start;
-            while (*desc_end != '\0') {
-                if (*desc_end == '\\' && *(desc_end + 1) != '\0') {
-                    // Skip escaped character (e.g., \", \\, \n)
-                    desc_end += 2;
-                } else if (*desc_end == '"') {
-                    // Found unescaped closing quote
-                    break;
+            const char *desc_end = json_string_end(desc_start);
+            if (desc_end != NULL) {
+                article->description = bank->text_used;
+                n = arena_append_json(bank, desc_start, desc_end, NEWS_DESCRIPTION_MAX_LEN);
+                if (n < 0) {
+                    fits = false;
                 } else {
-                    desc_end++;
+                    article->description_len = n;
+                    arena_end_string(bank);
                 }
             }
+        }
 
-            if (*desc_end == '"') {
-                int desc_len = desc_end - desc_start;
-                if (desc_len > NEWS_DESCRIPTION_MAX_LEN) desc_len = NEWS_DESCRIPTION_MAX_LEN;
-                strncpy(g_news_data.articles[g_news_data.count].description, desc_start, desc_len);
-                g_news_data.articles[g_news_data.count].description[desc_len] = '\0';
-
-                // Replace escaped sequences for better display
-                int write_pos = 0;
-                for (int read_pos = 0; read_pos < desc_len; read_pos++) {
-                    if (g_news_data.articles[g_news_data.count].description[read_pos] == '\\' &&
-                        read_pos + 1 < desc_len) {
-                        char next = g_news_data.articles[g_news_data.count].description[read_pos + 1];
-                        if (next == 'n') {
-                            // Replace \n with space
-                            g_news_data.articles[g_news_data.count].description[write_pos++] = ' ';
-                            read_pos++; // Skip the 'n'
-                        } else if (next == '"' || next == '\\' || next == '/') {
-                            // Skip the backslash, keep the escaped character
-                            g_news_data.articles[g_news_data.count].description[write_pos++] = next;
-                            read_pos++; // Skip the escaped char
-                        } else {
-                            // Keep the backslash for unknown escapes
-                            g_news_data.articles[g_news_data.count].description[write_pos++] =
-                                g_news_data.articles[g_news_data.count].description[read_pos];
-                        }
-                    } else {
-                        g_news_data.articles[g_news_data.count].description[write_pos++] =
-                            g_news_data.articles[g_news_data.count].description[read_pos];
-                    }
-                }
-                g_news_data.articles[g_news_data.count].description[write_pos] = '\0';
-            }
+        if (!fits) {
+            // Drop the partial article and keep what we have
+            bank->text_used = rollback;
+            LOG_W("News text arena full after %d articles\n", bank->count);
+            break;
         }
 
-        g_news_data.count++;
+        bank->count++;
         search_pos = title_end + 1;
     }
+}
 
-    printf("Parsed %d articles\n", g_news_data.count);
+// Simple JSON parser for news articles; parses into the back bank and
+// leaves the error in g_parse_result
+static bool parse_news_response(const char *response, uint32_t len)
+{
+    LOG_I("Parsing response (%d bytes)\n", (int)len);
 
-    if (g_news_data.count > 0) {
-        g_news_data.state = NEWS_STATE_SUCCESS;
-    } else {
-        g_news_data.state = NEWS_STATE_ERROR;
-        snprintf(g_news_data.error_message, sizeof(g_news_data.error_message),
+    // Find the JSON body (skip HTTP headers)
+    const char *json_start = strstr(response, "\r\n\r\n");
+    if (json_start == NULL) {
+        LOG_W("No JSON body found\n");
+        snprintf(g_parse_result.error_message, sizeof(g_parse_result.error_message),
+                 "Invalid response");
+        return false;
+    }
+    json_start += 4; // Skip past "\r\n\r\n"
+
+    // Check for error in response
+    if (strstr(json_start, "\"status\":\"error\"") != NULL) {
+        LOG_W("API returned error status\n");
+
+        // Try to extract error message
+        const char *msg_start = strstr(json_start, "\"message\":\"");
+        if (msg_start != NULL) {
+            msg_start += 11;
+            const char *msg_end = strchr(msg_start, '"');
+            if (msg_end != NULL) {
+                int msg_len = msg_end - msg_start;
+                if (msg_len > 127) msg_len = 127;
+                strncpy(g_parse_result.error_message, msg_start, msg_len);
+                g_parse_result.error_message[msg_len] = '\0';
+            }
+        } else {
+            snprintf(g_parse_result.error_message, sizeof(g_parse_result.error_message),
+                     "API error");
+        }
+        return false;
+    }
+
+    // Parse into the idle bank; the published one may still be bound to labels
+    news_bank_t *bank = &g_banks[g_back_bank];
+    parse_news_articles(bank, json_start);
+
+    LOG_I("Parsed %d articles (%d/%d bytes of text)\n",
+           bank->count, (int)bank->text_used, NEWS_TEXT_ARENA_SIZE);
+
+    if (bank->count == 0) {
+        snprintf(g_parse_result.error_message, sizeof(g_parse_result.error_message),
                  "No articles found");
+        return false;
     }
+    return true;
 }
 
 // Fetch top headlines
 void news_api_fetch_headlines(const char *api_key, const char *country)
 {
     if (g_news_data.state == NEWS_STATE_FETCHING) {
-        printf("Already fetching news\n");
+        LOG_I("Already fetching news\n");
         return;
     }
 
-    printf("Fetching news headlines for country: %s\n", country);
+    LOG_I("Fetching news headlines for country: %s\n", country);
+
+    // Response buffer and article store live in PSRAM
+    if (!news_store_alloc()) {
+        LOG_W("Failed to allocate news store from PSRAM\n");
+        news_set_state(NEWS_STATE_ERROR);
+        snprintf(g_news_data.error_message, sizeof(g_news_data.error_message),
+                 "PSRAM allocation failed");
+        return;
+    }
 
     // Reset state
-    g_news_data.state = NEWS_STATE_FETCHING;
+    news_set_state(NEWS_STATE_FETCHING);
     g_news_data.count = 0;
     g_response_len = 0;
-    memset(g_response_buffer, 0, sizeof(g_response_buffer));
+    g_response_buffer[0] = '\0';
+    net_capture_begin(EVENT_SOURCE_NEWS);
 
     // Build HTTP request
     snprintf(g_request_buffer, sizeof(g_request_buffer),
-             "GET /v2/top-headlines?country=%s&pageSize=20&apiKey=%s HTTP/1.1\r\n"
+             "GET /v2/top-headlines?country=%s&pageSize=%d&apiKey=%s HTTP/1.1\r\n"
              "Host: newsapi.org\r\n"
              "Connection: close\r\n"
              "User-Agent: PicoCalc-Omnitool\r\n"
              "\r\n",
-             country, api_key);
+             country, NEWS_PAGE_SIZE, api_key);
 
-    printf("Request: %s\n", g_request_buffer);
+    LOG_I("Request: %s\n", g_request_buffer);
 
     // Start DNS lookup
     err_t err = dns_gethostbyname(NEWS_API_HOST, &g_server_ip, news_dns_found, NULL);
 
     if (err == ERR_OK) {
         // DNS already cached, connect immediately
-        printf("DNS cached, connecting immediately\n");
+        LOG_I("DNS cached, connecting immediately\n");
         news_dns_found(NEWS_API_HOST, &g_server_ip, NULL);
     } else if (err != ERR_INPROGRESS) {
-        printf("DNS lookup failed: %d\n", err);
-        g_news_data.state = NEWS_STATE_ERROR;
+        LOG_W("DNS lookup failed: %d\n", err);
+        news_set_state(NEWS_STATE_ERROR);
         snprintf(g_news_data.error_message, sizeof(g_news_data.error_message),
                  "DNS lookup failed");
     }
@@ -414,3 +543,23 @@ news_fetch_state_t news_api_get_state(void)
 {
     return g_news_data.state;
 }
+
+// Parse a JSON body into a scratch bank (benchmarks); the published data is untouched
+int news_api_parse_fixture(const char *json)
+{
+    static news_bank_t scratch;
+
+    if (scratch.records == NULL) {
+        const size_t records_size = MAX_NEWS_ARTICLES * sizeof(news_article_t);
+        uint8_t *block = (uint8_t *)psram_malloc(records_size + NEWS_TEXT_ARENA_SIZE);
+        if (block == NULL) {
+            return -1;
+        }
+        scratch.records = (news_article_t *)block;
+        scratch.text = (char *)(block + records_size);
+        scratch.text[0] = '\0';
+    }
+
+    parse_news_articles(&scratch, json);
+    return scratch.count;
+}
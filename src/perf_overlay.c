@@ -0,0 +1,82 @@
+#include "perf_overlay.h"
+#include "runtime_stats.h"
+#include "psram_helper.h"
+#include "ui_theme.h"
+#include "lvgl.h"
+#include <stdio.h>
+
+static lv_obj_t *g_overlay = NULL;
+static lv_timer_t *g_overlay_timer = NULL;
+static runtime_stats_snapshot_t g_mark;     // Totals at the start of the period
+
+// Refresh the text with the period that just ended
+static void overlay_timer_cb(lv_timer_t *timer)
+{
+    (void)timer;
+    runtime_stats_snapshot_t now;
+    runtime_stats_snapshot(&now);
+
+    uint32_t window_us = (uint32_t)(now.at_us - g_mark.at_us);
+    if (window_us == 0) {
+        return;
+    }
+    uint32_t calls = now.flush_calls - g_mark.flush_calls;
+    uint32_t fps_x10 = (uint32_t)((uint64_t)(now.frames - g_mark.frames) * 10000000 / window_us);
+    uint32_t flush_avg = calls ? (uint32_t)((now.flush_us - g_mark.flush_us) / calls) : 0;
+    uint32_t flush_max = runtime_stats_take_flush_max(STATS_READER_OVERLAY);
+    uint32_t kb_per_s = (uint32_t)((now.flush_bytes - g_mark.flush_bytes) * 1000 / window_us);
+    uint32_t core0 = (uint32_t)((now.core0_busy_us - g_mark.core0_busy_us) * 100 / window_us);
+    uint32_t core1 = (uint32_t)((now.core1_busy_us - g_mark.core1_busy_us) * 100 / window_us);
+    g_mark = now;
+
+    lv_mem_monitor_t lv;
+    size_t psram_used, psram_total, sram_used, sram_total;
+    lv_mem_monitor(&lv);
+    psram_get_stats(&psram_used, &psram_total);
+    runtime_stats_get_sram(&sram_used, &sram_total);
+
+    char text[160];
+    snprintf(text, sizeof(text),
+             "fps %lu.%lu  cpu %lu/%lu%%\n"
+             "flush %lu.%lu/%lu.%lu ms %lu KB/s\n"
+             "lvgl %lu/%luK psram %luK\n"
+             "sram free %luK",
+             (unsigned long)(fps_x10 / 10), (unsigned long)(fps_x10 % 10),
+             (unsigned long)core0, (unsigned long)core1,
+             (unsigned long)(flush_avg / 1000), (unsigned long)(flush_avg % 1000 / 100),
+             (unsigned long)(flush_max / 1000), (unsigned long)(flush_max % 1000 / 100),
+             (unsigned long)kb_per_s,
+             (unsigned long)((lv.total_size - lv.free_size) / 1024),
+             (unsigned long)(lv.total_size / 1024),
+             (unsigned long)(psram_used / 1024),
+             (unsigned long)((sram_total - sram_used) / 1024));
+    lv_label_set_text(g_overlay, text);
+}
+
+// Show or hide the overlay
+void perf_overlay_toggle(void)
+{
+    if (g_overlay != NULL) {
+        lv_timer_delete(g_overlay_timer);
+        lv_obj_delete(g_overlay);
+        g_overlay_timer = NULL;
+        g_overlay = NULL;
+        return;
+    }
+
+    // Fixed size and clipped, so a text change never invalidates more than the box
+    g_overlay = lv_label_create(lv_layer_top());
+    lv_obj_set_size(g_overlay, PERF_OVERLAY_WIDTH, PERF_OVERLAY_HEIGHT);
+    lv_label_set_long_mode(g_overlay, LV_LABEL_LONG_CLIP);
+    lv_obj_set_style_text_font(g_overlay, FONT_SMALL, 0);
+    lv_obj_set_style_text_color(g_overlay, lv_color_hex(THEME_TEXT_TERTIARY), 0);
+    lv_obj_set_style_bg_color(g_overlay, lv_color_hex(THEME_BG_PRIMARY), 0);
+    lv_obj_set_style_bg_opa(g_overlay, LV_OPA_COVER, 0);
+    lv_obj_set_style_pad_all(g_overlay, 2, 0);
+    lv_obj_align(g_overlay, LV_ALIGN_TOP_RIGHT, 0, 0);
+    lv_label_set_text(g_overlay, "perf: measuring");
+
+    runtime_stats_snapshot(&g_mark);
+    runtime_stats_take_flush_max(STATS_READER_OVERLAY);
+    g_overlay_timer = lv_timer_create(overlay_timer_cb, PERF_OVERLAY_PERIOD_MS, NULL);
+}
@@ -0,0 +1,211 @@
+#include "profiler.h"
+#include "psram_helper.h"
+#include "trace.h"
+#include "log.h"
+#include "console.h"
+#include "pico/stdlib.h"
+#include "hardware/irq.h"
+#include "hardware/timer.h"
+#include "hardware/sync.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PROFILER_CORES   2
+
+// One sample. PC is a Thumb address, so bit 0 is free and holds the core.
+typedef struct {
+    uint32_t pc;
+    uint32_t lr;
+} prof_sample_t;
+
+static prof_sample_t *g_samples = NULL;
+static uint32_t g_count = 0;            // Samples taken (atomic, may pass capacity)
+static uint32_t g_dropped = 0;          // Samples lost to a full buffer
+static uint32_t g_rate_hz = PROFILER_DEFAULT_HZ;
+static uint32_t g_period_us = 1000000 / PROFILER_DEFAULT_HZ;
+static volatile bool g_running = false;
+
+static int g_alarm[PROFILER_CORES] = {-1, -1};
+static bool g_core_ready[PROFILER_CORES] = {false, false};
+
+void profiler_sample(uint32_t *frame);
+static void profiler_isr(void) __attribute__((naked));
+static void profiler_command(int argc, char **argv);
+
+// Alarm handler entry. Installed directly in the vector table, so LR holds
+// EXC_RETURN: bit 2 tells which stack the exception frame was pushed to.
+static void __not_in_flash_func(profiler_isr)(void)
+{
+    __asm volatile(
+        "tst lr, #4\n"
+        "ite eq\n"
+        "mrseq r0, msp\n"
+        "mrsne r0, psp\n"
+        "b profiler_sample\n"
+    );
+}
+
+// Record the stacked PC (frame[6]) and LR (frame[5]), then re-arm
+void __not_in_flash_func(profiler_sample)(uint32_t *frame)
+{
+    uint core = get_core_num();
+    uint alarm = (uint)g_alarm[core];
+
+    hw_clear_bits(&timer_hw->intr, 1u << alarm);
+    if (!g_running) {
+        return;
+    }
+
+    // Keep the grid of the previous target; skip ahead if we fell behind it
+    uint32_t next = timer_hw->alarm[alarm] + g_period_us;
+    if ((int32_t)(next - timer_hw->timerawl) <= 0) {
+        next = timer_hw->timerawl + g_period_us;
+    }
+    timer_hw->alarm[alarm] = next;
+
+    uint32_t i = __atomic_fetch_add(&g_count, 1, __ATOMIC_RELAXED);
+    if (i < PROFILER_MAX_SAMPLES) {
+        g_samples[i].pc = (frame[6] & ~1u) | core;
+        g_samples[i].lr = frame[5];
+    } else {
+        __atomic_fetch_add(&g_dropped, 1, __ATOMIC_RELAXED);
+    }
+}
+
+// Set up the alarm on the calling core
+void profiler_core_init(void)
+{
+    uint core = get_core_num();
+    if (g_samples == NULL || g_core_ready[core]) {
+        return;
+    }
+
+    int alarm = hardware_alarm_claim_unused(false);
+    if (alarm < 0) {
+        LOG_W("Profiler: no free timer alarm for core%u\n", core);
+        return;
+    }
+
+    // Exclusive handler goes straight into the vector table (see profiler_isr);
+    // highest priority so time spent in other IRQ handlers is sampled too
+    uint irq = hardware_alarm_get_irq_num(alarm);
+    irq_set_exclusive_handler(irq, profiler_isr);
+    irq_set_priority(irq, PICO_HIGHEST_IRQ_PRIORITY);
+    hw_set_bits(&timer_hw->inte, 1u << alarm);
+    irq_set_enabled(irq, true);   // NVIC of the calling core
+
+    g_alarm[core] = alarm;
+    g_core_ready[core] = true;
+}
+
+// Initialize
+void profiler_init(void)
+{
+    g_samples = psram_malloc(PROFILER_MAX_SAMPLES * sizeof(prof_sample_t));
+    if (g_samples == NULL) {
+        printf("Profiler: no PSRAM for the sample buffer, profiling disabled\n");
+        return;
+    }
+    profiler_core_init();
+    console_register("prof", profiler_command, "prof start [hz] | prof stop | prof dump");
+    printf("Profiler: %d samples, F8 or \"prof start [hz]\" to start\n", PROFILER_MAX_SAMPLES);
+}
+
+void profiler_start(uint32_t rate_hz)
+{
+    if (g_samples == NULL || g_running) {
+        return;
+    }
+    if (rate_hz < PROFILER_MIN_HZ) {
+        rate_hz = PROFILER_MIN_HZ;
+    } else if (rate_hz > PROFILER_MAX_HZ) {
+        rate_hz = PROFILER_MAX_HZ;
+    }
+
+    g_rate_hz = rate_hz;
+    g_period_us = 1000000 / rate_hz;
+    g_count = 0;
+    g_dropped = 0;
+    g_running = true;
+    __dmb();
+
+    // Offset core1 by half a period so the two handlers don't line up
+    uint32_t now = timer_hw->timerawl;
+    for (int core = 0; core < PROFILER_CORES; core++) {
+        if (g_core_ready[core]) {
+            timer_hw->alarm[g_alarm[core]] = now + g_period_us + core * (g_period_us / 2);
+        }
+    }
+    LOG_I("Profiler: sampling at %lu Hz per core\n", (unsigned long)rate_hz);
+}
+
+void profiler_stop(void)
+{
+    if (!g_running) {
+        return;
+    }
+    g_running = false;
+    __dmb();
+
+    for (int core = 0; core < PROFILER_CORES; core++) {
+        if (g_core_ready[core]) {
+            timer_hw->armed = 1u << g_alarm[core];   // Write 1 to disarm
+        }
+    }
+    busy_wait_us(g_period_us);   // Let a handler that was already running finish
+
+    uint32_t kept = g_count < PROFILER_MAX_SAMPLES ? g_count : PROFILER_MAX_SAMPLES;
+    LOG_I("Profiler: stopped, %lu samples (%lu dropped)\n",
+          (unsigned long)kept, (unsigned long)g_dropped);
+}
+
+bool profiler_running(void)
+{
+    return g_running;
+}
+
+void profiler_toggle(void)
+{
+    if (g_running) {
+        profiler_stop();
+        profiler_dump();
+    } else {
+        profiler_start(g_rate_hz);
+    }
+}
+
+// Dump format: magic, version, core count, rate Hz, sample count, dropped
+// count, then (pc | core, lr) pairs in the order they were taken.
+void profiler_dump(void)
+{
+    if (g_samples == NULL || g_running) {
+        return;
+    }
+    uint32_t count = g_count < PROFILER_MAX_SAMPLES ? g_count : PROFILER_MAX_SAMPLES;
+    uint32_t header[4] = {PROFILER_MAGIC, PROFILER_VERSION | (PROFILER_CORES << 16), g_rate_hz, count};
+
+    log_flush();   // Don't interleave queued log lines with the dump
+    trace_hex_begin("PROF");
+    trace_hex_write(header, sizeof(header));
+    trace_hex_write(&g_dropped, sizeof(g_dropped));
+    trace_hex_write(g_samples, count * sizeof(prof_sample_t));
+    trace_hex_end();
+}
+
+// Console command: prof start [hz] | prof stop | prof dump
+static void profiler_command(int argc, char **argv)
+{
+    const char *action = argc > 1 ? argv[1] : "";
+
+    if (strcmp(action, "start") == 0) {
+        profiler_start(argc > 2 ? (uint32_t)strtoul(argv[2], NULL, 10) : PROFILER_DEFAULT_HZ);
+    } else if (strcmp(action, "stop") == 0) {
+        profiler_stop();
+        profiler_dump();
+    } else if (strcmp(action, "dump") == 0) {
+        profiler_dump();
+    } else {
+        LOG_W("Profiler: usage: prof start [hz] | prof stop | prof dump\n");
+    }
+}
@@ -4,6 +4,8 @@
  */
 
 #include "psram_helper.h"
+#include "trace.h"
+#include "log.h"
 #include <stdio.h>
 #include <string.h>
 
@@ -47,7 +49,7 @@ bool psram_init(void)
 void* psram_malloc(size_t size)
 {
     if (!g_psram_alloc.initialized) {
-        printf("ERROR: PSRAM not initialized!\n");
+        LOG_E("ERROR: PSRAM not initialized!\n");
         return NULL;
     }
 
@@ -55,8 +57,8 @@ void* psram_malloc(size_t size)
     size = (size + 3) & ~3;
 
     if (size > g_psram_alloc.remaining) {
-        printf("ERROR: PSRAM allocation failed - requested %zu bytes, only %zu available\n",
-               size, g_psram_alloc.remaining);
+        LOG_E("ERROR: PSRAM allocation failed - requested %zu bytes, only %zu available\n",
+              size, g_psram_alloc.remaining);
         return NULL;
     }
 
@@ -64,8 +66,7 @@ void* psram_malloc(size_t size)
     g_psram_alloc.current += size;
     g_psram_alloc.remaining -= size;
 
-    printf("PSRAM allocated %zu bytes at 0x%08X (remaining: %zu KB)\n",
-           size, (uintptr_t)ptr, g_psram_alloc.remaining / 1024);
+    trace_counter(TRACE_PSRAM_ALLOC, size);
 
     // Clear the allocated memory
     memset(ptr, 0, size);
@@ -0,0 +1,577 @@
+#include "runtime_stats.h"
+#include "console.h"
+#include "event_bus.h"
+#include "job_queue.h"
+#include "psram_helper.h"
+#include "wifi_config.h"
+#include "ble_config.h"
+#include "log.h"
+#include "lvgl.h"
+#include "pico/stdlib.h"
+#include "pico/cyw43_arch.h"
+#include "lwip/stats.h"
+#include <malloc.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Histogram bin upper bounds in ms; the last bin takes the rest
+static const uint32_t g_hist_bounds_ms[RUNTIME_STATS_HIST_BINS - 1] = {1, 2, 5, 10, 20, 50, 100};
+
+static const char *const g_task_names[STATS_TASK_COUNT] = {
+    "state", "jobs", "events", "lvgl", "console"
+};
+static const char *const g_source_names[EVENT_SOURCE_COUNT] = {"news", "weather", "telegram"};
+
+// Time distribution, reset when printed
+typedef struct {
+    uint32_t bins[RUNTIME_STATS_HIST_BINS];
+    uint32_t count;
+    uint32_t max_us;
+    uint64_t total_us;
+} stats_hist_t;
+
+// Counters for one HTTP source
+typedef struct {
+    uint32_t started;
+    uint32_t completed;
+    uint32_t errors;
+    uint32_t bytes;             // Response bytes of finished fetches
+    uint32_t cur_bytes;         // Latest progress of the fetch in flight
+    uint32_t last_ms;           // Duration of the last finished fetch
+    uint64_t start_us;
+} stats_http_t;
+
+// Totals when cpu was last printed
+typedef struct {
+    runtime_stats_snapshot_t snap;
+    uint64_t task_us[STATS_TASK_COUNT];
+} stats_cpu_mark_t;
+
+// Watch groups
+typedef enum {
+    GROUP_MEM,
+    GROUP_NET,
+    GROUP_LWIP,
+    GROUP_CPU,
+    GROUP_FRAME,
+    GROUP_TLS,
+    GROUP_HTTP,
+    GROUP_BLE,
+    GROUP_WIFI,
+    GROUP_ALL,
+    GROUP_COUNT
+} stats_group_t;
+
+static const char *const g_group_names[GROUP_COUNT] = {
+    "mem", "net", "lwip", "cpu", "frame", "tls", "http", "ble", "wifi", "all"
+};
+
+// Main loop and display (core0)
+static uint64_t g_task_us[STATS_TASK_COUNT];
+static uint64_t g_loop_us;
+static stats_hist_t g_loop_hist;
+static stats_hist_t g_lvgl_hist;
+static stats_cpu_mark_t g_cpu_mark;
+static runtime_stats_snapshot_t g_frame_mark;
+
+static uint32_t g_flush_calls;
+static uint32_t g_flush_frames;
+static uint64_t g_flush_bytes;
+static uint64_t g_flush_us;
+static uint32_t g_flush_max_us[STATS_READER_COUNT];
+
+// TLS handshakes (lwIP callbacks)
+static volatile uint32_t g_tls_ok;
+static volatile uint32_t g_tls_failed;
+static volatile uint32_t g_tls_last_ms;
+static volatile uint32_t g_tls_last_cpu_ms;
+static volatile uint32_t g_tls_max_ms;
+static volatile uint64_t g_tls_total_us;
+
+static stats_http_t g_http[EVENT_SOURCE_COUNT];
+
+static stats_group_t g_watch_group = GROUP_COUNT;     // GROUP_COUNT = off
+static uint32_t g_watch_ms = RUNTIME_STATS_WATCH_MS;
+static uint64_t g_watch_next_us;
+
+// Linker symbols bounding the malloc arena
+extern char __end__;
+extern char __HeapLimit;
+
+static void stats_command(int argc, char **argv);
+static void watch_command(int argc, char **argv);
+static void http_event_handler(const app_event_t *event, void *user_data);
+
+void runtime_stats_init(void)
+{
+    runtime_stats_snapshot(&g_cpu_mark.snap);
+    g_frame_mark = g_cpu_mark.snap;
+
+    for (int i = 0; i < EVENT_SOURCE_COUNT; i++) {
+        event_bus_subscribe((event_source_t)i, http_event_handler, NULL);
+    }
+    console_register("stats", stats_command, "stats [mem|net|lwip [full]|cpu|frame|tls|http|ble|wifi|all]");
+    console_register("watch", watch_command, "watch <group> [ms] | watch off");
+}
+
+// Add a sample to a histogram
+static void hist_add(stats_hist_t *hist, uint32_t us)
+{
+    int bin = 0;
+    while (bin < RUNTIME_STATS_HIST_BINS - 1 && us > g_hist_bounds_ms[bin] * 1000) {
+        bin++;
+    }
+    hist->bins[bin]++;
+    hist->count++;
+    hist->total_us += us;
+    if (us > hist->max_us) {
+        hist->max_us = us;
+    }
+}
+
+uint64_t runtime_stats_task_end(stats_task_t task, uint64_t start_us)
+{
+    uint64_t now = time_us_64();
+    uint32_t elapsed = (uint32_t)(now - start_us);
+
+    g_task_us[task] += elapsed;
+    if (task == STATS_TASK_LVGL) {
+        hist_add(&g_lvgl_hist, elapsed);
+    }
+    return now;
+}
+
+void runtime_stats_loop(uint32_t busy_us)
+{
+    g_loop_us += busy_us;
+    hist_add(&g_loop_hist, busy_us);
+}
+
+void runtime_stats_flush(uint32_t flush_us, uint32_t bytes, bool last)
+{
+    g_flush_calls++;
+    g_flush_bytes += bytes;
+    g_flush_us += flush_us;
+    for (int i = 0; i < STATS_READER_COUNT; i++) {
+        if (flush_us > g_flush_max_us[i]) {
+            g_flush_max_us[i] = flush_us;
+        }
+    }
+    if (last) {
+        g_flush_frames++;
+    }
+}
+
+void runtime_stats_snapshot(runtime_stats_snapshot_t *snap)
+{
+    snap->at_us = time_us_64();
+    snap->core0_busy_us = g_loop_us;
+    job_queue_get_totals(&snap->core1_busy_us, &snap->core1_jobs);
+    snap->frames = g_flush_frames;
+    snap->flush_calls = g_flush_calls;
+    snap->flush_us = g_flush_us;
+    snap->flush_bytes = g_flush_bytes;
+}
+
+uint32_t runtime_stats_take_flush_max(stats_reader_t reader)
+{
+    uint32_t max_us = g_flush_max_us[reader];
+    g_flush_max_us[reader] = 0;
+    return max_us;
+}
+
+void runtime_stats_tls_handshake(bool ok, uint32_t total_us, uint32_t cpu_us)
+{
+    if (!ok) {
+        g_tls_failed++;
+        return;
+    }
+    g_tls_ok++;
+    g_tls_total_us += total_us;
+    g_tls_last_ms = total_us / 1000;
+    g_tls_last_cpu_ms = cpu_us / 1000;
+    if (g_tls_last_ms > g_tls_max_ms) {
+        g_tls_max_ms = g_tls_last_ms;
+    }
+}
+
+void runtime_stats_get_sram(size_t *used, size_t *total)
+{
+    struct mallinfo info = mallinfo();
+    *used = (size_t)info.uordblks;
+    *total = (size_t)(&__HeapLimit - &__end__);
+}
+
+// Count fetches per source (main loop, event bus)
+static void http_event_handler(const app_event_t *event, void *user_data)
+{
+    (void)user_data;
+    stats_http_t *http = &g_http[event->source];
+
+    switch (event->type) {
+        case EVENT_FETCH_STARTED:
+            http->started++;
+            http->cur_bytes = 0;
+            http->start_us = time_us_64();
+            break;
+        case EVENT_FETCH_PROGRESS:
+            http->cur_bytes = event->bytes;
+            break;
+        case EVENT_FETCH_COMPLETED:
+        case EVENT_FETCH_ERROR:
+            if (event->type == EVENT_FETCH_COMPLETED) {
+                http->completed++;
+            } else {
+                http->errors++;
+            }
+            http->bytes += http->cur_bytes;
+            http->cur_bytes = 0;
+            if (http->start_us != 0) {
+                http->last_ms = (uint32_t)((time_us_64() - http->start_us) / 1000);
+                http->start_us = 0;
+            }
+            break;
+    }
+}
+
+// Print a histogram on one line and reset it
+static void hist_print(const char *name, stats_hist_t *hist)
+{
+    printf("  %-6s n=%lu avg=%lu us max=%lu us |", name, (unsigned long)hist->count,
+           (unsigned long)(hist->count ? hist->total_us / hist->count : 0),
+           (unsigned long)hist->max_us);
+    for (int i = 0; i < RUNTIME_STATS_HIST_BINS; i++) {
+        if (i < RUNTIME_STATS_HIST_BINS - 1) {
+            printf(" <=%lu:%lu", (unsigned long)g_hist_bounds_ms[i], (unsigned long)hist->bins[i]);
+        } else {
+            printf(" >%lu:%lu", (unsigned long)g_hist_bounds_ms[i - 1], (unsigned long)hist->bins[i]);
+        }
+    }
+    printf("\n");
+    memset(hist, 0, sizeof(*hist));
+}
+
+static void print_mem(bool brief)
+{
+    size_t sram_used, sram_total, psram_used, psram_total;
+    lv_mem_monitor_t lv;
+
+    runtime_stats_get_sram(&sram_used, &sram_total);
+    psram_get_stats(&psram_used, &psram_total);
+    lv_mem_monitor(&lv);
+
+    if (brief) {
+        printf("mem sram=%u/%u psram=%u/%u lvgl=%u/%u max=%u frag=%u%%\n",
+               (unsigned)sram_used, (unsigned)sram_total, (unsigned)psram_used,
+               (unsigned)psram_total, (unsigned)(lv.total_size - lv.free_size),
+               (unsigned)lv.total_size, (unsigned)lv.max_used, (unsigned)lv.frag_pct);
+        return;
+    }
+    printf("Memory:\n");
+    printf("  SRAM heap  %7u / %7u bytes\n", (unsigned)sram_used, (unsigned)sram_total);
+    printf("  PSRAM      %7u / %7u bytes (bump allocator, never freed)\n",
+           (unsigned)psram_used, (unsigned)psram_total);
+    printf("  LVGL heap  %7u / %7u bytes, peak %u, largest free %u, frag %u%%\n",
+           (unsigned)(lv.total_size - lv.free_size), (unsigned)lv.total_size,
+           (unsigned)lv.max_used, (unsigned)lv.free_biggest_size, (unsigned)lv.frag_pct);
+}
+
+static void print_lwip(bool brief)
+{
+#if LWIP_STATS && MEMP_STATS
+    if (brief) {
+        printf("lwip pbuf=%u/%u tcp_pcb=%u/%u tcp_seg=%u/%u",
+               (unsigned)lwip_stats.memp[MEMP_PBUF_POOL]->used,
+               (unsigned)lwip_stats.memp[MEMP_PBUF_POOL]->avail,
+               (unsigned)lwip_stats.memp[MEMP_TCP_PCB]->used,
+               (unsigned)lwip_stats.memp[MEMP_TCP_PCB]->avail,
+               (unsigned)lwip_stats.memp[MEMP_TCP_SEG]->used,
+               (unsigned)lwip_stats.memp[MEMP_TCP_SEG]->avail);
+#if MEM_STATS
+        printf(" heap=%u/%u", (unsigned)lwip_stats.mem.used, (unsigned)lwip_stats.mem.avail);
+#endif
+        printf("\n");
+        return;
+    }
+    printf("lwIP pools:      used   max avail  err\n");
+#if MEM_STATS
+    printf("  %-12s %5u %5u %5u %4lu\n", "HEAP", (unsigned)lwip_stats.mem.used,
+           (unsigned)lwip_stats.mem.max, (unsigned)lwip_stats.mem.avail,
+           (unsigned long)lwip_stats.mem.err);
+#endif
+    for (int i = 0; i < MEMP_MAX; i++) {
+        const struct stats_mem *pool = lwip_stats.memp[i];
+        if (pool != NULL) {
+            printf("  %-12s %5u %5u %5u %4lu\n", pool->name, (unsigned)pool->used,
+                   (unsigned)pool->max, (unsigned)pool->avail, (unsigned long)pool->err);
+        }
+    }
+#else
+    (void)brief;
+    printf("lwip: pool stats disabled (MEMP_STATS)\n");
+#endif
+}
+
+static void print_net(bool brief)
+{
+#if LWIP_STATS && TCP_STATS
+    const struct stats_proto *tcp = &lwip_stats.tcp;
+    if (brief) {
+        printf("net tcp xmit=%lu recv=%lu drop=%lu err=%lu memerr=%lu\n",
+               (unsigned long)tcp->xmit, (unsigned long)tcp->recv, (unsigned long)tcp->drop,
+               (unsigned long)tcp->err, (unsigned long)tcp->memerr);
+        return;
+    }
+    printf("TCP: xmit %lu, recv %lu, retransmit/forward %lu, drop %lu\n",
+           (unsigned long)tcp->xmit, (unsigned long)tcp->recv, (unsigned long)tcp->fw,
+           (unsigned long)tcp->drop);
+    printf("  chkerr %lu, lenerr %lu, memerr %lu, rterr %lu, proterr %lu, opterr %lu, err %lu\n",
+           (unsigned long)tcp->chkerr, (unsigned long)tcp->lenerr, (unsigned long)tcp->memerr,
+           (unsigned long)tcp->rterr, (unsigned long)tcp->proterr, (unsigned long)tcp->opterr,
+           (unsigned long)tcp->err);
+#else
+    (void)brief;
+    printf("net: TCP stats disabled (TCP_STATS)\n");
+#endif
+}
+
+static void print_cpu(bool brief)
+{
+    runtime_stats_snapshot_t now;
+    runtime_stats_snapshot(&now);
+
+    const runtime_stats_snapshot_t *mark = &g_cpu_mark.snap;
+    uint64_t window = now.at_us - mark->at_us;
+    if (window == 0) {
+        window = 1;
+    }
+    uint32_t core0_pct = (uint32_t)((now.core0_busy_us - mark->core0_busy_us) * 100 / window);
+    uint32_t core1_pct = (uint32_t)((now.core1_busy_us - mark->core1_busy_us) * 100 / window);
+    uint32_t jobs = now.core1_jobs - mark->core1_jobs;
+
+    if (brief) {
+        printf("cpu core0=%lu%% core1=%lu%% jobs=%lu", (unsigned long)core0_pct,
+               (unsigned long)core1_pct, (unsigned long)jobs);
+        for (int i = 0; i < STATS_TASK_COUNT; i++) {
+            printf(" %s=%lu", g_task_names[i],
+                   (unsigned long)((g_task_us[i] - g_cpu_mark.task_us[i]) / 1000));
+        }
+        printf(" ms\n");
+    } else {
+        printf("CPU over %lu ms: core0 main loop %lu%%, core1 jobs %lu%% (%lu jobs)\n",
+               (unsigned long)(window / 1000), (unsigned long)core0_pct,
+               (unsigned long)core1_pct, (unsigned long)jobs);
+        for (int i = 0; i < STATS_TASK_COUNT; i++) {
+            uint64_t us = g_task_us[i] - g_cpu_mark.task_us[i];
+            printf("  %-8s %8lu ms %3lu%%\n", g_task_names[i], (unsigned long)(us / 1000),
+                   (unsigned long)(us * 100 / window));
+        }
+    }
+
+    g_cpu_mark.snap = now;
+    memcpy(g_cpu_mark.task_us, g_task_us, sizeof(g_task_us));
+}
+
+static void print_frame(bool brief)
+{
+    runtime_stats_snapshot_t now;
+    runtime_stats_snapshot(&now);
+
+    uint32_t window_ms = (uint32_t)((now.at_us - g_frame_mark.at_us) / 1000);
+    if (window_ms == 0) {
+        window_ms = 1;
+    }
+    uint32_t frames = now.frames - g_frame_mark.frames;
+    uint32_t calls = now.flush_calls - g_frame_mark.flush_calls;
+    uint32_t bytes = (uint32_t)(now.flush_bytes - g_frame_mark.flush_bytes);
+    uint32_t fps_x10 = frames * 10000 / window_ms;
+    uint32_t flush_avg = calls ? (uint32_t)((now.flush_us - g_frame_mark.flush_us) / calls) : 0;
+    uint32_t flush_max = runtime_stats_take_flush_max(STATS_READER_CONSOLE);
+
+    if (brief) {
+        printf("frame fps=%lu.%lu loop_max=%lu lvgl_max=%lu flush_avg=%lu flush_max=%lu us kb/s=%lu\n",
+               (unsigned long)(fps_x10 / 10), (unsigned long)(fps_x10 % 10),
+               (unsigned long)g_loop_hist.max_us, (unsigned long)g_lvgl_hist.max_us,
+               (unsigned long)flush_avg, (unsigned long)flush_max,
+               (unsigned long)(bytes / window_ms));
+        memset(&g_loop_hist, 0, sizeof(g_loop_hist));
+        memset(&g_lvgl_hist, 0, sizeof(g_lvgl_hist));
+    } else {
+        printf("Frames over %lu ms: %lu.%lu fps, %lu flushes, %lu bytes, flush avg %lu us max %lu us\n",
+               (unsigned long)window_ms, (unsigned long)(fps_x10 / 10),
+               (unsigned long)(fps_x10 % 10), (unsigned long)calls, (unsigned long)bytes,
+               (unsigned long)flush_avg, (unsigned long)flush_max);
+        hist_print("loop", &g_loop_hist);
+        hist_print("lvgl", &g_lvgl_hist);
+    }
+
+    g_frame_mark = now;
+}
+
+static void print_tls(bool brief)
+{
+    uint32_t ok = g_tls_ok;
+    uint32_t avg = ok ? (uint32_t)(g_tls_total_us / ok / 1000) : 0;
+
+    if (brief) {
+        printf("tls ok=%lu failed=%lu last=%lu avg=%lu max=%lu ms\n", (unsigned long)ok,
+               (unsigned long)g_tls_failed, (unsigned long)g_tls_last_ms, (unsigned long)avg,
+               (unsigned long)g_tls_max_ms);
+        return;
+    }
+    printf("TLS handshakes: %lu ok, %lu failed\n", (unsigned long)ok, (unsigned long)g_tls_failed);
+    printf("  last %lu ms (%lu ms CPU), avg %lu ms, max %lu ms\n", (unsigned long)g_tls_last_ms,
+           (unsigned long)g_tls_last_cpu_ms, (unsigned long)avg, (unsigned long)g_tls_max_ms);
+}
+
+static void print_http(bool brief)
+{
+    if (brief) {
+        printf("http");
+        for (int i = 0; i < EVENT_SOURCE_COUNT; i++) {
+            printf(" %s=%lu/%lu/%lu", g_source_names[i], (unsigned long)g_http[i].completed,
+                   (unsigned long)g_http[i].errors, (unsigned long)g_http[i].started);
+        }
+        printf(" (ok/err/started)\n");
+        return;
+    }
+    printf("HTTP fetches:  started  ok  err     bytes  last ms\n");
+    for (int i = 0; i < EVENT_SOURCE_COUNT; i++) {
+        const stats_http_t *http = &g_http[i];
+        printf("  %-10s %7lu %3lu %4lu %9lu %8lu%s\n", g_source_names[i],
+               (unsigned long)http->started, (unsigned long)http->completed,
+               (unsigned long)http->errors, (unsigned long)http->bytes,
+               (unsigned long)http->last_ms, http->start_us ? " (in flight)" : "");
+    }
+}
+
+static void print_ble(bool brief)
+{
+    ble_link_stats_t ble;
+    ble_get_link_stats(&ble);
+
+    if (brief) {
+        printf("ble %s rx=%lu/%lu tx=%lu/%lu fail=%lu\n",
+               ble_is_connected() ? "up" : "down", (unsigned long)ble.rx_notifications,
+               (unsigned long)ble.rx_bytes, (unsigned long)ble.tx_writes,
+               (unsigned long)ble.tx_bytes, (unsigned long)ble.tx_failures);
+        return;
+    }
+    printf("BLE: %s, interval %u.%02u ms, %lu HCI events\n",
+           ble_is_connected() ? (ble_is_sps_ready() ? "connected, SPS ready" : "connected") : "not connected",
+           (unsigned)(ble.conn_interval * 125 / 100), (unsigned)(ble.conn_interval * 125 % 100),
+           (unsigned long)ble.hci_events);
+    printf("  %lu connects, %lu disconnects (last reason 0x%02x)\n", (unsigned long)ble.connects,
+           (unsigned long)ble.disconnects, ble.last_disconnect_reason);
+    printf("  rx %lu notifications, %lu bytes; tx %lu writes, %lu bytes, %lu failed\n",
+           (unsigned long)ble.rx_notifications, (unsigned long)ble.rx_bytes,
+           (unsigned long)ble.tx_writes, (unsigned long)ble.tx_bytes,
+           (unsigned long)ble.tx_failures);
+}
+
+static void print_wifi(bool brief)
+{
+    int32_t rssi = 0;
+    bool up = wifi_is_connected();
+
+    if (up) {
+        cyw43_arch_lwip_begin();
+        if (cyw43_wifi_get_rssi(&cyw43_state, &rssi) != 0) {
+            rssi = 0;
+        }
+        cyw43_arch_lwip_end();
+    }
+
+    if (brief) {
+        printf("wifi %s rssi=%ld\n", up ? "up" : "down", (long)rssi);
+        return;
+    }
+    if (up) {
+        printf("Wi-Fi: connected, RSSI %ld dBm\n", (long)rssi);
+    } else {
+        printf("Wi-Fi: not connected (link status %d)\n",
+               cyw43_wifi_link_status(&cyw43_state, CYW43_ITF_STA));
+    }
+}
+
+// Printers indexed by group (GROUP_ALL excluded)
+static void (*const g_printers[GROUP_ALL])(bool brief) = {
+    print_mem, print_net, print_lwip, print_cpu, print_frame,
+    print_tls, print_http, print_ble, print_wifi
+};
+
+static void print_group(stats_group_t group, bool brief)
+{
+    log_flush();
+    if (group != GROUP_ALL) {
+        g_printers[group](brief);
+        return;
+    }
+    for (int i = 0; i < GROUP_ALL; i++) {
+        g_printers[i](brief);
+    }
+}
+
+// Group named on the command line, GROUP_COUNT if unknown
+static stats_group_t group_from_name(const char *name)
+{
+    for (int i = 0; i < GROUP_COUNT; i++) {
+        if (strcmp(name, g_group_names[i]) == 0) {
+            return (stats_group_t)i;
+        }
+    }
+    return GROUP_COUNT;
+}
+
+// Console command: stats [group]
+static void stats_command(int argc, char **argv)
+{
+    stats_group_t group = group_from_name(argc > 1 ? argv[1] : "all");
+    if (group == GROUP_COUNT) {
+        LOG_W("Stats: unknown group \"%s\"\n", argv[1]);
+        return;
+    }
+#if LWIP_STATS_DISPLAY
+    if (group == GROUP_LWIP && argc > 2 && strcmp(argv[2], "full") == 0) {
+        log_flush();
+        stats_display();
+        return;
+    }
+#endif
+    print_group(group, false);
+}
+
+// Console command: watch <group> [ms] | watch off
+static void watch_command(int argc, char **argv)
+{
+    const char *name = argc > 1 ? argv[1] : "";
+
+    if (strcmp(name, "off") == 0) {
+        g_watch_group = GROUP_COUNT;
+        LOG_I("Stats: watch off\n");
+        return;
+    }
+
+    stats_group_t group = group_from_name(name);
+    if (group == GROUP_COUNT) {
+        LOG_W("Stats: usage: watch <group> [ms] | watch off\n");
+        return;
+    }
+    uint32_t ms = argc > 2 ? (uint32_t)strtoul(argv[2], NULL, 10) : RUNTIME_STATS_WATCH_MS;
+    g_watch_ms = ms < RUNTIME_STATS_MIN_WATCH_MS ? RUNTIME_STATS_MIN_WATCH_MS : ms;
+    g_watch_group = group;
+    g_watch_next_us = time_us_64();
+}
+
+void runtime_stats_poll(void)
+{
+    if (g_watch_group == GROUP_COUNT || time_us_64() < g_watch_next_us) {
+        return;
+    }
+    g_watch_next_us += (uint64_t)g_watch_ms * 1000;
+    if (g_watch_next_us < time_us_64()) {
+        g_watch_next_us = time_us_64() + (uint64_t)g_watch_ms * 1000;
+    }
+    print_group(g_watch_group, true);
+}
@@ -0,0 +1,429 @@
+#include "sha256_engine.h"
+#include "pico/stdlib.h"
+#include <string.h>
+#include <stdio.h>
+
+#if PICO_RP2350 && !defined(SHA256_ENGINE_SOFTWARE_ONLY)
+#define SHA256_ENGINE_HAS_HW 1
+#include "hardware/sha256.h"
+#include "hardware/dma.h"
+#include "hardware/sync.h"
+#else
+#define SHA256_ENGINE_HAS_HW 0
+#endif
+
+static const uint32_t g_iv256[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+static const uint32_t g_iv224[8] = {
+    0xc1059ed8, 0x367cd507, 0x3070dd17, 0xf70e5939,
+    0xffc00b31, 0x68581511, 0x64f98fa7, 0xbefa4fa4
+};
+
+static const uint32_t g_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+#if SHA256_ENGINE_HAS_HW
+static sha256_engine_ctx_t *volatile g_hw_owner = NULL;
+static spin_lock_t *g_hw_lock = NULL;
+static int g_dma_channel = -1;
+#endif
+static bool g_hw_enabled = false;
+
+// ===== Portable implementation =====
+
+#define ROTR(x, n)  (((x) >> (n)) | ((x) << (32 - (n))))
+
+static inline uint32_t load_be32(const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static inline void store_be32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+// Compress one 64-byte block into state
+static void sw_compress(uint32_t state[8], const uint8_t *block)
+{
+    uint32_t w[64];
+    for (int i = 0; i < 16; i++) {
+        w[i] = load_be32(block + i * 4);
+    }
+    for (int i = 16; i < 64; i++) {
+        uint32_t s0 = ROTR(w[i - 15], 7) ^ ROTR(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = ROTR(w[i - 2], 17) ^ ROTR(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+
+    for (int i = 0; i < 64; i++) {
+        uint32_t s1 = ROTR(e, 6) ^ ROTR(e, 11) ^ ROTR(e, 25);
+        uint32_t ch = (e & f) ^ (~e & g);
+        uint32_t t1 = h + s1 + ch + g_k[i] + w[i];
+        uint32_t s0 = ROTR(a, 2) ^ ROTR(a, 13) ^ ROTR(a, 22);
+        uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+        uint32_t t2 = s0 + maj;
+
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+// ===== Hardware block =====
+
+#if SHA256_ENGINE_HAS_HW
+
+// Try to make ctx the owner of the hardware block
+static bool hw_claim(sha256_engine_ctx_t *ctx)
+{
+    if (!g_hw_enabled || g_hw_lock == NULL) {
+        return false;
+    }
+
+    bool claimed = false;
+    uint32_t save = spin_lock_blocking(g_hw_lock);
+    if (g_hw_owner == NULL) {
+        g_hw_owner = ctx;
+        claimed = true;
+    }
+    spin_unlock(g_hw_lock, save);
+
+    if (claimed) {
+        sha256_err_not_ready_clear();
+        sha256_set_bswap(true);   // Message words are big-endian, memory is little-endian
+        sha256_set_dma_size(4);
+        sha256_start();
+    }
+    return claimed;
+}
+
+static void hw_release(sha256_engine_ctx_t *ctx)
+{
+    uint32_t save = spin_lock_blocking(g_hw_lock);
+    if (g_hw_owner == ctx) {
+        g_hw_owner = NULL;
+    }
+    spin_unlock(g_hw_lock, save);
+    ctx->hw = false;
+}
+
+// Feed whole blocks to the hardware
+static void hw_feed(const uint8_t *data, size_t blocks)
+{
+    size_t words = blocks * (SHA256_ENGINE_BLOCK_SIZE / 4);
+
+    if (g_dma_channel >= 0 && blocks >= SHA256_ENGINE_DMA_MIN_BLOCKS &&
+        ((uintptr_t)data & 3) == 0) {
+        dma_channel_config c = dma_channel_get_default_config(g_dma_channel);
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+        channel_config_set_read_increment(&c, true);
+        channel_config_set_write_increment(&c, false);
+        channel_config_set_dreq(&c, DREQ_SHA256);
+
+        dma_channel_configure(g_dma_channel, &c, sha256_get_write_addr(),
+                              data, words, true);
+        dma_channel_wait_for_finish_blocking(g_dma_channel);
+        return;
+    }
+
+    for (size_t i = 0; i < words; i++) {
+        uint32_t word;
+        memcpy(&word, data + i * 4, 4);
+        sha256_wait_ready_blocking();
+        sha256_put_word(word);
+    }
+}
+
+// Read the intermediate state after the last fed block completes
+static void hw_read_state(uint32_t state[8])
+{
+    sha256_wait_valid_blocking();
+    for (int i = 0; i < 8; i++) {
+        state[i] = sha256_hw->sum[i];
+    }
+}
+
+#endif // SHA256_ENGINE_HAS_HW
+
+// Hash whole blocks with whichever backend the context uses
+static void process_blocks(sha256_engine_ctx_t *ctx, const uint8_t *data, size_t blocks)
+{
+#if SHA256_ENGINE_HAS_HW
+    if (ctx->hw) {
+        hw_feed(data, blocks);
+        return;
+    }
+#endif
+    for (size_t i = 0; i < blocks; i++) {
+        sw_compress(ctx->state, data + i * SHA256_ENGINE_BLOCK_SIZE);
+    }
+}
+
+// ===== Context API =====
+
+// Initialize a context
+void sha256_engine_init(sha256_engine_ctx_t *ctx)
+{
+    memset(ctx, 0, sizeof(*ctx));
+}
+
+// Free a context, releasing the hardware if it owns it
+void sha256_engine_free(sha256_engine_ctx_t *ctx)
+{
+    if (ctx == NULL) {
+        return;
+    }
+#if SHA256_ENGINE_HAS_HW
+    if (ctx->hw) {
+        hw_release(ctx);
+    }
+#endif
+    memset(ctx, 0, sizeof(*ctx));
+}
+
+// Clone a context; a hardware context's copy continues in software
+void sha256_engine_clone(sha256_engine_ctx_t *dst, const sha256_engine_ctx_t *src)
+{
+#if SHA256_ENGINE_HAS_HW
+    if (dst->hw) {
+        hw_release(dst);
+    }
+#endif
+    *dst = *src;
+    dst->hw = false;
+
+#if SHA256_ENGINE_HAS_HW
+    if (src->hw) {
+        if (src->total >= SHA256_ENGINE_BLOCK_SIZE) {
+            hw_read_state(dst->state);
+        } else {
+            memcpy(dst->state, g_iv256, sizeof(dst->state));
+        }
+    }
+#endif
+}
+
+// Start a new hash
+void sha256_engine_starts(sha256_engine_ctx_t *ctx, bool is224)
+{
+#if SHA256_ENGINE_HAS_HW
+    if (ctx->hw) {
+        hw_release(ctx);
+    }
+#endif
+    memcpy(ctx->state, is224 ? g_iv224 : g_iv256, sizeof(ctx->state));
+    ctx->total = 0;
+    ctx->buffer_len = 0;
+    ctx->is224 = is224;
+    ctx->hw = false;
+
+#if SHA256_ENGINE_HAS_HW
+    // The hardware only knows the SHA-256 IV
+    if (!is224) {
+        ctx->hw = hw_claim(ctx);
+    }
+#endif
+}
+
+// Add data to the hash
+void sha256_engine_update(sha256_engine_ctx_t *ctx, const void *data, size_t len)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    ctx->total += len;
+
+    if (ctx->buffer_len > 0) {
+        size_t n = SHA256_ENGINE_BLOCK_SIZE - ctx->buffer_len;
+        if (n > len) {
+            n = len;
+        }
+        memcpy(ctx->buffer + ctx->buffer_len, p, n);
+        ctx->buffer_len += n;
+        p += n;
+        len -= n;
+
+        if (ctx->buffer_len < SHA256_ENGINE_BLOCK_SIZE) {
+            return;
+        }
+        process_blocks(ctx, ctx->buffer, 1);
+        ctx->buffer_len = 0;
+    }
+
+    size_t blocks = len / SHA256_ENGINE_BLOCK_SIZE;
+    if (blocks > 0) {
+        process_blocks(ctx, p, blocks);
+        p += blocks * SHA256_ENGINE_BLOCK_SIZE;
+        len -= blocks * SHA256_ENGINE_BLOCK_SIZE;
+    }
+
+    if (len > 0) {
+        memcpy(ctx->buffer, p, len);
+        ctx->buffer_len = len;
+    }
+}
+
+// Pad, finish and write the digest (28 bytes for SHA-224)
+void sha256_engine_finish(sha256_engine_ctx_t *ctx, uint8_t *digest)
+{
+    uint64_t bits = ctx->total * 8;
+    uint32_t used = ctx->buffer_len;
+
+    ctx->buffer[used++] = 0x80;
+    if (used > SHA256_ENGINE_BLOCK_SIZE - 8) {
+        memset(ctx->buffer + used, 0, SHA256_ENGINE_BLOCK_SIZE - used);
+        process_blocks(ctx, ctx->buffer, 1);
+        used = 0;
+    }
+    memset(ctx->buffer + used, 0, SHA256_ENGINE_BLOCK_SIZE - 8 - used);
+    store_be32(ctx->buffer + 56, (uint32_t)(bits >> 32));
+    store_be32(ctx->buffer + 60, (uint32_t)bits);
+    process_blocks(ctx, ctx->buffer, 1);
+
+#if SHA256_ENGINE_HAS_HW
+    if (ctx->hw) {
+        hw_read_state(ctx->state);
+        hw_release(ctx);
+    }
+#endif
+
+    int words = ctx->is224 ? 7 : 8;
+    for (int i = 0; i < words; i++) {
+        store_be32(digest + i * 4, ctx->state[i]);
+    }
+    ctx->buffer_len = 0;
+}
+
+// One-shot hash
+void sha256_engine_hash(const void *data, size_t len, uint8_t digest[SHA256_ENGINE_DIGEST_SIZE])
+{
+    sha256_engine_ctx_t ctx;
+    sha256_engine_init(&ctx);
+    sha256_engine_starts(&ctx, false);
+    sha256_engine_update(&ctx, data, len);
+    sha256_engine_finish(&ctx, digest);
+    sha256_engine_free(&ctx);
+}
+
+// ===== Setup and diagnostics =====
+
+bool sha256_engine_hw_available(void)
+{
+#if SHA256_ENGINE_HAS_HW
+    return g_hw_lock != NULL;
+#else
+    return false;
+#endif
+}
+
+void sha256_engine_set_hw_enabled(bool enabled)
+{
+    g_hw_enabled = enabled && sha256_engine_hw_available();
+}
+
+// Claim resources and cross-check the hardware against the portable path
+void sha256_engine_setup(void)
+{
+#if SHA256_ENGINE_HAS_HW
+    if (g_hw_lock != NULL) {
+        return;
+    }
+
+    g_hw_lock = spin_lock_instance(spin_lock_claim_unused(true));
+    g_dma_channel = dma_claim_unused_channel(false);
+    g_hw_enabled = true;
+
+    // Long enough for a DMA run, with a partial block at the end
+    static uint8_t test_data[SHA256_ENGINE_BLOCK_SIZE * 8 + 13] __attribute__((aligned(4)));
+    for (size_t i = 0; i < sizeof(test_data); i++) {
+        test_data[i] = (uint8_t)(i * 7 + 1);
+    }
+
+    uint8_t hw_digest[SHA256_ENGINE_DIGEST_SIZE];
+    uint8_t sw_digest[SHA256_ENGINE_DIGEST_SIZE];
+    sha256_engine_hash(test_data, sizeof(test_data), hw_digest);
+
+    g_hw_enabled = false;
+    sha256_engine_hash(test_data, sizeof(test_data), sw_digest);
+
+    if (memcmp(hw_digest, sw_digest, sizeof(hw_digest)) == 0) {
+        g_hw_enabled = true;
+        printf("SHA-256 hardware enabled (DMA channel %d)\n", g_dma_channel);
+    } else {
+        printf("SHA-256 hardware self-test FAILED, using software\n");
+    }
+#else
+    printf("SHA-256 using software implementation\n");
+#endif
+}
+
+// Compare hardware and software throughput
+void sha256_engine_benchmark(float *hw_mb_s, float *sw_mb_s)
+{
+    static uint8_t bench_buf[16 * 1024] __attribute__((aligned(4)));
+    const int rounds = 8;
+    uint8_t digest[SHA256_ENGINE_DIGEST_SIZE];
+    bool saved = g_hw_enabled;
+
+    for (size_t i = 0; i < sizeof(bench_buf); i++) {
+        bench_buf[i] = (uint8_t)i;
+    }
+
+    *hw_mb_s = 0.0f;
+    *sw_mb_s = 0.0f;
+    for (int pass = 0; pass < 2; pass++) {
+        bool use_hw = (pass == 0);
+        if (use_hw && !sha256_engine_hw_available()) {
+            continue;
+        }
+        sha256_engine_set_hw_enabled(use_hw);
+
+        uint64_t start = time_us_64();
+        for (int r = 0; r < rounds; r++) {
+            sha256_engine_hash(bench_buf, sizeof(bench_buf), digest);
+        }
+        uint64_t elapsed = time_us_64() - start;
+        if (elapsed == 0) {
+            elapsed = 1;
+        }
+
+        float mb_s = (float)(sizeof(bench_buf) * rounds) / (float)elapsed;   // bytes/us == MB/s
+        if (use_hw) {
+            *hw_mb_s = mb_s;
+        } else {
+            *sw_mb_s = mb_s;
+        }
+    }
+
+    g_hw_enabled = saved;
+}
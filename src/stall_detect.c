@@ -0,0 +1,219 @@
+#include "stall_detect.h"
+#include "console.h"
+#include "wifi_config.h"
+#include "log.h"
+#include "pico/stdlib.h"
+#include "hardware/irq.h"
+#include "hardware/timer.h"
+#include "hardware/watchdog.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Trace of one stall. The live copy is in uninitialised RAM, so it
+// survives the watchdog reboot that ends a hang.
+typedef struct {
+    uint32_t magic;             // STALL_DETECT_MAGIC once a hang is recorded
+    uint32_t duration_ms;
+    uint32_t sample_count;      // Samples taken (ring index = count % size)
+    uint32_t pc[STALL_DETECT_SAMPLES];
+    uint32_t lr[STALL_DETECT_SAMPLES];
+    uint32_t stack[STALL_DETECT_STACK_DEPTH];
+    uint32_t stack_depth;
+    uint32_t crc;               // Over everything above
+} stall_record_t;
+
+static stall_record_t __uninitialized_ram(g_record);
+static stall_record_t g_last;           // Last finished stall, for the console
+
+static int g_alarm = -1;
+static volatile uint32_t g_kick_us;     // timerawl at the last kick
+static volatile bool g_stalled = false; // Set by the alarm, cleared by the kick
+static volatile bool g_hung = false;    // Hard limit hit, the watchdog is no longer fed
+static uint32_t g_stall_count = 0;
+static uint32_t g_longest_ms = 0;
+
+// Linker symbols: core0's stack and the code in flash
+extern char __StackTop;
+extern char __flash_binary_start;
+extern char __flash_binary_end;
+
+void stall_detect_sample(uint32_t *frame, uint32_t exc_return);
+static void stall_isr(void) __attribute__((naked));
+static void stall_command(int argc, char **argv);
+
+// Alarm handler entry, as in profiler.c: the exception frame goes in r0
+// and EXC_RETURN in r1
+static void __not_in_flash_func(stall_isr)(void)
+{
+    __asm volatile(
+        "mov r1, lr\n"
+        "tst lr, #4\n"
+        "ite eq\n"
+        "mrseq r0, msp\n"
+        "mrsne r0, psp\n"
+        "b stall_detect_sample\n"
+    );
+}
+
+static uint32_t record_crc(const stall_record_t *rec)
+{
+    return calculate_crc32((const uint8_t *)rec, offsetof(stall_record_t, crc));
+}
+
+// Keep the Thumb return addresses found above the exception frame: the
+// blocked code's callers, plus whatever stale values look like them
+static void __not_in_flash_func(record_stack)(const uint32_t *frame, uint32_t exc_return)
+{
+    // 8 stacked words, 26 when the FP context was stacked too (EXC_RETURN bit 4 clear)
+    const uint32_t *sp = frame + ((exc_return & 0x10) ? 8 : 26);
+    const uint32_t *top = (const uint32_t *)&__StackTop;
+    uint32_t depth = 0;
+
+    for (int i = 0; i < STALL_DETECT_SCAN_WORDS && sp < top && depth < STALL_DETECT_STACK_DEPTH; i++) {
+        uint32_t v = *sp++;
+        if ((v & 1) && v >= (uint32_t)&__flash_binary_start && v < (uint32_t)&__flash_binary_end) {
+            g_record.stack[depth++] = v & ~1u;
+        }
+    }
+    g_record.stack_depth = depth;
+}
+
+// Feed the watchdog, or sample core0 while the main loop is away
+void __not_in_flash_func(stall_detect_sample)(uint32_t *frame, uint32_t exc_return)
+{
+    hw_clear_bits(&timer_hw->intr, 1u << g_alarm);
+    uint32_t now = timer_hw->timerawl;
+    timer_hw->alarm[g_alarm] = now + STALL_DETECT_SAMPLE_MS * 1000;
+
+    uint32_t away_us = now - g_kick_us;
+    if (away_us < STALL_DETECT_SOFT_MS * 1000) {
+        watchdog_update();
+        return;
+    }
+    if (g_hung) {
+        return;
+    }
+
+    if (!g_stalled) {
+        g_record.magic = 0;
+        g_record.sample_count = 0;
+        record_stack(frame, exc_return);
+        g_stalled = true;
+    }
+    uint32_t i = g_record.sample_count++ % STALL_DETECT_SAMPLES;
+    g_record.pc[i] = frame[6];
+    g_record.lr[i] = frame[5] & ~1u;
+    g_record.duration_ms = away_us / 1000;
+
+    if (away_us >= STALL_DETECT_HARD_MS * 1000u) {
+        g_record.magic = STALL_DETECT_MAGIC;
+        g_record.crc = record_crc(&g_record);
+        g_hung = true;      // The watchdog reboots within STALL_DETECT_WATCHDOG_MS
+        return;
+    }
+    watchdog_update();
+}
+
+// Print a stall: the PC seen most often, where it was called from, and
+// the return addresses on the stack when it started
+static void stall_print(const char *what, const stall_record_t *rec)
+{
+    uint32_t kept = rec->sample_count < STALL_DETECT_SAMPLES ? rec->sample_count : STALL_DETECT_SAMPLES;
+    uint32_t best = 0, best_hits = 0;
+
+    for (uint32_t i = 0; i < kept; i++) {
+        uint32_t hits = 0;
+        for (uint32_t j = 0; j < kept; j++) {
+            hits += rec->pc[j] == rec->pc[i];
+        }
+        if (hits > best_hits) {
+            best = i;
+            best_hits = hits;
+        }
+    }
+
+    log_flush();
+    printf("%s: main loop away %lu ms, %lu samples", what, (unsigned long)rec->duration_ms,
+           (unsigned long)rec->sample_count);
+    if (kept > 0) {
+        printf(", pc 0x%08lx (%lu/%lu) lr 0x%08lx", (unsigned long)rec->pc[best],
+               (unsigned long)best_hits, (unsigned long)kept, (unsigned long)rec->lr[best]);
+    }
+    printf("\n  stack:");
+    for (uint32_t i = 0; i < rec->stack_depth && i < STALL_DETECT_STACK_DEPTH; i++) {
+        printf(" 0x%08lx", (unsigned long)rec->stack[i]);
+    }
+    printf("\n");
+}
+
+void stall_detect_init(void)
+{
+    if (watchdog_enable_caused_reboot() && g_record.magic == STALL_DETECT_MAGIC &&
+        g_record.crc == record_crc(&g_record)) {
+        g_last = g_record;
+        stall_print("Stall: rebooted after a hang", &g_last);
+    }
+    memset(&g_record, 0, sizeof(g_record));
+
+    int alarm = hardware_alarm_claim_unused(false);
+    if (alarm < 0) {
+        LOG_W("Stall: no free timer alarm, detector and watchdog disabled\n");
+        return;
+    }
+    g_alarm = alarm;
+    g_kick_us = timer_hw->timerawl;
+
+    // Highest priority, so a block inside an lwIP callback is sampled too
+    uint irq = hardware_alarm_get_irq_num(alarm);
+    irq_set_exclusive_handler(irq, stall_isr);
+    irq_set_priority(irq, PICO_HIGHEST_IRQ_PRIORITY);
+    hw_set_bits(&timer_hw->inte, 1u << alarm);
+    irq_set_enabled(irq, true);
+    timer_hw->alarm[alarm] = g_kick_us + STALL_DETECT_SAMPLE_MS * 1000;
+
+    watchdog_enable(STALL_DETECT_WATCHDOG_MS, true);
+    console_register("stall", stall_command, "stall | stall test <ms>");
+}
+
+void stall_detect_kick(void)
+{
+    uint32_t now = timer_hw->timerawl;
+    uint32_t away_us = now - g_kick_us;
+    g_kick_us = now;
+
+    // The alarm leaves the record alone from here on: the kick is fresh
+    if (!g_stalled) {
+        return;
+    }
+    g_last = g_record;
+    g_last.duration_ms = away_us / 1000;
+    g_stalled = false;
+
+    g_stall_count++;
+    if (g_last.duration_ms > g_longest_ms) {
+        g_longest_ms = g_last.duration_ms;
+    }
+    stall_print("Stall", &g_last);
+}
+
+// Console command: stall | stall test <ms>
+static void stall_command(int argc, char **argv)
+{
+    if (argc > 2 && strcmp(argv[1], "test") == 0) {
+        uint32_t ms = (uint32_t)strtoul(argv[2], NULL, 10);
+        LOG_W("Stall: blocking the main loop for %lu ms\n", (unsigned long)ms);
+        log_flush();
+        busy_wait_ms(ms);
+        return;
+    }
+
+    log_flush();
+    printf("Stalls: %lu since boot, longest %lu ms (soft %d ms, hard %d ms)\n",
+           (unsigned long)g_stall_count, (unsigned long)g_longest_ms,
+           STALL_DETECT_SOFT_MS, STALL_DETECT_HARD_MS);
+    if (g_last.duration_ms > 0) {
+        stall_print("Last stall", &g_last);
+    }
+}
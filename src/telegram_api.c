@@ -3,12 +3,19 @@
 #include "lwip/dns.h"
 #include "lwip/pbuf.h"
 #include "lwip/tcp.h"
+#include "event_bus.h"
 #include "mbedtls/ssl.h"
 #include "mbedtls/entropy.h"
 #include "mbedtls/ctr_drbg.h"
 #include "mbedtls/net_sockets.h"
 #include "mbedtls/error.h"
 #include "mbedtls/debug.h"
+#include "tls_rx_queue.h"
+#include "tls_arena.h"
+#include "tls_profile.h"
+#include "net_capture.h"
+#include "psram_helper.h"
+#include "log.h"
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -21,8 +28,9 @@ static telegram_data_t g_telegram_data = {0};
 static struct tcp_pcb *g_tcp_pcb = NULL;
 static ip_addr_t g_server_ip;
 static char g_request_buffer[1024];
-static char g_response_buffer[8192];
+static char g_response_buffer[8192];  // Decrypted response
 static uint16_t g_response_len = 0;
+static tls_rx_queue_t g_rx_queue = {0};  // Ciphertext waiting for mbedTLS
 
 // mbedTLS SSL context
 static mbedtls_ssl_context g_ssl;
@@ -31,6 +39,8 @@ static mbedtls_entropy_context g_entropy;
 static mbedtls_ctr_drbg_context g_ctr_drbg;
 static bool g_ssl_initialized = false;
 static bool g_handshake_done = false;
+static tls_arena_t g_tls_arena;  // Heap for mbedTLS, released on every close
+static tls_profile_t g_tls_profile;  // Handshake timing for the current connection
 
 // Saved configuration for reconnection
 static char g_bot_token[128] = {0};
@@ -50,11 +60,33 @@ static void tcp_client_err(void *arg, err_t err);
 static void telegram_dns_found(const char *name, const ip_addr_t *ipaddr, void *arg);
 static void parse_telegram_response(const char *response, uint16_t len);
 static void parse_get_updates_response(const char *json);
+static int parse_updates(const char *json, telegram_data_t *data);
 static void parse_send_message_response(const char *json);
 static void url_encode(const char *input, char *output, size_t output_size);
 static int64_t parse_int64(const char *str);
 static int ssl_send_callback(void *ctx, const unsigned char *buf, size_t len);
-static int ssl_recv_callback(void *ctx, unsigned char *buf, size_t len);
+static void deinit_ssl(void);
+static void read_decrypted_data(void);
+
+// Set the fetch state and post the matching event for the UI
+static void telegram_set_state(telegram_api_state_t state)
+{
+    g_telegram_data.state = state;
+    switch (state) {
+        case TELEGRAM_STATE_SENDING:
+        case TELEGRAM_STATE_RECEIVING:
+            event_bus_post(EVENT_SOURCE_TELEGRAM, EVENT_FETCH_STARTED, state);
+            break;
+        case TELEGRAM_STATE_SUCCESS:
+            event_bus_post(EVENT_SOURCE_TELEGRAM, EVENT_FETCH_COMPLETED, state);
+            break;
+        case TELEGRAM_STATE_ERROR:
+            event_bus_post(EVENT_SOURCE_TELEGRAM, EVENT_FETCH_ERROR, state);
+            break;
+        default:
+            break;
+    }
+}
 
 // Forward declaration of SDK's hardware entropy function
 extern int mbedtls_hardware_poll(void *data, unsigned char *output, size_t len, size_t *olen);
@@ -66,7 +98,7 @@ void telegram_api_init(void)
     g_telegram_data.state = TELEGRAM_STATE_IDLE;
     g_telegram_data.last_update_id = 0;
     g_telegram_data.polling_active = false;
-    g_ssl_initialized = false;
+    deinit_ssl();
     g_handshake_done = false;
 }
 
@@ -79,6 +111,12 @@ static bool init_ssl(void)
 
     int ret;
 
+    // All mbedTLS allocations for this connection come from the arena
+    if (!tls_arena_init(&g_tls_arena, "telegram")) {
+        return false;
+    }
+    tls_arena_select(&g_tls_arena);     // The connected callback restores the previous one
+
     mbedtls_ssl_init(&g_ssl);
     mbedtls_ssl_config_init(&g_ssl_conf);
     mbedtls_ctr_drbg_init(&g_ctr_drbg);
@@ -88,8 +126,8 @@ static bool init_ssl(void)
     ret = mbedtls_entropy_add_source(&g_entropy, mbedtls_hardware_poll, NULL,
                                       32, MBEDTLS_ENTROPY_SOURCE_STRONG);
     if (ret != 0) {
-        printf("Failed to add entropy source: -0x%04x\n", -ret);
-        return false;
+        LOG_W("Failed to add entropy source: -0x%04x\n", -ret);
+        goto fail;
     }
 
     // Seed the random number generator using hardware entropy
@@ -97,8 +135,8 @@ static bool init_ssl(void)
     ret = mbedtls_ctr_drbg_seed(&g_ctr_drbg, mbedtls_entropy_func, &g_entropy,
                                  (const unsigned char *)pers, strlen(pers));
     if (ret != 0) {
-        printf("mbedtls_ctr_drbg_seed failed: -0x%04x\n", -ret);
-        return false;
+        LOG_W("mbedtls_ctr_drbg_seed failed: -0x%04x\n", -ret);
+        goto fail;
     }
 
     ret = mbedtls_ssl_config_defaults(&g_ssl_conf,
@@ -106,32 +144,59 @@ static bool init_ssl(void)
                                        MBEDTLS_SSL_TRANSPORT_STREAM,
                                        MBEDTLS_SSL_PRESET_DEFAULT);
     if (ret != 0) {
-        printf("mbedtls_ssl_config_defaults failed: -0x%04x\n", -ret);
-        return false;
+        LOG_W("mbedtls_ssl_config_defaults failed: -0x%04x\n", -ret);
+        goto fail;
     }
 
     // Skip certificate verification for simplicity (not recommended for production!)
     mbedtls_ssl_conf_authmode(&g_ssl_conf, MBEDTLS_SSL_VERIFY_NONE);
     mbedtls_ssl_conf_rng(&g_ssl_conf, mbedtls_ctr_drbg_random, &g_ctr_drbg);
 
+    // Offer the suites and curves that are cheapest on this core first
+    tls_profile_apply_preferences(&g_ssl_conf);
+
     ret = mbedtls_ssl_setup(&g_ssl, &g_ssl_conf);
     if (ret != 0) {
-        printf("mbedtls_ssl_setup failed: -0x%04x\n", -ret);
-        return false;
+        LOG_W("mbedtls_ssl_setup failed: -0x%04x\n", -ret);
+        goto fail;
     }
 
     ret = mbedtls_ssl_set_hostname(&g_ssl, TELEGRAM_API_HOST);
     if (ret != 0) {
-        printf("mbedtls_ssl_set_hostname failed: -0x%04x\n", -ret);
-        return false;
+        LOG_W("mbedtls_ssl_set_hostname failed: -0x%04x\n", -ret);
+        goto fail;
     }
 
     // Set custom BIO callbacks for lwIP integration
-    mbedtls_ssl_set_bio(&g_ssl, NULL, ssl_send_callback, ssl_recv_callback, NULL);
+    mbedtls_ssl_set_bio(&g_ssl, &g_rx_queue, ssl_send_callback, tls_rx_queue_bio_recv, NULL);
 
     g_ssl_initialized = true;
-    printf("SSL initialized successfully\n");
+    LOG_I("SSL initialized successfully\n");
     return true;
+
+fail:
+    // Leave nothing behind and the libc heap selected
+    mbedtls_ssl_free(&g_ssl);
+    mbedtls_ssl_config_free(&g_ssl_conf);
+    mbedtls_ctr_drbg_free(&g_ctr_drbg);
+    mbedtls_entropy_free(&g_entropy);
+    tls_arena_deinit(&g_tls_arena);
+    return false;
+}
+
+// Free SSL/TLS state and release the connection's arena in one go
+static void deinit_ssl(void)
+{
+    if (g_ssl_initialized) {
+        mbedtls_ssl_free(&g_ssl);
+        mbedtls_ssl_config_free(&g_ssl_conf);
+        mbedtls_ctr_drbg_free(&g_ctr_drbg);
+        mbedtls_entropy_free(&g_entropy);
+    }
+    tls_arena_deinit(&g_tls_arena);
+
+    g_ssl_initialized = false;
+    g_handshake_done = false;
 }
 
 // SSL send callback - writes to TCP
@@ -143,7 +208,7 @@ static int ssl_send_callback(void *ctx, const unsigned char *buf, size_t len)
 
     err_t err = tcp_write(g_tcp_pcb, buf, len, TCP_WRITE_FLAG_COPY);
     if (err != ERR_OK) {
-        printf("SSL send failed: %d\n", err);
+        LOG_W("SSL send failed: %d\n", err);
         return MBEDTLS_ERR_NET_SEND_FAILED;
     }
 
@@ -151,35 +216,59 @@ static int ssl_send_callback(void *ctx, const unsigned char *buf, size_t len)
     return len;
 }
 
-// SSL receive callback - reads from response buffer
-static int ssl_recv_callback(void *ctx, unsigned char *buf, size_t len)
+// Drain decrypted application data straight into the response buffer
+static void read_decrypted_data(void)
 {
-    if (g_response_len == 0) {
-        return MBEDTLS_ERR_SSL_WANT_READ;
-    }
+    int total_read = 0;
+    int dropped = 0;
 
-    size_t copy_len = (len < g_response_len) ? len : g_response_len;
-    memcpy(buf, g_response_buffer, copy_len);
+    while (1) {
+        size_t space = sizeof(g_response_buffer) - 1 - g_response_len;
+        int read_ret;
 
-    // Shift remaining data
-    if (copy_len < g_response_len) {
-        memmove(g_response_buffer, g_response_buffer + copy_len, g_response_len - copy_len);
+        if (space > 0) {
+            read_ret = mbedtls_ssl_read(&g_ssl, (unsigned char *)g_response_buffer + g_response_len, space);
+            if (read_ret > 0) {
+                net_capture_append(EVENT_SOURCE_TELEGRAM, g_response_buffer + g_response_len, read_ret);
+                g_response_len += read_ret;
+                g_response_buffer[g_response_len] = '\0';
+                total_read += read_ret;
+            }
+        } else {
+            // Response buffer full - keep the record layer moving but drop the plaintext
+            unsigned char discard[256];
+            read_ret = mbedtls_ssl_read(&g_ssl, discard, sizeof(discard));
+            if (read_ret > 0) {
+                net_capture_append(EVENT_SOURCE_TELEGRAM, discard, read_ret);
+                dropped += read_ret;
+            }
+        }
+
+        if (read_ret <= 0) {
+            // WANT_READ/WANT_WRITE: no complete record queued; anything else: closed or error
+            break;
+        }
     }
-    g_response_len -= copy_len;
 
-    return copy_len;
+    if (total_read > 0) {
+        LOG_I("Received %d bytes of decrypted data\n", total_read);
+        event_bus_post_progress(EVENT_SOURCE_TELEGRAM, g_telegram_data.state, g_response_len);
+    }
+    if (dropped > 0) {
+        LOG_W("Response buffer full, dropped %d bytes\n", dropped);
+    }
 }
 
 // DNS callback
 static void telegram_dns_found(const char *name, const ip_addr_t *ipaddr, void *arg)
 {
     if (ipaddr != NULL) {
-        printf("Telegram DNS resolved: %s\n", ipaddr_ntoa(ipaddr));
+        LOG_I("Telegram DNS resolved: %s\n", ipaddr_ntoa(ipaddr));
         g_server_ip = *ipaddr;
 
         // Close any existing connection first
         if (g_tcp_pcb != NULL) {
-            printf("Closing existing TCP connection\n");
+            LOG_I("Closing existing TCP connection\n");
             tcp_abort(g_tcp_pcb);
             g_tcp_pcb = NULL;
         }
@@ -191,46 +280,48 @@ static void telegram_dns_found(const char *name, const ip_addr_t *ipaddr, void *
             tcp_err(g_tcp_pcb, tcp_client_err);
             err_t err = tcp_connect(g_tcp_pcb, &g_server_ip, TELEGRAM_API_PORT, tcp_client_connected);
             if (err != ERR_OK) {
-                printf("Telegram TCP connect failed: %d\n", err);
-                g_telegram_data.state = TELEGRAM_STATE_ERROR;
+                LOG_W("Telegram TCP connect failed: %d\n", err);
+                telegram_set_state(TELEGRAM_STATE_ERROR);
                 snprintf(g_telegram_data.error_message, sizeof(g_telegram_data.error_message),
                          "Connection failed");
                 tcp_abort(g_tcp_pcb);
                 g_tcp_pcb = NULL;
             }
         } else {
-            printf("Failed to create Telegram TCP PCB (out of memory/connections)\n");
-            g_telegram_data.state = TELEGRAM_STATE_ERROR;
+            LOG_W("Failed to create Telegram TCP PCB (out of memory/connections)\n");
+            telegram_set_state(TELEGRAM_STATE_ERROR);
             snprintf(g_telegram_data.error_message, sizeof(g_telegram_data.error_message),
                      "Out of TCP connections");
         }
     } else {
-        printf("Telegram DNS lookup failed for %s\n", name);
-        g_telegram_data.state = TELEGRAM_STATE_ERROR;
+        LOG_W("Telegram DNS lookup failed for %s\n", name);
+        telegram_set_state(TELEGRAM_STATE_ERROR);
         snprintf(g_telegram_data.error_message, sizeof(g_telegram_data.error_message),
                  "DNS lookup failed");
     }
 }
 
-// TCP connected callback
-static err_t tcp_client_connected(void *arg, struct tcp_pcb *tpcb, err_t err)
+// TCP connected callback body; runs with the connection's arena selected
+static err_t client_connected(void *arg, struct tcp_pcb *tpcb, err_t err)
 {
     if (err != ERR_OK) {
-        printf("Telegram connection failed: %d\n", err);
-        g_telegram_data.state = TELEGRAM_STATE_ERROR;
+        LOG_W("Telegram connection failed: %d\n", err);
+        telegram_set_state(TELEGRAM_STATE_ERROR);
         snprintf(g_telegram_data.error_message, sizeof(g_telegram_data.error_message),
                  "Connection error");
+        deinit_ssl();
         return err;
     }
 
-    printf("Connected to Telegram server, starting TLS handshake\n");
+    LOG_I("Connected to Telegram server, starting TLS handshake\n");
 
     // Set up receive callback
     tcp_recv(tpcb, tcp_client_recv);
+    tls_rx_queue_init(&g_rx_queue, tpcb);
 
     // Initialize SSL if not already done
     if (!init_ssl()) {
-        g_telegram_data.state = TELEGRAM_STATE_ERROR;
+        telegram_set_state(TELEGRAM_STATE_ERROR);
         snprintf(g_telegram_data.error_message, sizeof(g_telegram_data.error_message),
                  "SSL init failed");
         return ERR_ABRT;
@@ -240,143 +331,163 @@ static err_t tcp_client_connected(void *arg, struct tcp_pcb *tpcb, err_t err)
     mbedtls_ssl_session_reset(&g_ssl);
     g_handshake_done = false;
 
+    // Profile the handshake; the tap sees the server flight as mbedTLS reads it
+    tls_profile_begin(&g_tls_profile, TELEGRAM_API_HOST);
+    tls_rx_queue_set_tap(&g_rx_queue, tls_profile_observe, &g_tls_profile);
+
     // Start TLS handshake
     int ret;
-    while ((ret = mbedtls_ssl_handshake(&g_ssl)) != 0) {
+    while ((ret = tls_profile_handshake(&g_tls_profile, &g_ssl)) != 0) {
         if (ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) {
-            printf("TLS handshake failed: -0x%04x\n", -ret);
-            g_telegram_data.state = TELEGRAM_STATE_ERROR;
+            LOG_W("TLS handshake failed: -0x%04x\n", -ret);
+            telegram_set_state(TELEGRAM_STATE_ERROR);
             snprintf(g_telegram_data.error_message, sizeof(g_telegram_data.error_message),
                      "TLS handshake failed");
+            deinit_ssl();
             return ERR_ABRT;
         }
         // Handshake in progress, will continue when more data arrives
         return ERR_OK;
     }
 
-    printf("TLS handshake completed\n");
+    LOG_I("TLS handshake completed\n");
+    tls_profile_report(&g_tls_profile, &g_ssl);
+    tls_arena_report(&g_tls_arena, "handshake");
     g_handshake_done = true;
 
     // Send HTTP request over TLS
     int write_ret = mbedtls_ssl_write(&g_ssl, (unsigned char *)g_request_buffer, strlen(g_request_buffer));
     if (write_ret < 0) {
-        printf("SSL write failed: -0x%04x\n", -write_ret);
-        g_telegram_data.state = TELEGRAM_STATE_ERROR;
+        LOG_W("SSL write failed: -0x%04x\n", -write_ret);
+        telegram_set_state(TELEGRAM_STATE_ERROR);
         snprintf(g_telegram_data.error_message, sizeof(g_telegram_data.error_message),
                  "Failed to send request");
+        deinit_ssl();
         return ERR_ABRT;
     }
 
-    printf("HTTPS request sent (%d bytes)\n", write_ret);
+    LOG_I("HTTPS request sent (%d bytes)\n", write_ret);
     return ERR_OK;
 }
 
-// TCP receive callback
-static err_t tcp_client_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err)
+// TCP connected callback. lwIP callbacks can interrupt other mbedTLS code
+// (the bench's in-memory handshake), so the arena it had selected is put back.
+static err_t tcp_client_connected(void *arg, struct tcp_pcb *tpcb, err_t err)
+{
+    tls_arena_t *prev = tls_arena_select(&g_tls_arena);
+    err_t ret = client_connected(arg, tpcb, err);
+    tls_arena_select(prev);
+    return ret;
+}
+
+// TCP receive callback body; runs with the connection's arena selected
+static err_t client_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err)
 {
     if (p == NULL) {
         // Connection closed by server
-        printf("Telegram connection closed by server\n");
+        LOG_I("Telegram connection closed by server\n");
         tcp_close(tpcb);
         g_tcp_pcb = NULL;
+        net_capture_end(EVENT_SOURCE_TELEGRAM);
 
         // Parse the final response if we have data
         if (g_response_len > 0) {
+            trace_begin(TRACE_JSON_PARSE);
             parse_telegram_response(g_response_buffer, g_response_len);
+            trace_end(TRACE_JSON_PARSE);
         }
 
         // Reset for next request
         g_response_len = 0;
         g_handshake_done = false;
+        tls_rx_queue_reset(&g_rx_queue);
+        deinit_ssl();
 
         return ERR_OK;
     }
 
     if (err != ERR_OK) {
-        printf("Telegram receive error: %d\n", err);
+        LOG_W("Telegram receive error: %d\n", err);
         pbuf_free(p);
-        g_telegram_data.state = TELEGRAM_STATE_ERROR;
+        telegram_set_state(TELEGRAM_STATE_ERROR);
         snprintf(g_telegram_data.error_message, sizeof(g_telegram_data.error_message),
                  "Receive error");
+        deinit_ssl();
         return err;
     }
 
-    // Copy data to response buffer for SSL processing
-    uint16_t copy_len = p->tot_len;
-    if (g_response_len + copy_len > sizeof(g_response_buffer) - 1) {
-        copy_len = sizeof(g_response_buffer) - 1 - g_response_len;
-    }
-
-    pbuf_copy_partial(p, g_response_buffer + g_response_len, copy_len, 0);
-    g_response_len += copy_len;
-
-    // Tell lwIP we've processed the data
-    tcp_recved(tpcb, p->tot_len);
-    pbuf_free(p);
+    // Queue ciphertext for mbedTLS; tcp_recved happens as it is consumed
+    tls_rx_queue_push(&g_rx_queue, p);
 
     // Continue TLS handshake if not done
     if (!g_handshake_done) {
-        int ret = mbedtls_ssl_handshake(&g_ssl);
+        int ret = tls_profile_handshake(&g_tls_profile, &g_ssl);
         if (ret == 0) {
-            printf("TLS handshake completed\n");
+            LOG_I("TLS handshake completed\n");
+            tls_profile_report(&g_tls_profile, &g_ssl);
+            tls_arena_report(&g_tls_arena, "handshake");
             g_handshake_done = true;
 
             // Send HTTP request now that handshake is done
             int write_ret = mbedtls_ssl_write(&g_ssl, (unsigned char *)g_request_buffer, strlen(g_request_buffer));
             if (write_ret < 0) {
-                printf("SSL write failed: -0x%04x\n", -write_ret);
-                g_telegram_data.state = TELEGRAM_STATE_ERROR;
+                LOG_W("SSL write failed: -0x%04x\n", -write_ret);
+                telegram_set_state(TELEGRAM_STATE_ERROR);
                 snprintf(g_telegram_data.error_message, sizeof(g_telegram_data.error_message),
                          "Failed to send request");
+                deinit_ssl();
             } else {
-                printf("HTTPS request sent (%d bytes)\n", write_ret);
+                LOG_I("HTTPS request sent (%d bytes)\n", write_ret);
             }
         } else if (ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) {
-            printf("TLS handshake failed: -0x%04x\n", -ret);
-            g_telegram_data.state = TELEGRAM_STATE_ERROR;
+            LOG_W("TLS handshake failed: -0x%04x\n", -ret);
+            telegram_set_state(TELEGRAM_STATE_ERROR);
             snprintf(g_telegram_data.error_message, sizeof(g_telegram_data.error_message),
                      "TLS handshake failed");
+            deinit_ssl();
         }
     } else {
-        // Handshake done, read decrypted data
-        char decrypt_buf[1024];
-        int read_ret = mbedtls_ssl_read(&g_ssl, (unsigned char *)decrypt_buf, sizeof(decrypt_buf) - 1);
-        if (read_ret > 0) {
-            decrypt_buf[read_ret] = '\0';
-            printf("Received %d bytes of decrypted data\n", read_ret);
-
-            // Store decrypted response
-            if (g_response_len + read_ret < sizeof(g_response_buffer)) {
-                memcpy(g_response_buffer + g_response_len, decrypt_buf, read_ret);
-                g_response_len += read_ret;
-                g_response_buffer[g_response_len] = '\0';
-            }
-        }
+        // Handshake done, read all available decrypted data
+        read_decrypted_data();
     }
 
     return ERR_OK;
 }
 
+// TCP receive callback, in the connection's arena like tcp_client_connected
+static err_t tcp_client_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err)
+{
+    tls_arena_t *prev = tls_arena_select(&g_tls_arena);
+    err_t ret = client_recv(arg, tpcb, p, err);
+    tls_arena_select(prev);
+    return ret;
+}
+
 // TCP error callback
 static void tcp_client_err(void *arg, err_t err)
 {
-    printf("Telegram TCP error: %d\n", err);
-    g_telegram_data.state = TELEGRAM_STATE_ERROR;
+    LOG_W("Telegram TCP error: %d\n", err);
+    telegram_set_state(TELEGRAM_STATE_ERROR);
     snprintf(g_telegram_data.error_message, sizeof(g_telegram_data.error_message),
              "Network error");
     g_tcp_pcb = NULL;
+    net_capture_end(EVENT_SOURCE_TELEGRAM);
+
+    // The pcb is already gone, just drop any queued ciphertext and TLS state
+    tls_rx_queue_reset(&g_rx_queue);
+    deinit_ssl();
 }
 
 // Parse telegram response (dispatch to specific parser)
 static void parse_telegram_response(const char *response, uint16_t len)
 {
-    printf("Parsing Telegram response (%d bytes)\n", len);
+    LOG_I("Parsing Telegram response (%d bytes)\n", len);
 
     // Find the JSON body (skip HTTP headers)
     const char *json_start = strstr(response, "\r\n\r\n");
     if (json_start == NULL) {
-        printf("No JSON body found in Telegram response\n");
-        g_telegram_data.state = TELEGRAM_STATE_ERROR;
+        LOG_W("No JSON body found in Telegram response\n");
+        telegram_set_state(TELEGRAM_STATE_ERROR);
         snprintf(g_telegram_data.error_message, sizeof(g_telegram_data.error_message),
                  "Invalid response");
         return;
@@ -385,8 +496,8 @@ static void parse_telegram_response(const char *response, uint16_t len)
 
     // Check if API returned error
     if (strstr(json_start, "\"ok\":false") != NULL) {
-        printf("Telegram API returned error\n");
-        g_telegram_data.state = TELEGRAM_STATE_ERROR;
+        LOG_W("Telegram API returned error\n");
+        telegram_set_state(TELEGRAM_STATE_ERROR);
 
         // Try to extract error description
         const char *desc_start = strstr(json_start, "\"description\":\"");
@@ -417,21 +528,34 @@ static void parse_telegram_response(const char *response, uint16_t len)
 // Parse getUpdates response
 static void parse_get_updates_response(const char *json)
 {
-    printf("Parsing getUpdates response\n");
+    LOG_I("Parsing getUpdates response\n");
+
+    if (parse_updates(json, &g_telegram_data) < 0) {
+        LOG_W("No result array in getUpdates response\n");
+    } else {
+        LOG_I("Parsed %d messages\n", g_telegram_data.message_count);
+    }
+    telegram_set_state(TELEGRAM_STATE_SUCCESS);
+}
+
+// Add the messages in a getUpdates body to data and advance its
+// last_update_id. Returns the number of messages added, -1 if there is no
+// result array.
+static int parse_updates(const char *json, telegram_data_t *data)
+{
+    int added = 0;
 
     // Find "result" array
     const char *result_start = strstr(json, "\"result\":[");
     if (result_start == NULL) {
-        printf("No result array in getUpdates response\n");
-        g_telegram_data.state = TELEGRAM_STATE_SUCCESS;
-        return;
+        return -1;
     }
     result_start += 10; // Skip past "result":[
 
     // Parse each update in the array
     const char *search_pos = result_start;
 
-    while (g_telegram_data.message_count < MAX_TELEGRAM_MESSAGES) {
+    while (true) {
         // Find next "update_id"
         search_pos = strstr(search_pos, "\"update_id\":");
         if (search_pos == NULL) break;
@@ -440,8 +564,8 @@ static void parse_get_updates_response(const char *json)
 
         // Parse update_id
         int64_t update_id = parse_int64(search_pos);
-        if (update_id > g_telegram_data.last_update_id) {
-            g_telegram_data.last_update_id = update_id;
+        if (update_id > data->last_update_id) {
+            data->last_update_id = update_id;
         }
 
         // Find message object
@@ -536,7 +660,14 @@ static void parse_get_updates_response(const char *json)
 
         // Add message to buffer
         if (strlen(text) > 0) {
-            telegram_message_t *msg = &g_telegram_data.messages[g_telegram_data.message_count];
+            // Keep the most recent messages: drop the oldest when full
+            if (data->message_count >= MAX_TELEGRAM_MESSAGES) {
+                memmove(&data->messages[0], &data->messages[1],
+                        (MAX_TELEGRAM_MESSAGES - 1) * sizeof(telegram_message_t));
+                data->message_count--;
+            }
+
+            telegram_message_t *msg = &data->messages[data->message_count];
             msg->message_id = message_id;
             msg->chat_id = chat_id;
             strncpy(msg->username, username, TELEGRAM_USERNAME_MAX);
@@ -545,29 +676,28 @@ static void parse_get_updates_response(const char *json)
             msg->text[TELEGRAM_MESSAGE_TEXT_MAX] = '\0';
             msg->timestamp = timestamp;
 
-            g_telegram_data.message_count++;
-            printf("Parsed message from @%s: %s\n", username, text);
+            data->message_count++;
+            added++;
         }
 
         search_pos = msg_start + 1;
     }
 
-    g_telegram_data.state = TELEGRAM_STATE_SUCCESS;
-    printf("Parsed %d messages\n", g_telegram_data.message_count);
+    return added;
 }
 
 // Parse sendMessage response
 static void parse_send_message_response(const char *json)
 {
-    printf("Parsing sendMessage response\n");
+    LOG_I("Parsing sendMessage response\n");
 
     // Check if message was sent successfully
     if (strstr(json, "\"ok\":true") != NULL) {
-        printf("Message sent successfully\n");
-        g_telegram_data.state = TELEGRAM_STATE_SUCCESS;
+        LOG_I("Message sent successfully\n");
+        telegram_set_state(TELEGRAM_STATE_SUCCESS);
     } else {
-        printf("Failed to send message\n");
-        g_telegram_data.state = TELEGRAM_STATE_ERROR;
+        LOG_W("Failed to send message\n");
+        telegram_set_state(TELEGRAM_STATE_ERROR);
         snprintf(g_telegram_data.error_message, sizeof(g_telegram_data.error_message),
                  "Failed to send message");
     }
@@ -626,13 +756,13 @@ static int64_t parse_int64(const char *str)
 // Send message (non-blocking)
 void telegram_send_message(const char *bot_token, int64_t chat_id, const char *text)
 {
-    printf("Sending Telegram message to chat %lld: %s\n", chat_id, text);
+    LOG_I("Sending Telegram message to chat %lld: %s\n", chat_id, text);
 
     // Save bot token for reconnection
     strncpy(g_bot_token, bot_token, sizeof(g_bot_token) - 1);
 
     // Set state
-    g_telegram_data.state = TELEGRAM_STATE_SENDING;
+    telegram_set_state(TELEGRAM_STATE_SENDING);
     g_current_request_type = REQUEST_TYPE_SEND_MESSAGE;
 
     // URL encode the message text
@@ -658,7 +788,7 @@ void telegram_send_message(const char *bot_token, int64_t chat_id, const char *t
              "%s",
              bot_token, TELEGRAM_API_HOST, content_length, post_body);
 
-    printf("POST request ready\n");
+    LOG_I("POST request ready\n");
 
     // Reset response buffer
     g_response_len = 0;
@@ -669,11 +799,11 @@ void telegram_send_message(const char *bot_token, int64_t chat_id, const char *t
 
     if (err == ERR_OK) {
         // IP address was cached
-        printf("Using cached IP for %s\n", TELEGRAM_API_HOST);
+        LOG_I("Using cached IP for %s\n", TELEGRAM_API_HOST);
         telegram_dns_found(TELEGRAM_API_HOST, &g_server_ip, NULL);
     } else if (err != ERR_INPROGRESS) {
-        printf("DNS lookup failed immediately: %d\n", err);
-        g_telegram_data.state = TELEGRAM_STATE_ERROR;
+        LOG_W("DNS lookup failed immediately: %d\n", err);
+        telegram_set_state(TELEGRAM_STATE_ERROR);
         snprintf(g_telegram_data.error_message, sizeof(g_telegram_data.error_message),
                  "DNS lookup failed");
     }
@@ -682,13 +812,13 @@ void telegram_send_message(const char *bot_token, int64_t chat_id, const char *t
 // Poll for new messages (non-blocking)
 void telegram_poll_updates(const char *bot_token)
 {
-    printf("Polling Telegram updates (offset: %lld)\n", g_telegram_data.last_update_id + 1);
+    LOG_I("Polling Telegram updates (offset: %lld)\n", g_telegram_data.last_update_id + 1);
 
     // Save bot token for reconnection
     strncpy(g_bot_token, bot_token, sizeof(g_bot_token) - 1);
 
     // Set state
-    g_telegram_data.state = TELEGRAM_STATE_RECEIVING;
+    telegram_set_state(TELEGRAM_STATE_RECEIVING);
     g_current_request_type = REQUEST_TYPE_GET_UPDATES;
 
     // Build HTTPS GET request with offset
@@ -699,22 +829,23 @@ void telegram_poll_updates(const char *bot_token)
              "\r\n",
              bot_token, g_telegram_data.last_update_id + 1, TELEGRAM_API_HOST);
 
-    printf("GET request ready\n");
+    LOG_I("GET request ready\n");
 
     // Reset response buffer
     g_response_len = 0;
     memset(g_response_buffer, 0, sizeof(g_response_buffer));
+    net_capture_begin(EVENT_SOURCE_TELEGRAM);
 
     // Start DNS lookup for api.telegram.org
     err_t err = dns_gethostbyname(TELEGRAM_API_HOST, &g_server_ip, telegram_dns_found, NULL);
 
     if (err == ERR_OK) {
         // IP address was cached
-        printf("Using cached IP for %s\n", TELEGRAM_API_HOST);
+        LOG_I("Using cached IP for %s\n", TELEGRAM_API_HOST);
         telegram_dns_found(TELEGRAM_API_HOST, &g_server_ip, NULL);
     } else if (err != ERR_INPROGRESS) {
-        printf("DNS lookup failed immediately: %d\n", err);
-        g_telegram_data.state = TELEGRAM_STATE_ERROR;
+        LOG_W("DNS lookup failed immediately: %d\n", err);
+        telegram_set_state(TELEGRAM_STATE_ERROR);
         snprintf(g_telegram_data.error_message, sizeof(g_telegram_data.error_message),
                  "DNS lookup failed");
     }
@@ -731,3 +862,20 @@ telegram_api_state_t telegram_api_get_state(void)
 {
     return g_telegram_data.state;
 }
+
+// Parse a getUpdates body into scratch storage, leaving the shown messages
+// alone (benchmarks and capture replay)
+int telegram_api_parse_fixture(const char *json)
+{
+    static telegram_data_t *scratch = NULL;
+
+    if (scratch == NULL) {
+        scratch = (telegram_data_t *)psram_malloc(sizeof(telegram_data_t));
+        if (scratch == NULL) {
+            return -1;
+        }
+    }
+    scratch->message_count = 0;
+    scratch->last_update_id = 0;
+    return parse_updates(json, scratch);
+}
@@ -0,0 +1,287 @@
+#include "tls_arena.h"
+#include "psram_helper.h"
+#include "mbedtls/platform.h"
+#include "log.h"
+#include <string.h>
+#include <stdlib.h>
+
+// Every block starts with an 8-byte header; sizes include the header and are
+// multiples of 8 so payloads stay 8-byte aligned. Bit 0 of size marks a block
+// in use. A block is merged with the free blocks that follow it, both on
+// free and while searching; nothing merges backwards, which is enough for
+// the short-lived, mostly LIFO allocation pattern of a handshake.
+#define BLOCK_HEADER_SIZE   8
+#define BLOCK_IN_USE        0x1u
+#define BLOCK_MIN_SPLIT     (BLOCK_HEADER_SIZE + 16)
+
+typedef struct {
+    uint32_t size;
+    uint32_t magic;
+} block_header_t;
+
+#define BLOCK_MAGIC 0x544c5341u  // "TLSA"
+
+static tls_arena_t *g_arenas[TLS_ARENA_MAX_ARENAS] = {0};
+static tls_arena_t *g_current_arena = NULL;
+static bool g_hooks_installed = false;
+
+static void *tls_arena_calloc(size_t count, size_t size);
+static void tls_arena_free(void *ptr);
+
+// Reset a region to a single free block
+static void region_reset(tls_arena_region_t *region)
+{
+    if (region->base == NULL) {
+        return;
+    }
+
+    block_header_t *first = (block_header_t *)region->base;
+    first->size = (uint32_t)region->size;
+    first->magic = BLOCK_MAGIC;
+    region->used = 0;
+    region->peak = 0;
+    region->allocs = 0;
+}
+
+// First-fit allocation inside a region
+static void *region_alloc(tls_arena_region_t *region, size_t size)
+{
+    if (region->base == NULL) {
+        return NULL;
+    }
+
+    uint32_t need = (uint32_t)((size + BLOCK_HEADER_SIZE + 7) & ~(size_t)7);
+    uint8_t *end = region->base + region->size;
+    uint8_t *pos = region->base;
+
+    while (pos < end) {
+        block_header_t *block = (block_header_t *)pos;
+        uint32_t block_size = block->size & ~BLOCK_IN_USE;
+
+        if (!(block->size & BLOCK_IN_USE)) {
+            // Coalesce any free blocks that follow
+            uint8_t *next = pos + block_size;
+            while (next < end && !(((block_header_t *)next)->size & BLOCK_IN_USE)) {
+                block_size += ((block_header_t *)next)->size;
+                next = pos + block_size;
+            }
+            block->size = block_size;
+
+            if (block_size >= need) {
+                if (block_size - need >= BLOCK_MIN_SPLIT) {
+                    block_header_t *rest = (block_header_t *)(pos + need);
+                    rest->size = block_size - need;
+                    rest->magic = BLOCK_MAGIC;
+                    block_size = need;
+                }
+                block->size = block_size | BLOCK_IN_USE;
+                block->magic = BLOCK_MAGIC;
+
+                region->used += block_size;
+                region->allocs++;
+                if (region->used > region->peak) {
+                    region->peak = region->used;
+                }
+                return pos + BLOCK_HEADER_SIZE;
+            }
+        }
+
+        pos += block_size;
+    }
+
+    return NULL;
+}
+
+// Return a block to its region
+static void region_free(tls_arena_region_t *region, void *ptr)
+{
+    block_header_t *block = (block_header_t *)((uint8_t *)ptr - BLOCK_HEADER_SIZE);
+    if (block->magic != BLOCK_MAGIC || !(block->size & BLOCK_IN_USE)) {
+        LOG_W("TLS arena: bad free %p\n", ptr);
+        return;
+    }
+
+    uint32_t block_size = block->size & ~BLOCK_IN_USE;
+    region->used -= block_size;
+
+    // Merge with following free blocks
+    uint8_t *end = region->base + region->size;
+    uint8_t *next = (uint8_t *)block + block_size;
+    while (next < end && !(((block_header_t *)next)->size & BLOCK_IN_USE)) {
+        block_size += ((block_header_t *)next)->size;
+        next = (uint8_t *)block + block_size;
+    }
+    block->size = block_size;
+}
+
+static bool region_contains(const tls_arena_region_t *region, const void *ptr)
+{
+    const uint8_t *p = (const uint8_t *)ptr;
+    return region->base != NULL && p >= region->base && p < region->base + region->size;
+}
+
+// Initialize an arena
+bool tls_arena_init(tls_arena_t *arena, const char *name)
+{
+    if (arena->initialized) {
+        return true;
+    }
+
+    arena->name = name;
+    arena->failures = 0;
+
+    arena->sram.base = arena->sram_pool;
+    arena->sram.size = sizeof(arena->sram_pool);
+    region_reset(&arena->sram);
+
+    // PSRAM cannot be freed, so a region kept from an earlier init is reused
+    if (arena->psram.base == NULL) {
+        arena->psram.base = (uint8_t *)psram_malloc(TLS_ARENA_PSRAM_SIZE);
+    }
+    arena->psram.size = (arena->psram.base != NULL) ? TLS_ARENA_PSRAM_SIZE : 0;
+    if (arena->psram.base == NULL) {
+        LOG_W("TLS arena %s: no PSRAM region, using SRAM pool only\n", name);
+    }
+    region_reset(&arena->psram);
+
+    // Register for free() lookups
+    bool registered = false;
+    for (int i = 0; i < TLS_ARENA_MAX_ARENAS; i++) {
+        if (g_arenas[i] == NULL) {
+            g_arenas[i] = arena;
+            registered = true;
+            break;
+        }
+    }
+    if (!registered) {
+        LOG_W("TLS arena %s: too many arenas\n", name);
+        return false;
+    }
+
+    if (!g_hooks_installed) {
+        mbedtls_platform_set_calloc_free(tls_arena_calloc, tls_arena_free);
+        g_hooks_installed = true;
+    }
+
+    arena->initialized = true;
+    LOG_I("TLS arena %s: %d KB SRAM + %d KB PSRAM\n", name,
+           (int)(arena->sram.size / 1024), (int)(arena->psram.size / 1024));
+    return true;
+}
+
+// Select the arena for subsequent allocations, returning the previous one
+tls_arena_t *tls_arena_select(tls_arena_t *arena)
+{
+    tls_arena_t *prev = g_current_arena;
+    g_current_arena = (arena != NULL && arena->initialized) ? arena : NULL;
+    return prev;
+}
+
+// Release the arena, stop routing allocations to it and free its slot
+void tls_arena_deinit(tls_arena_t *arena)
+{
+    if (g_current_arena == arena) {
+        g_current_arena = NULL;
+    }
+    if (!arena->initialized) {
+        return;
+    }
+
+    tls_arena_release(arena);
+    for (int i = 0; i < TLS_ARENA_MAX_ARENAS; i++) {
+        if (g_arenas[i] == arena) {
+            g_arenas[i] = NULL;
+        }
+    }
+    arena->initialized = false;
+}
+
+// Drop all allocations at once
+void tls_arena_release(tls_arena_t *arena)
+{
+    if (!arena->initialized) {
+        return;
+    }
+
+    if (arena->sram.used > 0 || arena->psram.used > 0) {
+        LOG_W("TLS arena %s: releasing %d bytes still in use\n", arena->name,
+               (int)(arena->sram.used + arena->psram.used));
+    }
+
+    region_reset(&arena->sram);
+    region_reset(&arena->psram);
+    arena->failures = 0;
+}
+
+// Print peak usage
+void tls_arena_report(const tls_arena_t *arena, const char *label)
+{
+    LOG_I("TLS memory %s (%s): peak SRAM %d/%d B, PSRAM %d/%d B, %d allocs, %d failed\n",
+           arena->name, label,
+           (int)arena->sram.peak, (int)arena->sram.size,
+           (int)arena->psram.peak, (int)arena->psram.size,
+           (int)(arena->sram.allocs + arena->psram.allocs),
+           (int)arena->failures);
+}
+
+// mbedTLS calloc hook
+static void *tls_arena_calloc(size_t count, size_t size)
+{
+    tls_arena_t *arena = g_current_arena;
+    if (arena == NULL) {
+        return calloc(count, size);
+    }
+
+    if (count != 0 && size > SIZE_MAX / count) {
+        return NULL;
+    }
+    size_t total = count * size;
+
+    void *ptr;
+    if (total <= TLS_ARENA_SMALL_OBJECT_MAX) {
+        ptr = region_alloc(&arena->sram, total);
+        if (ptr == NULL) {
+            ptr = region_alloc(&arena->psram, total);
+        }
+    } else {
+        ptr = region_alloc(&arena->psram, total);
+        if (ptr == NULL) {
+            ptr = region_alloc(&arena->sram, total);
+        }
+    }
+
+    if (ptr == NULL) {
+        arena->failures++;
+        LOG_W("TLS arena %s: out of memory (%d bytes)\n", arena->name, (int)total);
+        return NULL;
+    }
+
+    memset(ptr, 0, total);
+    return ptr;
+}
+
+// mbedTLS free hook - finds the owning region by address
+static void tls_arena_free(void *ptr)
+{
+    if (ptr == NULL) {
+        return;
+    }
+
+    for (int i = 0; i < TLS_ARENA_MAX_ARENAS; i++) {
+        tls_arena_t *arena = g_arenas[i];
+        if (arena == NULL) {
+            continue;
+        }
+        if (region_contains(&arena->sram, ptr)) {
+            region_free(&arena->sram, ptr);
+            return;
+        }
+        if (region_contains(&arena->psram, ptr)) {
+            region_free(&arena->psram, ptr);
+            return;
+        }
+    }
+
+    // Allocated before any arena was selected
+    free(ptr);
+}
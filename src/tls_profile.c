@@ -0,0 +1,208 @@
+#include "tls_profile.h"
+#include "trace.h"
+#include "runtime_stats.h"
+#include "log.h"
+#include "pico/stdlib.h"
+#include "mbedtls/ssl_ciphersuites.h"
+#include "mbedtls/ecp.h"
+#include <string.h>
+
+// TLS record / handshake message types seen in the server flight
+#define TLS_RECORD_CHANGE_CIPHER_SPEC   20
+#define TLS_RECORD_HANDSHAKE            22
+#define TLS_HS_SERVER_KEY_EXCHANGE      12
+#define TLS_EC_CURVE_TYPE_NAMED         3
+
+// Cheapest first for a Cortex-M33 without crypto extensions:
+// - ECDHE-RSA before ECDHE-ECDSA: verifying the server's RSA signature
+//   (e = 65537) is far cheaper than an ECDSA verify
+// - AES-128 before AES-256 (fewer rounds), GCM/CCM only (no CBC in our config)
+// - SHA-256 PRF before SHA-384 (64-bit rounds are slow on a 32-bit core)
+// - Static RSA key exchange last: cheap for us but no forward secrecy
+static const int g_suites_default[] = {
+    MBEDTLS_TLS_ECDHE_RSA_WITH_AES_128_GCM_SHA256,
+    MBEDTLS_TLS_ECDHE_ECDSA_WITH_AES_128_GCM_SHA256,
+    MBEDTLS_TLS_ECDHE_ECDSA_WITH_AES_128_CCM,
+    MBEDTLS_TLS_ECDHE_RSA_WITH_AES_256_GCM_SHA384,
+    MBEDTLS_TLS_ECDHE_ECDSA_WITH_AES_256_GCM_SHA384,
+    MBEDTLS_TLS_RSA_WITH_AES_128_GCM_SHA256,
+    0
+};
+
+// P-256 scalar multiplication is roughly half the cost of P-384
+static const uint16_t g_groups_default[] = {
+    MBEDTLS_SSL_IANA_TLS_GROUP_SECP256R1,
+    MBEDTLS_SSL_IANA_TLS_GROUP_SECP384R1,
+    MBEDTLS_SSL_IANA_TLS_GROUP_NONE
+};
+
+// Names for the handshake states worth reporting
+static const char *const g_state_names[TLS_PROFILE_MAX_STATES] = {
+    [MBEDTLS_SSL_HELLO_REQUEST]             = "HelloRequest",
+    [MBEDTLS_SSL_CLIENT_HELLO]              = "ClientHello",
+    [MBEDTLS_SSL_SERVER_HELLO]              = "ServerHello",
+    [MBEDTLS_SSL_SERVER_CERTIFICATE]        = "ServerCertificate",
+    [MBEDTLS_SSL_SERVER_KEY_EXCHANGE]       = "ServerKeyExchange (verify)",
+    [MBEDTLS_SSL_CERTIFICATE_REQUEST]       = "CertificateRequest",
+    [MBEDTLS_SSL_SERVER_HELLO_DONE]         = "ServerHelloDone",
+    [MBEDTLS_SSL_CLIENT_CERTIFICATE]        = "ClientCertificate",
+    [MBEDTLS_SSL_CLIENT_KEY_EXCHANGE]       = "ClientKeyExchange (ECDH)",
+    [MBEDTLS_SSL_CERTIFICATE_VERIFY]        = "CertificateVerify",
+    [MBEDTLS_SSL_CLIENT_CHANGE_CIPHER_SPEC] = "ClientChangeCipherSpec",
+    [MBEDTLS_SSL_CLIENT_FINISHED]           = "ClientFinished",
+    [MBEDTLS_SSL_SERVER_CHANGE_CIPHER_SPEC] = "ServerChangeCipherSpec",
+    [MBEDTLS_SSL_SERVER_FINISHED]           = "ServerFinished",
+    [MBEDTLS_SSL_FLUSH_BUFFERS]             = "FlushBuffers",
+    [MBEDTLS_SSL_HANDSHAKE_WRAPUP]          = "Wrapup",
+};
+
+// Apply the preference lists
+void tls_profile_apply_preferences(mbedtls_ssl_config *conf)
+{
+    mbedtls_ssl_conf_ciphersuites(conf, g_suites_default);
+    mbedtls_ssl_conf_groups(conf, g_groups_default);
+}
+
+// Start profiling a handshake
+void tls_profile_begin(tls_profile_t *prof, const char *host)
+{
+    memset(prof, 0, sizeof(*prof));
+    prof->host = host;
+    prof->start_us = time_us_64();
+}
+
+// Run handshake steps until done, blocked on I/O, or failed
+int tls_profile_handshake(tls_profile_t *prof, mbedtls_ssl_context *ssl)
+{
+    int ret = 0;
+
+    while (!mbedtls_ssl_is_handshake_over(ssl)) {
+        int state = ssl->MBEDTLS_PRIVATE(state);
+
+        uint64_t t0 = time_us_64();
+        trace_begin(TRACE_TLS_HANDSHAKE);
+        ret = mbedtls_ssl_handshake_step(ssl);
+        trace_end(TRACE_TLS_HANDSHAKE);
+        uint32_t elapsed = (uint32_t)(time_us_64() - t0);
+
+        if (state >= 0 && state < TLS_PROFILE_MAX_STATES) {
+            prof->state_us[state] += elapsed;
+        }
+        prof->cpu_us += elapsed;
+
+        if (ret != 0) {
+            if (ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) {
+                runtime_stats_tls_handshake(false, 0, 0);
+            }
+            return ret;
+        }
+    }
+
+    if (!prof->done) {
+        prof->done = true;
+        prof->total_us = time_us_64() - prof->start_us;
+        runtime_stats_tls_handshake(true, (uint32_t)prof->total_us, (uint32_t)prof->cpu_us);
+    }
+    return 0;
+}
+
+// Track handshake messages inside handshake records
+static void observe_handshake(tls_profile_t *prof, const unsigned char *buf, size_t len)
+{
+    while (len > 0) {
+        if (prof->hs_hdr_len < sizeof(prof->hs_hdr)) {
+            prof->hs_hdr[prof->hs_hdr_len++] = *buf++;
+            len--;
+            if (prof->hs_hdr_len == sizeof(prof->hs_hdr)) {
+                prof->hs_remaining = ((uint32_t)prof->hs_hdr[1] << 16) |
+                                     ((uint32_t)prof->hs_hdr[2] << 8) |
+                                     prof->hs_hdr[3];
+                prof->ske_len = 0;
+                if (prof->hs_remaining == 0) {
+                    prof->hs_hdr_len = 0;
+                }
+            }
+            continue;
+        }
+
+        size_t n = (len < prof->hs_remaining) ? len : prof->hs_remaining;
+
+        // ECParameters: curve_type(1) named_curve(2)
+        if (prof->hs_hdr[0] == TLS_HS_SERVER_KEY_EXCHANGE) {
+            for (size_t i = 0; i < n && prof->ske_len < sizeof(prof->ske); i++) {
+                prof->ske[prof->ske_len++] = buf[i];
+            }
+            if (prof->ske_len == sizeof(prof->ske) && prof->group_id == 0 &&
+                prof->ske[0] == TLS_EC_CURVE_TYPE_NAMED) {
+                prof->group_id = ((uint16_t)prof->ske[1] << 8) | prof->ske[2];
+            }
+        }
+
+        buf += n;
+        len -= n;
+        prof->hs_remaining -= n;
+        if (prof->hs_remaining == 0) {
+            prof->hs_hdr_len = 0;
+        }
+    }
+}
+
+// Receive tap - parse record framing of the server's plaintext flight
+void tls_profile_observe(void *ctx, const unsigned char *buf, size_t len)
+{
+    tls_profile_t *prof = (tls_profile_t *)ctx;
+
+    while (len > 0 && !prof->sniff_done) {
+        if (prof->rec_hdr_len < sizeof(prof->rec_hdr)) {
+            prof->rec_hdr[prof->rec_hdr_len++] = *buf++;
+            len--;
+            if (prof->rec_hdr_len == sizeof(prof->rec_hdr)) {
+                prof->rec_remaining = ((uint16_t)prof->rec_hdr[3] << 8) | prof->rec_hdr[4];
+                if (prof->rec_hdr[0] == TLS_RECORD_CHANGE_CIPHER_SPEC) {
+                    // Everything after this is encrypted
+                    prof->sniff_done = true;
+                } else if (prof->rec_remaining == 0) {
+                    prof->rec_hdr_len = 0;
+                }
+            }
+            continue;
+        }
+
+        size_t n = (len < prof->rec_remaining) ? len : prof->rec_remaining;
+        if (prof->rec_hdr[0] == TLS_RECORD_HANDSHAKE) {
+            observe_handshake(prof, buf, n);
+        }
+
+        buf += n;
+        len -= n;
+        prof->rec_remaining -= n;
+        if (prof->rec_remaining == 0) {
+            prof->rec_hdr_len = 0;
+        }
+    }
+}
+
+// Print the handshake breakdown
+void tls_profile_report(const tls_profile_t *prof, const mbedtls_ssl_context *ssl)
+{
+    const char *curve = "none";
+    if (prof->group_id != 0) {
+        const mbedtls_ecp_curve_info *info = mbedtls_ecp_curve_info_from_tls_id(prof->group_id);
+        curve = (info != NULL) ? info->name : "unknown";
+    }
+
+    // Split so each line's strings fit the log's copy buffer
+    LOG_I("TLS handshake %s: %s\n", prof->host ? prof->host : "?", mbedtls_ssl_get_version(ssl));
+    LOG_I("  suite %s\n", mbedtls_ssl_get_ciphersuite(ssl));
+    LOG_I("  curve %s (0x%04x), total %u ms, CPU %u ms\n", curve, prof->group_id,
+          (unsigned)(prof->total_us / 1000), (unsigned)(prof->cpu_us / 1000));
+
+    for (int i = 0; i < TLS_PROFILE_MAX_STATES; i++) {
+        if (prof->state_us[i] < 1000) {
+            continue;  // Only steps that cost at least a millisecond
+        }
+        LOG_I("  %-28s %6u ms\n",
+              g_state_names[i] ? g_state_names[i] : "state",
+              (unsigned)(prof->state_us[i] / 1000));
+    }
+}
@@ -0,0 +1,91 @@
+#include "tls_rx_queue.h"
+#include "mbedtls/ssl.h"
+
+// Bind the queue to a new connection
+void tls_rx_queue_init(tls_rx_queue_t *q, struct tcp_pcb *pcb)
+{
+    tls_rx_queue_reset(q);
+    q->pcb = pcb;
+    q->bytes_queued = 0;
+    q->bytes_consumed = 0;
+    q->tap = NULL;
+    q->tap_ctx = NULL;
+}
+
+// Observe bytes as mbedTLS reads them
+void tls_rx_queue_set_tap(tls_rx_queue_t *q, tls_rx_tap_t tap, void *ctx)
+{
+    q->tap = tap;
+    q->tap_ctx = ctx;
+}
+
+// Append a received segment chain
+void tls_rx_queue_push(tls_rx_queue_t *q, struct pbuf *p)
+{
+    if (p == NULL) {
+        return;
+    }
+
+    q->bytes_queued += p->tot_len;
+
+    if (q->head == NULL) {
+        q->head = p;
+    } else {
+        // Bounded by the TCP window, so tot_len cannot overflow
+        pbuf_cat(q->head, p);
+    }
+}
+
+// Copy bytes out of the head of the queue and release what was consumed
+size_t tls_rx_queue_read(tls_rx_queue_t *q, unsigned char *buf, size_t len)
+{
+    if (q->head == NULL || len == 0) {
+        return 0;
+    }
+
+    u16_t n = (len < q->head->tot_len) ? (u16_t)len : q->head->tot_len;
+    pbuf_copy_partial(q->head, buf, n, 0);
+
+    // Drops fully consumed pbufs and advances the payload of a partial one
+    q->head = pbuf_free_header(q->head, n);
+    q->bytes_consumed += n;
+
+    if (q->pcb != NULL) {
+        tcp_recved(q->pcb, n);
+    }
+
+    return n;
+}
+
+// Bytes waiting to be consumed
+size_t tls_rx_queue_pending(const tls_rx_queue_t *q)
+{
+    return (q->head != NULL) ? q->head->tot_len : 0;
+}
+
+// Free queued segments and detach from the connection
+void tls_rx_queue_reset(tls_rx_queue_t *q)
+{
+    if (q->head != NULL) {
+        pbuf_free(q->head);
+        q->head = NULL;
+    }
+    q->pcb = NULL;
+}
+
+// mbedTLS BIO receive callback
+int tls_rx_queue_bio_recv(void *ctx, unsigned char *buf, size_t len)
+{
+    tls_rx_queue_t *q = (tls_rx_queue_t *)ctx;
+
+    size_t n = tls_rx_queue_read(q, buf, len);
+    if (n == 0) {
+        return MBEDTLS_ERR_SSL_WANT_READ;
+    }
+
+    if (q->tap != NULL) {
+        q->tap(q->tap_ctx, buf, n);
+    }
+
+    return (int)n;
+}
@@ -0,0 +1,208 @@
+#include "trace.h"
+#include "psram_helper.h"
+#include "log.h"
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+#include "hardware/structs/m33.h"
+#include <stdio.h>
+#include <string.h>
+
+#define TRACE_CORES       2
+#define TRACE_HEX_PER_LINE 32
+
+// One event (12 bytes, little endian in the dump)
+typedef struct {
+    uint32_t cycles;
+    uint32_t value;         // Counter value (0 for begin/end)
+    uint16_t id;
+    uint8_t type;           // 'B', 'E' or 'C'
+    uint8_t reserved;
+} trace_record_t;
+
+// Per-core ring
+typedef struct {
+    trace_record_t *buf;
+    uint32_t head;          // Events written so far (atomic)
+    uint32_t last_sync;     // Cycle count of the last sync record
+    bool ready;             // Cycle counter running on this core
+} trace_ring_t;
+
+static const char *g_names[TRACE_ID_COUNT] = {
+    "sync",
+    "lv_timer_handler",
+    "disp_flush",
+    "tls_handshake_step",
+    "json_parse",
+    "ble_packet",
+    "key_event",
+    "psram_alloc",
+    "sps_sent",
+};
+
+static trace_ring_t g_rings[TRACE_CORES];
+static volatile bool g_enabled = false;
+
+// Reserve a slot and fill it; safe against IRQs on the same core
+static inline void write_record(trace_ring_t *r, uint8_t type, uint16_t id, uint32_t value, uint32_t cycles)
+{
+    uint32_t i = __atomic_fetch_add(&r->head, 1, __ATOMIC_RELAXED);
+    trace_record_t *rec = &r->buf[i & (TRACE_RING_EVENTS - 1)];
+    rec->cycles = cycles;
+    rec->value = value;
+    rec->id = id;
+    rec->type = type;
+}
+
+static void __not_in_flash_func(trace_event)(uint8_t type, trace_id_t id, uint32_t value)
+{
+    if (!g_enabled) {
+        return;
+    }
+    trace_ring_t *r = &g_rings[get_core_num()];
+    if (!r->ready) {
+        return;
+    }
+
+    uint32_t cycles = m33_hw->dwt_cyccnt;
+
+    // Tie the 32-bit cycle count to wall time often enough to unwrap it
+    if (cycles - r->last_sync >= TRACE_SYNC_CYCLES) {
+        r->last_sync = cycles;
+        write_record(r, 'C', TRACE_SYNC, time_us_32(), cycles);
+    }
+    write_record(r, type, id, value, cycles);
+}
+
+// Start this core's cycle counter
+void trace_core_init(void)
+{
+    trace_ring_t *r = &g_rings[get_core_num()];
+    if (r->buf == NULL) {
+        return;
+    }
+
+    m33_hw->demcr |= M33_DEMCR_TRCENA_BITS;
+    m33_hw->dwt_cyccnt = 0;
+    m33_hw->dwt_ctrl |= M33_DWT_CTRL_CYCCNTENA_BITS;
+
+    r->last_sync = m33_hw->dwt_cyccnt - TRACE_SYNC_CYCLES;   // First event writes a sync
+    r->ready = true;
+}
+
+// Initialize
+void trace_init(void)
+{
+    for (int core = 0; core < TRACE_CORES; core++) {
+        g_rings[core].buf = psram_malloc(TRACE_RING_EVENTS * sizeof(trace_record_t));
+        if (g_rings[core].buf == NULL) {
+            printf("Trace: no PSRAM for the ring buffers, tracing disabled\n");
+            return;
+        }
+    }
+    trace_core_init();
+    g_enabled = true;
+    printf("Trace: %d events per core\n", TRACE_RING_EVENTS);
+}
+
+void trace_begin(trace_id_t id)
+{
+    trace_event('B', id, 0);
+}
+
+void trace_end(trace_id_t id)
+{
+    trace_event('E', id, 0);
+}
+
+void trace_counter(trace_id_t id, uint32_t value)
+{
+    trace_event('C', id, value);
+}
+
+// Hex line output for binary dumps
+static const char *g_hex_tag = "TRACE";
+static uint8_t g_line[TRACE_HEX_PER_LINE];
+static int g_line_len = 0;
+
+static void dump_flush_line(void)
+{
+    if (g_line_len == 0) {
+        return;
+    }
+    printf("%s:", g_hex_tag);
+    for (int i = 0; i < g_line_len; i++) {
+        printf("%02x", g_line[i]);
+    }
+    printf("\n");
+    g_line_len = 0;
+}
+
+void trace_hex_begin(const char *tag)
+{
+    g_hex_tag = tag;
+    g_line_len = 0;
+    printf("%s BEGIN\n", tag);
+}
+
+void trace_hex_write(const void *data, size_t len)
+{
+    const uint8_t *p = data;
+    for (size_t i = 0; i < len; i++) {
+        g_line[g_line_len++] = p[i];
+        if (g_line_len == TRACE_HEX_PER_LINE) {
+            dump_flush_line();
+        }
+    }
+}
+
+void trace_hex_end(void)
+{
+    dump_flush_line();
+    printf("%s END\n", g_hex_tag);
+}
+
+static void dump_u32(uint32_t v)
+{
+    trace_hex_write(&v, sizeof(v));
+}
+
+static void dump_u16(uint16_t v)
+{
+    trace_hex_write(&v, sizeof(v));
+}
+
+// Stream the rings. Format: magic, version, core count, clk_sys Hz, name
+// count and length-prefixed names, then per core the record count and the
+// records oldest first.
+void trace_dump(void)
+{
+    bool was_enabled = g_enabled;
+    g_enabled = false;   // Keep the rings still while they are read
+    log_flush();         // Don't interleave queued log lines with the dump
+
+    trace_hex_begin("TRACE");
+    dump_u32(TRACE_MAGIC);
+    dump_u16(TRACE_VERSION);
+    dump_u16(TRACE_CORES);
+    dump_u32(clock_get_hz(clk_sys));
+    dump_u16(TRACE_ID_COUNT);
+    for (int i = 0; i < TRACE_ID_COUNT; i++) {
+        uint8_t len = (uint8_t)strlen(g_names[i]);
+        trace_hex_write(&len, 1);
+        trace_hex_write(g_names[i], len);
+    }
+
+    for (int core = 0; core < TRACE_CORES; core++) {
+        trace_ring_t *r = &g_rings[core];
+        uint32_t head = r->ready ? r->head : 0;
+        uint32_t count = head < TRACE_RING_EVENTS ? head : TRACE_RING_EVENTS;
+
+        dump_u32(count);
+        for (uint32_t i = head - count; i != head; i++) {
+            trace_hex_write(&r->buf[i & (TRACE_RING_EVENTS - 1)], sizeof(trace_record_t));
+        }
+    }
+    trace_hex_end();
+
+    g_enabled = was_enabled;
+}
@@ -0,0 +1,203 @@
+#include "ui_screen_cache.h"
+#include <string.h>
+#include <stdio.h>
+
+// Cached screen
+typedef struct {
+    bool used;
+    bool detached;                                  // Not the active screen
+    int key;
+    lv_obj_t *screen;
+    size_t heap_cost;
+    uint32_t last_used;                             // LRU stamp
+    lv_obj_t *members[UI_SCREEN_CACHE_MAX_FOCUS];   // Keypad group members, in group order
+    uint8_t member_count;
+    lv_obj_t *focused;
+} cache_entry_t;
+
+// Tree walk context for collecting group members
+typedef struct {
+    lv_group_t *group;
+    cache_entry_t *entry;
+    bool overflow;
+} detach_walk_t;
+
+static cache_entry_t g_entries[UI_SCREEN_CACHE_SLOTS];
+static uint32_t g_use_counter = 0;
+static size_t g_cached_bytes = 0;
+
+// Delete a cached screen
+static void evict(cache_entry_t *e)
+{
+    printf("Screen cache: evicting %d (%u bytes)\n", e->key, (unsigned)e->heap_cost);
+    lv_obj_delete(e->screen);
+    g_cached_bytes -= e->heap_cost;
+    memset(e, 0, sizeof(*e));
+}
+
+// Least recently used screen that may be evicted (never the active one)
+static cache_entry_t *lru_victim(void)
+{
+    cache_entry_t *victim = NULL;
+    for (int i = 0; i < UI_SCREEN_CACHE_SLOTS; i++) {
+        cache_entry_t *e = &g_entries[i];
+        if (e->used && e->detached && (victim == NULL || e->last_used < victim->last_used)) {
+            victim = e;
+        }
+    }
+    return victim;
+}
+
+static cache_entry_t *find_screen(lv_obj_t *screen)
+{
+    for (int i = 0; i < UI_SCREEN_CACHE_SLOTS; i++) {
+        if (g_entries[i].used && g_entries[i].screen == screen) {
+            return &g_entries[i];
+        }
+    }
+    return NULL;
+}
+
+// Tree walk: take group members out of the keypad group
+static lv_obj_tree_walk_res_t detach_cb(lv_obj_t *obj, void *user_data)
+{
+    detach_walk_t *walk = (detach_walk_t *)user_data;
+    if (lv_obj_get_group(obj) != walk->group) {
+        return LV_OBJ_TREE_WALK_NEXT;
+    }
+
+    cache_entry_t *e = walk->entry;
+    if (e->member_count >= UI_SCREEN_CACHE_MAX_FOCUS) {
+        walk->overflow = true;
+        return LV_OBJ_TREE_WALK_END;
+    }
+    e->members[e->member_count++] = obj;
+    return LV_OBJ_TREE_WALK_NEXT;
+}
+
+// Register a freshly built screen
+bool ui_screen_cache_add(int key, lv_obj_t *screen, size_t heap_cost)
+{
+    if (UI_SCREEN_CACHE_BUDGET == 0 || heap_cost > UI_SCREEN_CACHE_BUDGET) {
+        return false;
+    }
+
+    // Make room in the budget, then find a slot
+    while (g_cached_bytes + heap_cost > UI_SCREEN_CACHE_BUDGET) {
+        cache_entry_t *victim = lru_victim();
+        if (victim == NULL) {
+            return false;
+        }
+        evict(victim);
+    }
+
+    cache_entry_t *slot = NULL;
+    for (int i = 0; i < UI_SCREEN_CACHE_SLOTS && slot == NULL; i++) {
+        if (!g_entries[i].used) {
+            slot = &g_entries[i];
+        }
+    }
+    if (slot == NULL) {
+        slot = lru_victim();
+        if (slot == NULL) {
+            return false;
+        }
+        evict(slot);
+    }
+
+    memset(slot, 0, sizeof(*slot));
+    slot->used = true;
+    slot->key = key;
+    slot->screen = screen;
+    slot->heap_cost = heap_cost;
+    slot->last_used = ++g_use_counter;
+    g_cached_bytes += heap_cost;
+    return true;
+}
+
+// Get a cached screen and re-attach it
+lv_obj_t *ui_screen_cache_get(int key)
+{
+    for (int i = 0; i < UI_SCREEN_CACHE_SLOTS; i++) {
+        cache_entry_t *e = &g_entries[i];
+        if (!e->used || !e->detached || e->key != key) {
+            continue;
+        }
+
+        lv_group_t *group = lv_group_get_default();
+        if (group != NULL) {
+            for (uint8_t m = 0; m < e->member_count; m++) {
+                lv_group_add_obj(group, e->members[m]);
+            }
+            if (e->focused != NULL) {
+                lv_group_focus_obj(e->focused);
+            }
+        }
+
+        e->detached = false;
+        e->last_used = ++g_use_counter;
+        return e->screen;
+    }
+    return NULL;
+}
+
+// Leave a screen
+bool ui_screen_cache_release(lv_obj_t *screen)
+{
+    cache_entry_t *e = find_screen(screen);
+    if (e == NULL) {
+        return false;
+    }
+
+    lv_group_t *group = lv_group_get_default();
+    e->member_count = 0;
+    e->focused = NULL;
+
+    if (group != NULL) {
+        detach_walk_t walk = {group, e, false};
+        lv_obj_tree_walk(screen, detach_cb, &walk);
+        if (walk.overflow) {
+            // Too many focusable widgets to restore; don't cache it
+            evict(e);
+            return false;
+        }
+
+        lv_obj_t *focused = lv_group_get_focused(group);
+        for (uint8_t m = 0; m < e->member_count; m++) {
+            if (e->members[m] == focused) {
+                e->focused = focused;
+            }
+            lv_group_remove_obj(e->members[m]);
+        }
+    }
+
+    e->detached = true;
+    return true;
+}
+
+// Evict until the LVGL heap has min_free bytes
+void ui_screen_cache_trim(size_t min_free)
+{
+    while (true) {
+        lv_mem_monitor_t mon;
+        lv_mem_monitor(&mon);
+        if (mon.free_size >= min_free) {
+            break;
+        }
+
+        cache_entry_t *victim = lru_victim();
+        if (victim == NULL) {
+            break;
+        }
+        evict(victim);
+    }
+}
+
+// Drop all detached screens
+void ui_screen_cache_clear(void)
+{
+    cache_entry_t *victim;
+    while ((victim = lru_victim()) != NULL) {
+        evict(victim);
+    }
+}
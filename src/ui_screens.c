@@ -5,6 +5,16 @@
 #include "weather_api.h"
 #include "ntp_client.h"
 #include "api_tokens.h"
+#include "ui_vlist.h"
+#include "ui_theme.h"
+#include "ui_screen_cache.h"
+#include "event_bus.h"
+#include "lv_port_draw_core1.h"
+#include "lv_port_disp_picocalc_ILI9488.h"
+#include "psram_helper.h"
+#include "bench.h"
+#include "console.h"
+#include "log.h"
 #include <stdio.h>
 #include <string.h>
 
@@ -28,7 +38,7 @@ static void ble_menu_btn_event(lv_event_t *e);
 static void ble_back_btn_event(lv_event_t *e);
 static void news_feed_btn_event(lv_event_t *e);
 static void news_back_btn_event(lv_event_t *e);
-static void news_article_clicked_event(lv_event_t *e);
+static void news_article_selected(lv_obj_t *vlist, uint32_t index, void *user_data);
 static void telegram_btn_event(lv_event_t *e);
 static void telegram_back_btn_event(lv_event_t *e);
 static void telegram_send_btn_event(lv_event_t *e);
@@ -41,11 +51,21 @@ static void weather_submit_city_event(lv_event_t *e);
 static void weather_input_key_event(lv_event_t *e);
 static void weather_refresh_btn_event(lv_event_t *e);
 static void weather_view_map_btn_event(lv_event_t *e);
-static void weather_update_timer_cb(lv_timer_t *timer);
+static void benchmarks_btn_event(lv_event_t *e);
+static void benchmarks_run_btn_event(lv_event_t *e);
+static void benchmarks_back_btn_event(lv_event_t *e);
+static void weather_event_handler(const app_event_t *event, void *user_data);
+static void news_event_handler(const app_event_t *event, void *user_data);
+static void telegram_event_handler(const app_event_t *event, void *user_data);
+static void rebind_main_app_screen(ui_context_t *ctx);
+static void ui_command(int argc, char **argv);
 
 // Global UI context pointer for event handlers
 static ui_context_t *g_ui_ctx = NULL;
 
+// LVGL heap each state's screen took when it was last built ("ui theme")
+static size_t g_screen_heap[APP_STATE_BENCHMARKS + 1];
+
 // Global widgets that need to be accessed across functions
 static lv_obj_t *password_ta = NULL;
 static lv_obj_t *status_label = NULL;
@@ -53,124 +73,153 @@ static lv_obj_t *sps_rx_textarea = NULL;  // For displaying received SPS data
 static lv_obj_t *sps_tx_textarea = NULL;  // For entering data to send via SPS
 static lv_obj_t *news_list = NULL;        // For displaying news articles
 static lv_obj_t *news_status_label = NULL; // For news loading status
-static lv_timer_t *news_update_timer = NULL; // Timer for updating news display
 static lv_obj_t *time_label = NULL;       // For displaying current time
 static lv_timer_t *time_update_timer = NULL; // Timer for updating time display
-static uint8_t news_article_indices[MAX_NEWS_ARTICLES]; // Store article indices for click handlers
-static lv_obj_t *news_article_buttons[MAX_NEWS_ARTICLES]; // Store button references for focus restoration
 static lv_obj_t *news_ticker_label = NULL;  // For displaying scrolling news title on main screen
+static lv_obj_t *main_time_label = NULL;    // Main screen widgets, kept while the screen is cached
+static lv_obj_t *main_ticker_label = NULL;
+static lv_obj_t *main_wifi_status_label = NULL;
 static lv_obj_t *telegram_list = NULL;     // For displaying telegram messages
 static lv_obj_t *telegram_input_ta = NULL; // For message input
 static lv_obj_t *telegram_status_label = NULL; // For telegram status messages
-static lv_timer_t *telegram_update_timer = NULL; // Timer for polling updates
+static lv_timer_t *telegram_poll_timer = NULL; // Timer for polling updates
+#define TELEGRAM_HISTORY_MAX 200            // Messages kept for the list; oldest are trimmed
+static telegram_message_t *telegram_history = NULL; // Ring of shown messages (PSRAM), oldest first
+static uint16_t telegram_history_start = 0;
+static uint16_t telegram_history_count = 0;
+static uint32_t telegram_redraw_px = 0;     // Area invalidated during a list update
 static lv_obj_t *weather_city_input_ta = NULL; // For city name input
 static lv_obj_t *weather_loading_label = NULL; // For loading status
 static lv_obj_t *weather_detail_label = NULL;  // For loading details
-static lv_timer_t *weather_update_timer = NULL; // Timer for checking weather state
-
-// ============================================================================
-// MODERN THEME STYLING SYSTEM
-// ============================================================================
-
-// Color palette - Modern dark theme with orange text
-#define THEME_BG_PRIMARY     0x1a1a1a  // Screen background (darkest)
-#define THEME_BG_SECONDARY   0x242424  // Container/list background
-#define THEME_BG_TERTIARY    0x2d2d2d  // Input/card background
-#define THEME_BG_BUTTON      0x3d3d3d  // Button background
-#define THEME_BORDER_LIGHT   0x4a4a4a  // Subtle borders
-#define THEME_BORDER_NORMAL  0x3d3d3d  // Standard borders
-#define THEME_TEXT_PRIMARY   0xffa726  // Titles/headers (bright orange)
-#define THEME_TEXT_SECONDARY 0xff9800  // Body text (orange)
-#define THEME_TEXT_TERTIARY  0xff8a65  // Status/muted text (soft orange)
-#define THEME_TEXT_DISABLED  0xcc7a52  // Placeholder text (muted orange)
-#define THEME_ACCENT_SUCCESS 0x4caf50  // Success states (green)
-#define THEME_ACCENT_ERROR   0xf44336  // Error states (red)
-
-// Font hierarchy (Montserrat, minimum 12px for body text)
-#define FONT_TITLE &lv_font_montserrat_14  // Screen titles
-#define FONT_BODY  &lv_font_montserrat_12  // Body text, labels, buttons
-#define FONT_SMALL &lv_font_montserrat_10  // Small details (use sparingly)
-
-// Spacing constants
-#define PADDING_SMALL  5
-#define PADDING_NORMAL 10
-#define PADDING_LARGE  20
-#define BORDER_THIN    1
-
-// Styling helper functions for consistent appearance across screens
+static lv_obj_t *bench_results_ta = NULL;      // Benchmark results log
+static lv_obj_t *bench_status_label = NULL;    // Benchmark progress
+static lv_timer_t *bench_timer = NULL;         // Steps through the benchmark tests
+static int bench_next_test = 0;
+
+// Styling helper functions for consistent appearance across screens.
+// They attach the shared theme styles (see ui_theme.c) rather than setting
+// local style properties on every widget.
 static void apply_screen_style(lv_obj_t *screen) {
-    lv_obj_set_style_bg_color(screen, lv_color_hex(THEME_BG_PRIMARY), 0);
+    lv_obj_add_style(screen, ui_theme_style(UI_STYLE_SCREEN), 0);
 }
 
 static void apply_title_style(lv_obj_t *label) {
-    lv_obj_set_style_text_font(label, FONT_TITLE, 0);
-    lv_obj_set_style_text_color(label, lv_color_hex(THEME_TEXT_PRIMARY), 0);
+    lv_obj_add_style(label, ui_theme_style(UI_STYLE_TITLE), 0);
 }
 
 static void apply_body_style(lv_obj_t *label) {
-    lv_obj_set_style_text_font(label, FONT_BODY, 0);
-    lv_obj_set_style_text_color(label, lv_color_hex(THEME_TEXT_SECONDARY), 0);
+    lv_obj_add_style(label, ui_theme_style(UI_STYLE_BODY), 0);
 }
 
 static void apply_status_style(lv_obj_t *label) {
-    lv_obj_set_style_text_font(label, FONT_BODY, 0);
-    lv_obj_set_style_text_color(label, lv_color_hex(THEME_TEXT_TERTIARY), 0);
+    lv_obj_add_style(label, ui_theme_style(UI_STYLE_STATUS), 0);
 }
 
 static void apply_button_style(lv_obj_t *btn) {
-    lv_obj_set_style_bg_color(btn, lv_color_hex(THEME_BG_BUTTON), 0);
-    lv_obj_set_style_radius(btn, 5, 0);
+    lv_obj_add_style(btn, ui_theme_style(UI_STYLE_BUTTON), 0);
 }
 
 static void apply_button_label_style(lv_obj_t *label) {
-    lv_obj_set_style_text_font(label, FONT_BODY, 0);
-    lv_obj_set_style_text_color(label, lv_color_hex(THEME_TEXT_SECONDARY), 0);
+    lv_obj_add_style(label, ui_theme_style(UI_STYLE_BUTTON_LABEL), 0);
 }
 
 static void apply_textarea_style(lv_obj_t *ta) {
-    lv_obj_set_style_bg_color(ta, lv_color_hex(THEME_BG_TERTIARY), 0);
-    lv_obj_set_style_border_color(ta, lv_color_hex(THEME_BORDER_LIGHT), 0);
-    lv_obj_set_style_border_width(ta, BORDER_THIN, 0);
-    lv_obj_set_style_radius(ta, 4, 0);
-    lv_obj_set_style_text_font(ta, FONT_BODY, 0);
-    lv_obj_set_style_text_color(ta, lv_color_hex(THEME_TEXT_SECONDARY), 0);
-    lv_obj_set_style_pad_all(ta, PADDING_SMALL, 0);
+    lv_obj_add_style(ta, ui_theme_style(UI_STYLE_TEXTAREA), 0);
 }
 
 static void apply_dropdown_style(lv_obj_t *dd) {
-    // Style the dropdown button (closed state)
-    lv_obj_set_style_bg_color(dd, lv_color_hex(THEME_BG_TERTIARY), 0);
-    lv_obj_set_style_border_color(dd, lv_color_hex(THEME_BORDER_LIGHT), 0);
-    lv_obj_set_style_border_width(dd, BORDER_THIN, 0);
-    lv_obj_set_style_radius(dd, 4, 0);
-    lv_obj_set_style_text_font(dd, FONT_BODY, 0);
-    lv_obj_set_style_text_color(dd, lv_color_hex(THEME_TEXT_SECONDARY), 0);
-    lv_obj_set_style_pad_left(dd, PADDING_SMALL, 0);
-    lv_obj_set_style_pad_right(dd, PADDING_SMALL, 0);
-
-    // Style the dropdown list (opened state)
+    lv_obj_add_style(dd, ui_theme_style(UI_STYLE_DROPDOWN), 0);
+
     lv_obj_t *list = lv_dropdown_get_list(dd);
     if (list != NULL) {
-        lv_obj_set_style_bg_color(list, lv_color_hex(THEME_BG_SECONDARY), 0);
-        lv_obj_set_style_border_color(list, lv_color_hex(THEME_BORDER_LIGHT), 0);
-        lv_obj_set_style_border_width(list, 2, 0);
-        lv_obj_set_style_radius(list, 4, 0);
-        lv_obj_set_style_text_font(list, FONT_BODY, 0);
-        lv_obj_set_style_text_color(list, lv_color_hex(THEME_TEXT_SECONDARY), 0);
-        lv_obj_set_style_pad_all(list, PADDING_SMALL, 0);
-
-        // Style selected/highlighted items - orange background with black text
-        lv_obj_set_style_bg_color(list, lv_color_hex(THEME_TEXT_PRIMARY), LV_PART_SELECTED);
-        lv_obj_set_style_bg_opa(list, LV_OPA_COVER, LV_PART_SELECTED);
-        lv_obj_set_style_text_color(list, lv_color_hex(0x000000), LV_PART_SELECTED);
+        lv_obj_add_style(list, ui_theme_style(UI_STYLE_DROPDOWN_LIST), 0);
+        lv_obj_add_style(list, ui_theme_style(UI_STYLE_DROPDOWN_SELECTED), LV_PART_SELECTED);
     }
 }
 
+static void apply_vlist_style(lv_obj_t *vlist) {
+    lv_obj_add_style(vlist, ui_theme_style(UI_STYLE_LIST), 0);
+    lv_obj_add_style(vlist, ui_theme_style(UI_STYLE_FOCUSED), LV_STATE_FOCUS_KEY);
+    lv_obj_add_style(ui_vlist_get_viewport(vlist), ui_theme_style(UI_STYLE_LIST_SCROLLBAR),
+                     LV_PART_SCROLLBAR);
+}
+
+// Pooled vlist row: card look, selected row is orange with black text.
+// The label inherits text color and font from the row.
+static void apply_list_row_style(lv_obj_t *row, lv_obj_t *label) {
+    lv_obj_add_style(row, ui_theme_style(UI_STYLE_LIST_ROW), 0);
+    lv_obj_add_style(row, ui_theme_style(UI_STYLE_LIST_ROW_SELECTED), LV_STATE_CHECKED);
+}
+
 // Initialize UI system
 void ui_init(ui_context_t *ctx) {
     memset(ctx, 0, sizeof(ui_context_t));
     ctx->current_state = APP_STATE_INIT;
     g_ui_ctx = ctx;
+    ui_theme_init();
+    console_register("ui", ui_command, "ui theme | ui frame");
+}
+
+// Screens that only show static content or data re-bound on entry.
+// Screens that start fetches or scans when built are always rebuilt.
+static bool screen_is_cacheable(app_state_t state)
+{
+    return state == APP_STATE_MAIN_APP || state == APP_STATE_WEATHER_CITY_SELECT;
+}
+
+// Refresh the data shown by a screen taken from the cache
+static void rebind_cached_screen(ui_context_t *ctx, app_state_t state)
+{
+    if (state == APP_STATE_MAIN_APP)
+    {
+        rebind_main_app_screen(ctx);
+    }
+}
+
+// Build the screen for a state (NULL for states without a screen)
+static lv_obj_t *create_screen_for_state(ui_context_t *ctx, app_state_t state)
+{
+    switch (state)
+    {
+        case APP_STATE_INIT:
+            return create_splash_screen(ctx);
+        case APP_STATE_WIFI_SCAN:
+            return create_wifi_scan_screen(ctx);
+        case APP_STATE_WIFI_PASSWORD:
+            return create_password_screen(ctx);
+        case APP_STATE_WIFI_CONNECTING:
+        case APP_STATE_AUTO_CONNECT:
+            return create_connecting_screen(ctx);
+        case APP_STATE_WIFI_ERROR:
+        case APP_STATE_BLE_ERROR:
+            return create_error_screen(ctx);
+        case APP_STATE_MAIN_APP:
+            return create_main_app_screen(ctx);
+        case APP_STATE_BLE_SCAN:
+            return create_ble_scan_screen(ctx);
+        case APP_STATE_BLE_CONNECTING:
+            return create_ble_connecting_screen(ctx);
+        case APP_STATE_SPS_DATA:
+            return create_sps_data_screen(ctx);
+        case APP_STATE_NEWS_FEED:
+            return create_news_feed_screen(ctx);
+        case APP_STATE_TELEGRAM:
+            return create_telegram_screen(ctx);
+        case APP_STATE_WEATHER_CITY_SELECT:
+            return create_weather_city_select_screen(ctx);
+        case APP_STATE_WEATHER_CUSTOM_INPUT:
+            return create_weather_custom_input_screen(ctx);
+        case APP_STATE_WEATHER_LOADING:
+            return create_weather_loading_screen(ctx);
+        case APP_STATE_WEATHER_DISPLAY:
+            return create_weather_display_screen(ctx);
+        case APP_STATE_WEATHER_MAP:
+            return create_weather_map_screen(ctx);
+        case APP_STATE_BENCHMARKS:
+            return create_benchmarks_screen(ctx);
+        default:
+            return NULL;
+    }
 }
 
 // Transition to a new state
@@ -181,15 +230,21 @@ void transition_to_state(ui_context_t *ctx, app_state_t new_state)
         lv_timer_del(time_update_timer);
         time_update_timer = NULL;
     }
-    if (news_update_timer != NULL) {
-        lv_timer_del(news_update_timer);
-        news_update_timer = NULL;
+    if (telegram_poll_timer != NULL) {
+        lv_timer_del(telegram_poll_timer);
+        telegram_poll_timer = NULL;
     }
-    if (telegram_update_timer != NULL) {
-        lv_timer_del(telegram_update_timer);
-        telegram_update_timer = NULL;
+    if (bench_timer != NULL) {
+        lv_timer_del(bench_timer);
+        bench_timer = NULL;
+        bench_end();
     }
 
+    // Stop listening for network events aimed at the previous screen
+    event_bus_unsubscribe(news_event_handler);
+    event_bus_unsubscribe(telegram_event_handler);
+    event_bus_unsubscribe(weather_event_handler);
+
     // Clear global widget references
     password_ta = NULL;
     status_label = NULL;
@@ -202,85 +257,98 @@ void transition_to_state(ui_context_t *ctx, app_state_t new_state)
     telegram_list = NULL;
     telegram_input_ta = NULL;
     telegram_status_label = NULL;
-    memset(news_article_buttons, 0, sizeof(news_article_buttons));
+    telegram_history_start = 0;
+    telegram_history_count = 0;
+    bench_results_ta = NULL;
+    bench_status_label = NULL;
 
-    // Delete old screen
+    // Leave old screen: cached screens are kept, the rest are deleted
     if (ctx->current_screen != NULL)
     {
-        lv_obj_del(ctx->current_screen);
+        if (!ui_screen_cache_release(ctx->current_screen))
+        {
+            lv_obj_del(ctx->current_screen);
+        }
         ctx->current_screen = NULL;
     }
 
+    uint64_t transition_start = time_us_64();
+
+    // Reuse a cached screen if there is one, re-binding its data
+    ctx->current_screen = ui_screen_cache_get(new_state);
+    bool cache_hit = (ctx->current_screen != NULL);
+    if (cache_hit)
+    {
+        rebind_cached_screen(ctx, new_state);
+    }
+    else
+    {
+        // Make room before building when the LVGL heap runs low
+        ui_screen_cache_trim(UI_SCREEN_CACHE_MIN_FREE);
+    }
+
+    // Heap baseline for the screen cache and "ui theme"
+    lv_mem_monitor_t mem_before;
+    lv_mem_monitor(&mem_before);
+
     // Create new screen based on state
-    switch (new_state)
+    if (!cache_hit)
     {
-        case APP_STATE_INIT:
-            ctx->current_screen = create_splash_screen(ctx);
-            break;
-        case APP_STATE_WIFI_SCAN:
-            ctx->current_screen = create_wifi_scan_screen(ctx);
-            break;
-        case APP_STATE_WIFI_PASSWORD:
-            ctx->current_screen = create_password_screen(ctx);
-            break;
-        case APP_STATE_WIFI_CONNECTING:
-        case APP_STATE_AUTO_CONNECT:
-            ctx->current_screen = create_connecting_screen(ctx);
-            break;
-        case APP_STATE_WIFI_ERROR:
-        case APP_STATE_BLE_ERROR:
-            ctx->current_screen = create_error_screen(ctx);
-            break;
-        case APP_STATE_MAIN_APP:
-            ctx->current_screen = create_main_app_screen(ctx);
-            break;
-        case APP_STATE_BLE_SCAN:
-            ctx->current_screen = create_ble_scan_screen(ctx);
-            break;
-        case APP_STATE_BLE_CONNECTING:
-            ctx->current_screen = create_ble_connecting_screen(ctx);
-            break;
-        case APP_STATE_SPS_DATA:
-            ctx->current_screen = create_sps_data_screen(ctx);
-            break;
-        case APP_STATE_NEWS_FEED:
-            ctx->current_screen = create_news_feed_screen(ctx);
-            break;
-        case APP_STATE_TELEGRAM:
-            ctx->current_screen = create_telegram_screen(ctx);
-            break;
-        case APP_STATE_WEATHER_CITY_SELECT:
-            ctx->current_screen = create_weather_city_select_screen(ctx);
-            break;
-        case APP_STATE_WEATHER_CUSTOM_INPUT:
-            ctx->current_screen = create_weather_custom_input_screen(ctx);
-            break;
-        case APP_STATE_WEATHER_LOADING:
-            // Clean up previous timer if exists
-            if (weather_update_timer != NULL) {
-                lv_timer_del(weather_update_timer);
-                weather_update_timer = NULL;
-            }
-            ctx->current_screen = create_weather_loading_screen(ctx);
-            break;
-        case APP_STATE_WEATHER_DISPLAY:
-            ctx->current_screen = create_weather_display_screen(ctx);
-            break;
-        case APP_STATE_WEATHER_MAP:
-            ctx->current_screen = create_weather_map_screen(ctx);
-            break;
-        default:
+        ctx->current_screen = create_screen_for_state(ctx, new_state);
+        if (ctx->current_screen == NULL)
+        {
             return;
+        }
     }
 
     if (ctx->current_screen != NULL) 
     {
         lv_scr_load(ctx->current_screen);
+        lv_obj_update_layout(ctx->current_screen);
+
+        // Build (or re-bind) plus layout; the redraw after this is the same either way
+        printf("Transition to state %d: %s in %lu us\n", new_state,
+               cache_hit ? "cached" : "built",
+               (unsigned long)(time_us_64() - transition_start));
+
+        if (!cache_hit)
+        {
+            lv_mem_monitor_t mem_after;
+            lv_mem_monitor(&mem_after);
+            size_t heap_used = mem_before.free_size - mem_after.free_size;
+            g_screen_heap[new_state] = heap_used;
+
+            if (screen_is_cacheable(new_state))
+            {
+                ui_screen_cache_add(new_state, ctx->current_screen, heap_used);
+            }
+        }
     }
 
     ctx->current_state = new_state;
 }
 
+// Console command: ui theme | ui frame
+static void ui_command(int argc, char **argv)
+{
+    app_state_t state = g_ui_ctx->current_state;
+    char screen_name[16];
+    snprintf(screen_name, sizeof(screen_name), "state %d", state);
+
+    if (argc > 1 && strcmp(argv[1], "theme") == 0)
+    {
+        ui_theme_report_screen(lv_screen_active(), screen_name, g_screen_heap[state]);
+        return;
+    }
+    if (argc > 1 && strcmp(argv[1], "frame") == 0)
+    {
+        // Full-screen redraws with 1 and 2 draw units
+        lv_port_draw_core1_report_frame_time(screen_name);
+        return;
+    }
+    LOG_W("UI: usage: ui theme | ui frame\n");
+}
+
 // Get current state
 app_state_t get_current_state(ui_context_t *ctx) 
 {
@@ -663,22 +731,10 @@ lv_obj_t* create_main_app_screen(ui_context_t *ctx)
     lv_obj_set_style_text_align(title, LV_TEXT_ALIGN_CENTER, 0);
     lv_obj_align(title, LV_ALIGN_TOP_MID, 0, PADDING_SMALL);
 
-    // WiFi status indicator
-    lv_obj_t *wifi_status = lv_label_create(screen);
-    bool is_connected = wifi_is_connected();
-
-    if (is_connected)
-    {
-        lv_label_set_text_fmt(wifi_status, "WiFi: %s", ctx->config.ssid);
-        apply_body_style(wifi_status);
-        lv_obj_set_style_text_color(wifi_status, lv_color_hex(THEME_ACCENT_SUCCESS), 0); // Green when connected
-    }
-    else
-    {
-        lv_label_set_text(wifi_status, "WiFi: Disconnected");
-        apply_status_style(wifi_status); // Gray when disconnected
-    }
-    lv_obj_align(wifi_status, LV_ALIGN_TOP_LEFT, PADDING_SMALL, 25);
+    // WiFi status indicator (text and color set by rebind_main_app_screen)
+    main_wifi_status_label = lv_label_create(screen);
+    apply_body_style(main_wifi_status_label);
+    lv_obj_align(main_wifi_status_label, LV_ALIGN_TOP_LEFT, PADDING_SMALL, 25);
 
     // WiFi Settings button
     lv_obj_t *settings_btn = lv_btn_create(screen);
@@ -712,9 +768,9 @@ lv_obj_t* create_main_app_screen(ui_context_t *ctx)
 
     // News Feed button
     lv_obj_t *news_btn = lv_btn_create(screen);
-    lv_obj_set_size(news_btn, 300, 50);
+    lv_obj_set_size(news_btn, 300, 42);
     apply_button_style(news_btn);
-    lv_obj_align(news_btn, LV_ALIGN_TOP_MID, 0, 90);
+    lv_obj_align(news_btn, LV_ALIGN_TOP_MID, 0, 84);
     lv_obj_add_event_cb(news_btn, news_feed_btn_event, LV_EVENT_CLICKED, ctx);
 
     lv_obj_t *news_label = lv_label_create(news_btn);
@@ -724,9 +780,9 @@ lv_obj_t* create_main_app_screen(ui_context_t *ctx)
 
     // Telegram button
     lv_obj_t *telegram_btn = lv_btn_create(screen);
-    lv_obj_set_size(telegram_btn, 300, 50);
+    lv_obj_set_size(telegram_btn, 300, 42);
     apply_button_style(telegram_btn);
-    lv_obj_align(telegram_btn, LV_ALIGN_TOP_MID, 0, 150);
+    lv_obj_align(telegram_btn, LV_ALIGN_TOP_MID, 0, 132);
     lv_obj_add_event_cb(telegram_btn, telegram_btn_event, LV_EVENT_CLICKED, ctx);
 
     lv_obj_t *telegram_label = lv_label_create(telegram_btn);
@@ -736,9 +792,9 @@ lv_obj_t* create_main_app_screen(ui_context_t *ctx)
 
     // Weather button
     lv_obj_t *weather_btn = lv_btn_create(screen);
-    lv_obj_set_size(weather_btn, 300, 50);
+    lv_obj_set_size(weather_btn, 300, 42);
     apply_button_style(weather_btn);
-    lv_obj_align(weather_btn, LV_ALIGN_TOP_MID, 0, 210);
+    lv_obj_align(weather_btn, LV_ALIGN_TOP_MID, 0, 180);
     lv_obj_add_event_cb(weather_btn, weather_btn_event, LV_EVENT_CLICKED, ctx);
 
     lv_obj_t *weather_label = lv_label_create(weather_btn);
@@ -746,24 +802,58 @@ lv_obj_t* create_main_app_screen(ui_context_t *ctx)
     apply_button_label_style(weather_label);
     lv_obj_center(weather_label);
 
+    // Benchmarks button
+    lv_obj_t *bench_btn = lv_btn_create(screen);
+    lv_obj_set_size(bench_btn, 300, 42);
+    apply_button_style(bench_btn);
+    lv_obj_align(bench_btn, LV_ALIGN_TOP_MID, 0, 228);
+    lv_obj_add_event_cb(bench_btn, benchmarks_btn_event, LV_EVENT_CLICKED, ctx);
+
+    lv_obj_t *bench_label = lv_label_create(bench_btn);
+    lv_label_set_text(bench_label, "Benchmarks");
+    apply_button_label_style(bench_label);
+    lv_obj_center(bench_label);
+
     // Time display in bottom-right corner
-    time_label = lv_label_create(screen);
-    lv_label_set_text(time_label, "--:--:--");
-    apply_status_style(time_label);
-    lv_obj_align(time_label, LV_ALIGN_BOTTOM_RIGHT, -PADDING_SMALL, -PADDING_SMALL);
+    main_time_label = lv_label_create(screen);
+    lv_label_set_text(main_time_label, "--:--:--");
+    apply_status_style(main_time_label);
+    lv_obj_align(main_time_label, LV_ALIGN_BOTTOM_RIGHT, -PADDING_SMALL, -PADDING_SMALL);
 
     // News ticker label (scrolling news title next to clock)
-    news_ticker_label = lv_label_create(screen);
-    apply_status_style(news_ticker_label);
-    lv_label_set_long_mode(news_ticker_label, LV_LABEL_LONG_SCROLL_CIRCULAR);
-    lv_obj_set_width(news_ticker_label, 190);  // Leave space for time on the right
-    lv_obj_align(news_ticker_label, LV_ALIGN_BOTTOM_LEFT, PADDING_SMALL, -PADDING_SMALL);
+    main_ticker_label = lv_label_create(screen);
+    apply_status_style(main_ticker_label);
+    lv_label_set_long_mode(main_ticker_label, LV_LABEL_LONG_SCROLL_CIRCULAR);
+    lv_obj_set_width(main_ticker_label, 190);  // Leave space for time on the right
+    lv_obj_align(main_ticker_label, LV_ALIGN_BOTTOM_LEFT, PADDING_SMALL, -PADDING_SMALL);
+
+    rebind_main_app_screen(ctx);
+
+    return screen;
+}
+
+// Bind the main app screen to current data (on creation and on cache re-entry)
+static void rebind_main_app_screen(ui_context_t *ctx)
+{
+    time_label = main_time_label;
+    news_ticker_label = main_ticker_label;
+
+    if (wifi_is_connected())
+    {
+        lv_label_set_text_fmt(main_wifi_status_label, "WiFi: %s", ctx->config.ssid);
+        lv_obj_set_style_text_color(main_wifi_status_label, lv_color_hex(THEME_ACCENT_SUCCESS), 0); // Green when connected
+    }
+    else
+    {
+        lv_label_set_text(main_wifi_status_label, "WiFi: Disconnected");
+        lv_obj_set_style_text_color(main_wifi_status_label, lv_color_hex(THEME_TEXT_TERTIARY), 0); // Muted when disconnected
+    }
 
     // Check if there's news data available
     news_data_t *news_data = news_api_get_data();
     if (news_data != NULL && news_data->state == NEWS_STATE_SUCCESS && news_data->count > 0) {
         // Display the first article's title
-        lv_label_set_text(news_ticker_label, news_data->articles[0].title);
+        lv_label_set_text(news_ticker_label, news_article_title(news_data, 0));
     } else {
         // No news available
         lv_label_set_text(news_ticker_label, "");
@@ -774,8 +864,7 @@ lv_obj_t* create_main_app_screen(ui_context_t *ctx)
         lv_timer_del(time_update_timer);
     }
     time_update_timer = lv_timer_create(time_update_timer_cb, 1000, NULL);
-
-    return screen;
+    time_update_timer_cb(time_update_timer);
 }
 
 // Update connection status
@@ -1322,6 +1411,8 @@ lv_obj_t* create_sps_data_screen(ui_context_t *ctx)
     lv_textarea_set_text(sps_rx_textarea, "");
     lv_textarea_set_placeholder_text(sps_rx_textarea, "Waiting for data...");
     lv_obj_add_flag(sps_rx_textarea, LV_OBJ_FLAG_SCROLL_ON_FOCUS);
+    // Incoming data scrolls the log with the panel's hardware scrolling
+    lv_port_disp_hw_scroll_attach(sps_rx_textarea);
 
     // TX data (send to device) - editable text area
     lv_obj_t *tx_label = lv_label_create(screen);
@@ -1558,11 +1649,11 @@ static void news_back_btn_event(lv_event_t *e)
     transition_to_state(ctx, APP_STATE_MAIN_APP);
 }
 
-// Event handler: News popup close button clicked
-static void news_popup_close_event(lv_event_t *e)
+// Event handler: List item popup close button clicked
+static void list_popup_close_event(lv_event_t *e)
 {
     lv_obj_t *btn = lv_event_get_target(e);
-    lv_obj_t *clicked_article_btn = (lv_obj_t *)lv_event_get_user_data(e);
+    lv_obj_t *list = (lv_obj_t *)lv_event_get_user_data(e);
 
     // Find and close the msgbox
     lv_obj_t *mbox = btn;
@@ -1573,51 +1664,24 @@ static void news_popup_close_event(lv_event_t *e)
         lv_msgbox_close(mbox);
     }
 
-    // Restore focus to the article button that was clicked
-    if (clicked_article_btn != NULL) {
+    // Restore focus to the list the popup was opened from
+    if (list != NULL) {
         lv_group_t *group = lv_group_get_default();
         if (group != NULL) {
-            lv_group_focus_obj(clicked_article_btn);
-        }
-    }
-}
-
-// Event handler: News article clicked
-// Event handler to change label text color when button is focused/unfocused
-static void news_item_focus_event(lv_event_t *e)
-{
-    lv_event_code_t code = lv_event_get_code(e);
-    lv_obj_t *btn = lv_event_get_target(e);
-
-    // Find the label child - iterate through all children
-    uint32_t child_count = lv_obj_get_child_count(btn);
-    for (uint32_t i = 0; i < child_count; i++) {
-        lv_obj_t *child = lv_obj_get_child(btn, i);
-        if (child && lv_obj_check_type(child, &lv_label_class)) {
-            if (code == LV_EVENT_FOCUSED) {
-                // Button is focused - set label text to black
-                lv_obj_set_style_text_color(child, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT);
-            } else if (code == LV_EVENT_DEFOCUSED) {
-                // Button lost focus - restore orange text
-                lv_obj_set_style_text_color(child, lv_color_hex(THEME_TEXT_SECONDARY), LV_PART_MAIN | LV_STATE_DEFAULT);
-            }
+            lv_group_focus_obj(list);
         }
     }
 }
 
-static void news_article_clicked_event(lv_event_t *e)
+// Event handler: News article selected (Enter on a list row)
+static void news_article_selected(lv_obj_t *vlist, uint32_t index, void *user_data)
 {
-    // Get the article index from user data
-    uint8_t *article_idx = (uint8_t *)lv_event_get_user_data(e);
-    if (article_idx == NULL) return;
-
     news_data_t *news_data = news_api_get_data();
-    if (*article_idx >= news_data->count) return;
+    if (index >= news_data->count) return;
 
-    news_article_t *article = &news_data->articles[*article_idx];
-
-    // Store which button was clicked for focus restoration
-    lv_obj_t *clicked_btn = lv_event_get_target(e);
+    const char *title = news_article_title(news_data, index);
+    const char *source = news_article_source(news_data, index);
+    const char *description = news_article_description(news_data, index);
 
     // Create message box to show article details
     lv_obj_t *mbox = lv_msgbox_create(NULL);
@@ -1632,8 +1696,8 @@ static void news_article_clicked_event(lv_event_t *e)
     lv_obj_set_style_radius(mbox, 6, 0);
 
     // Set title (source)
-    if (strlen(article->source) > 0) {
-        lv_msgbox_add_title(mbox, article->source);
+    if (source[0] != '\0') {
+        lv_msgbox_add_title(mbox, source);
     } else {
         lv_msgbox_add_title(mbox, "News Article");
     }
@@ -1651,12 +1715,10 @@ static void news_article_clicked_event(lv_event_t *e)
 
     // Build content text with title and description
     char content[NEWS_TITLE_MAX_LEN + NEWS_DESCRIPTION_MAX_LEN + 10];
-    if (strlen(article->description) > 0) {
-        snprintf(content, sizeof(content), "%s\n\n%s",
-                 article->title, article->description);
+    if (description[0] != '\0') {
+        snprintf(content, sizeof(content), "%s\n\n%s", title, description);
     } else {
-        snprintf(content, sizeof(content), "%s\n\n(No description available)",
-                 article->title);
+        snprintf(content, sizeof(content), "%s\n\n(No description available)", title);
     }
 
     lv_obj_t *text_obj = lv_msgbox_add_text(mbox, content);
@@ -1681,7 +1743,7 @@ static void news_article_clicked_event(lv_event_t *e)
     if (close_btn != NULL) {
         lv_obj_set_style_text_color(close_btn, lv_color_hex(THEME_TEXT_PRIMARY), 0);
         lv_obj_set_style_text_font(close_btn, FONT_TITLE, 0);
-        lv_obj_add_event_cb(close_btn, news_popup_close_event, LV_EVENT_CLICKED, clicked_btn);
+        lv_obj_add_event_cb(close_btn, list_popup_close_event, LV_EVENT_CLICKED, vlist);
     }
 
     lv_obj_center(mbox);
@@ -1695,93 +1757,52 @@ static void news_article_clicked_event(lv_event_t *e)
         }
     }
 
-    printf("Showing article %d: %s\n", *article_idx, article->title);
+    printf("Showing article %lu: %s\n", (unsigned long)index, title);
 }
 
 // =============================================================================
 // News Feed Screen Implementation
 // =============================================================================
 
-// Timer callback to update news display
-static void news_update_timer_cb(lv_timer_t *timer)
+// News list data source: bind a row to the article's headline (no copy)
+static void news_row_bind(lv_obj_t *label, uint32_t index, void *user_data)
 {
     news_data_t *news_data = news_api_get_data();
+    if (index < news_data->count) {
+        lv_label_set_text_static(label, news_article_headline(news_data, index));
+    }
+}
 
-    if (news_data->state == NEWS_STATE_SUCCESS && news_list != NULL && news_status_label != NULL) {
-        // Hide status label
-        lv_obj_add_flag(news_status_label, LV_OBJ_FLAG_HIDDEN);
+// News event: show the articles (or the error) as soon as the fetch ends
+static void news_event_handler(const app_event_t *event, void *user_data)
+{
+    news_data_t *news_data = news_api_get_data();
 
-        // Clear the list
-        lv_obj_clean(news_list);
-
-        // Add news articles to the list with improved styling
-        for (uint8_t i = 0; i < news_data->count; i++) {
-            // Store article index for click handler
-            news_article_indices[i] = i;
-
-            // Create a button for each news item
-            lv_obj_t *btn = lv_list_add_button(news_list, NULL, "");
-            lv_obj_set_style_pad_ver(btn, 4, 0);
-            lv_obj_set_style_bg_color(btn, lv_color_hex(THEME_BG_TERTIARY), 0);
-            lv_obj_set_style_bg_opa(btn, LV_OPA_COVER, 0);
-            lv_obj_set_style_radius(btn, 4, 0);
-            lv_obj_set_style_border_width(btn, 1, 0);
-            lv_obj_set_style_border_color(btn, lv_color_hex(THEME_BORDER_LIGHT), 0);
-
-            // Style focused state - orange background (text color handled by event)
-            lv_obj_set_style_bg_color(btn, lv_color_hex(THEME_TEXT_PRIMARY), LV_STATE_FOCUS_KEY);
-            lv_obj_set_style_bg_opa(btn, LV_OPA_COVER, LV_STATE_FOCUS_KEY);
-            lv_obj_set_style_border_color(btn, lv_color_hex(THEME_TEXT_PRIMARY), LV_STATE_FOCUS_KEY);
-
-            // Add event handlers
-            lv_obj_add_event_cb(btn, news_article_clicked_event, LV_EVENT_CLICKED, &news_article_indices[i]);
-            lv_obj_add_event_cb(btn, news_item_focus_event, LV_EVENT_FOCUSED, NULL);
-            lv_obj_add_event_cb(btn, news_item_focus_event, LV_EVENT_DEFOCUSED, NULL);
-
-            // Create label for the news item
-            lv_obj_t *label = lv_label_create(btn);
-
-            // Build the text with source and title
-            char item_text[256];
-            if (strlen(news_data->articles[i].source) > 0) {
-                snprintf(item_text, sizeof(item_text), "[%s]\n%s",
-                         news_data->articles[i].source,
-                         news_data->articles[i].title);
-            } else {
-                snprintf(item_text, sizeof(item_text), "%s",
-                         news_data->articles[i].title);
-            }
+    if (news_list == NULL || news_status_label == NULL) {
+        return;
+    }
 
-            lv_label_set_text(label, item_text);
-            lv_label_set_long_mode(label, LV_LABEL_LONG_WRAP);
-            lv_obj_set_width(label, 270);
-            lv_obj_set_style_text_font(label, FONT_BODY, 0);
-            lv_obj_set_style_text_color(label, lv_color_hex(THEME_TEXT_SECONDARY), 0);
-            lv_obj_set_style_pad_all(label, 2, 0);
-        }
+    if (event->type == EVENT_FETCH_PROGRESS) {
+        lv_label_set_text_fmt(news_status_label, "Loading news... %lu KB",
+                              (unsigned long)(event->bytes / 1024));
+    } else if (event->type == EVENT_FETCH_COMPLETED) {
+        // Hide status label
+        lv_obj_add_flag(news_status_label, LV_OBJ_FLAG_HIDDEN);
 
-        // Stop the timer
-        if (news_update_timer != NULL) {
-            lv_timer_del(news_update_timer);
-            news_update_timer = NULL;
-        }
+        // Rows bind to the article store on demand
+        ui_vlist_set_count(news_list, news_data->count);
+        ui_vlist_refresh(news_list);
+        ui_vlist_set_selected(news_list, 0);
 
         printf("News display updated with %d articles\n", news_data->count);
 
-    } else if (news_data->state == NEWS_STATE_ERROR && news_status_label != NULL) {
+    } else if (event->type == EVENT_FETCH_ERROR) {
         // Show error message
         lv_label_set_text(news_status_label, news_data->error_message);
         lv_obj_set_style_text_font(news_status_label, FONT_BODY, 0);
 
-        // Stop the timer
-        if (news_update_timer != NULL) {
-            lv_timer_del(news_update_timer);
-            news_update_timer = NULL;
-        }
-
         printf("News fetch error: %s\n", news_data->error_message);
     }
-    // If still fetching, timer will continue running
 }
 
 lv_obj_t* create_news_feed_screen(ui_context_t *ctx)
@@ -1814,22 +1835,18 @@ lv_obj_t* create_news_feed_screen(ui_context_t *ctx)
     apply_status_style(news_status_label);
     lv_obj_align(news_status_label, LV_ALIGN_CENTER, 0, -50);
 
-    // List for news articles
-    news_list = lv_list_create(screen);
+    // Virtualized list for news articles ("[source]" line plus two title lines)
+    ui_vlist_config_t list_config = {
+        .row_height = 56,
+        .bind_cb = news_row_bind,
+        .select_cb = news_article_selected,
+        .row_init_cb = apply_list_row_style,
+        .user_data = NULL,
+    };
+    news_list = ui_vlist_create(screen, &list_config);
     lv_obj_set_size(news_list, 300, 220);
     lv_obj_align(news_list, LV_ALIGN_BOTTOM_MID, 0, -PADDING_NORMAL);
-    lv_obj_set_style_bg_color(news_list, lv_color_hex(THEME_BG_SECONDARY), 0);
-    lv_obj_set_style_border_width(news_list, 2, 0);
-    lv_obj_set_style_border_color(news_list, lv_color_hex(THEME_BORDER_NORMAL), 0);
-    lv_obj_set_style_radius(news_list, 6, 0);
-
-    // Style the scrollbar - orange
-    lv_obj_set_style_bg_color(news_list, lv_color_hex(THEME_TEXT_PRIMARY), LV_PART_SCROLLBAR);
-    lv_obj_set_style_bg_opa(news_list, LV_OPA_COVER, LV_PART_SCROLLBAR);
-    lv_obj_set_style_width(news_list, 8, LV_PART_SCROLLBAR);
-    lv_obj_set_style_radius(news_list, 4, LV_PART_SCROLLBAR);
-
-    lv_obj_set_style_pad_all(news_list, PADDING_SMALL, 0);
+    apply_vlist_style(news_list);
 
     // Add widgets to keyboard navigation group for arrow key scrolling
     // The back button is added first, then the news list is added and focused
@@ -1864,14 +1881,12 @@ lv_obj_t* create_news_feed_screen(ui_context_t *ctx)
         lv_obj_set_style_text_font(placeholder, FONT_BODY, 0);
         lv_obj_set_style_text_color(placeholder, lv_color_hex(THEME_TEXT_DISABLED), 0);
 
+        // The list fills in when the news module reports the fetch is done
+        event_bus_unsubscribe(news_event_handler);
+        event_bus_subscribe(EVENT_SOURCE_NEWS, news_event_handler, NULL);
+
         // Start fetching news (country code: us = United States)
         news_api_fetch_headlines(api_key, "us");
-
-        // Start update timer (check every 500ms)
-        if (news_update_timer != NULL) {
-            lv_timer_del(news_update_timer);
-        }
-        news_update_timer = lv_timer_create(news_update_timer_cb, 500, NULL);
     }
 
     return screen;
@@ -1945,8 +1960,123 @@ static void telegram_input_key_event(lv_event_t *e)
     }
 }
 
-// Timer callback: Update telegram message list
-static void telegram_update_timer_cb(lv_timer_t *timer)
+// Display event: accumulate the area invalidated while the message list updates
+static void telegram_invalidate_event(lv_event_t *e)
+{
+    const lv_area_t *area = (const lv_area_t *)lv_event_get_param(e);
+    if (area != NULL) {
+        telegram_redraw_px += lv_area_get_size(area);
+    }
+}
+
+// Message shown by list row index (0 = oldest)
+static telegram_message_t *telegram_history_at(uint32_t index)
+{
+    return &telegram_history[(telegram_history_start + index) % TELEGRAM_HISTORY_MAX];
+}
+
+// Check whether a message is already in the list
+static bool telegram_row_shown(int64_t message_id)
+{
+    for (uint16_t i = 0; i < telegram_history_count; i++) {
+        if (telegram_history_at(i)->message_id == message_id) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Append a message to the list history, trimming the oldest at the cap.
+// Returns true if a message was trimmed (existing row indices shifted).
+static bool telegram_append_row(const telegram_message_t *msg)
+{
+    bool trimmed = false;
+    if (telegram_history_count >= TELEGRAM_HISTORY_MAX) {
+        telegram_history_start = (telegram_history_start + 1) % TELEGRAM_HISTORY_MAX;
+        telegram_history_count--;
+        trimmed = true;
+    }
+
+    *telegram_history_at(telegram_history_count) = *msg;
+    telegram_history_count++;
+    return trimmed;
+}
+
+// Telegram list data source: "@username: message text"
+static void telegram_row_bind(lv_obj_t *label, uint32_t index, void *user_data)
+{
+    if (index >= telegram_history_count) return;
+
+    telegram_message_t *msg = telegram_history_at(index);
+    if (strlen(msg->username) > 0) {
+        lv_label_set_text_fmt(label, "@%s: %s", msg->username, msg->text);
+    } else {
+        lv_label_set_text(label, msg->text);
+    }
+}
+
+// Event handler: Telegram message selected - show the full text
+static void telegram_message_selected(lv_obj_t *vlist, uint32_t index, void *user_data)
+{
+    if (index >= telegram_history_count) return;
+
+    telegram_message_t *msg = telegram_history_at(index);
+
+    lv_obj_t *mbox = lv_msgbox_create(NULL);
+    lv_obj_set_width(mbox, 300);
+    lv_obj_set_style_bg_color(mbox, lv_color_hex(THEME_BG_TERTIARY), 0);
+    lv_obj_set_style_bg_opa(mbox, LV_OPA_COVER, 0);
+    lv_obj_set_style_border_color(mbox, lv_color_hex(THEME_BORDER_LIGHT), 0);
+    lv_obj_set_style_border_width(mbox, 2, 0);
+    lv_obj_set_style_radius(mbox, 6, 0);
+
+    char title[TELEGRAM_USERNAME_MAX + 2];
+    if (strlen(msg->username) > 0) {
+        snprintf(title, sizeof(title), "@%s", msg->username);
+    } else {
+        snprintf(title, sizeof(title), "Message");
+    }
+    lv_msgbox_add_title(mbox, title);
+
+    lv_obj_t *header = lv_msgbox_get_header(mbox);
+    if (header != NULL) {
+        lv_obj_set_style_bg_color(header, lv_color_hex(THEME_BG_TERTIARY), 0);
+        lv_obj_set_style_text_color(header, lv_color_hex(THEME_TEXT_PRIMARY), 0);
+        lv_obj_set_style_text_font(header, FONT_TITLE, 0);
+    }
+
+    lv_obj_t *text_obj = lv_msgbox_add_text(mbox, msg->text);
+    if (text_obj != NULL) {
+        apply_body_style(text_obj);
+        lv_label_set_long_mode(text_obj, LV_LABEL_LONG_WRAP);
+    }
+
+    lv_obj_t *close_btn = lv_msgbox_add_close_button(mbox);
+    if (close_btn != NULL) {
+        lv_obj_set_style_text_color(close_btn, lv_color_hex(THEME_TEXT_PRIMARY), 0);
+        lv_obj_add_event_cb(close_btn, list_popup_close_event, LV_EVENT_CLICKED, vlist);
+
+        lv_group_t *group = lv_group_get_default();
+        if (group != NULL) {
+            lv_group_add_obj(group, close_btn);
+            lv_group_focus_obj(close_btn);
+        }
+    }
+
+    lv_obj_center(mbox);
+}
+
+// Set the Telegram status text (setting the same text would still redraw the label)
+static void telegram_set_status(const char *text)
+{
+    if (telegram_status_label != NULL &&
+        strcmp(lv_label_get_text(telegram_status_label), text) != 0) {
+        lv_label_set_text(telegram_status_label, text);
+    }
+}
+
+// Telegram event: update the message list as soon as a poll or send ends
+static void telegram_event_handler(const app_event_t *event, void *user_data)
 {
     telegram_data_t *data = telegram_api_get_data();
 
@@ -1954,51 +2084,67 @@ static void telegram_update_timer_cb(lv_timer_t *timer)
         return;
     }
 
-    // Check if we need to update the UI
-    if (data->state == TELEGRAM_STATE_SUCCESS && data->message_count > 0) {
-        // Update message list
-        lv_obj_clean(telegram_list);
+    if (event->type == EVENT_FETCH_COMPLETED && data->message_count > 0 &&
+        telegram_history != NULL) {
+        // Append messages not shown yet; rows already on screen are left alone
+        lv_display_t *disp = lv_display_get_default();
+        telegram_redraw_px = 0;
+        lv_display_add_event_cb(disp, telegram_invalidate_event, LV_EVENT_INVALIDATE_AREA, NULL);
 
+        uint8_t created = 0;
+        uint8_t reused = 0;
+        bool trimmed = false;
         for (uint8_t i = 0; i < data->message_count; i++) {
-            telegram_message_t *msg = &data->messages[i];
-
-            lv_obj_t *btn = lv_list_add_button(telegram_list, NULL, "");
-            lv_obj_set_style_pad_ver(btn, 4, 0);
-
-            // Format message: "@username: message text"
-            char label_text[TELEGRAM_USERNAME_MAX + TELEGRAM_MESSAGE_TEXT_MAX + 20];
-            if (strlen(msg->username) > 0) {
-                snprintf(label_text, sizeof(label_text), "@%s: %s",
-                        msg->username, msg->text);
+            if (telegram_row_shown(data->messages[i].message_id)) {
+                reused++;
             } else {
-                snprintf(label_text, sizeof(label_text), "%s", msg->text);
+                trimmed |= telegram_append_row(&data->messages[i]);
+                created++;
             }
-
-            lv_obj_t *label = lv_label_create(btn);
-            lv_label_set_text(label, label_text);
-            lv_label_set_long_mode(label, LV_LABEL_LONG_WRAP);
-            lv_obj_set_width(label, 270);
-            apply_body_style(label);
         }
 
-        // Update status
-        if (telegram_status_label != NULL) {
-            lv_label_set_text(telegram_status_label, "Connected");
-        }
-    } else if (data->state == TELEGRAM_STATE_ERROR) {
-        // Show error
-        if (telegram_status_label != NULL) {
-            lv_label_set_text(telegram_status_label, data->error_message);
-        }
-    } else if (data->state == TELEGRAM_STATE_SENDING) {
-        if (telegram_status_label != NULL) {
-            lv_label_set_text(telegram_status_label, "Sending...");
+        if (created > 0) {
+            ui_vlist_set_count(telegram_list, telegram_history_count);
+            if (trimmed) {
+                ui_vlist_refresh(telegram_list);  // Indices shifted under the rows
+            }
+            ui_vlist_set_selected(telegram_list, telegram_history_count - 1);
+
+            // Run the layout now so the invalidations it causes are counted
+            lv_obj_update_layout(telegram_list);
         }
-    } else if (data->state == TELEGRAM_STATE_RECEIVING) {
-        if (telegram_status_label != NULL) {
-            lv_label_set_text(telegram_status_label, "Checking for messages...");
+        lv_display_remove_event_cb_with_user_data(disp, telegram_invalidate_event, NULL);
+
+        ui_vlist_stats_t stats;
+        ui_vlist_get_stats(telegram_list, &stats);
+        printf("Telegram list: %d created, %d reused, %d messages, %lu live rows, redraw %lu px\n",
+               created, reused, telegram_history_count,
+               (unsigned long)stats.rows_live, (unsigned long)telegram_redraw_px);
+
+        telegram_set_status("Connected");
+    } else if (event->type == EVENT_FETCH_COMPLETED) {
+        telegram_set_status("Connected");
+    } else if (event->type == EVENT_FETCH_ERROR) {
+        telegram_set_status(data->error_message);
+    } else if (event->type == EVENT_FETCH_STARTED) {
+        if (event->state == TELEGRAM_STATE_SENDING) {
+            telegram_set_status("Sending...");
+        } else if (telegram_status_label != NULL &&
+                   strcmp(lv_label_get_text(telegram_status_label), "Connected") != 0) {
+            // Background polls don't disturb an established "Connected"
+            telegram_set_status("Checking for messages...");
         }
     }
+}
+
+// Timer callback: poll the bot API for new messages
+static void telegram_poll_timer_cb(lv_timer_t *timer)
+{
+    telegram_data_t *data = telegram_api_get_data();
+
+    if (data == NULL) {
+        return;
+    }
 
     // Poll for new messages if active
     if (data->polling_active && data->state != TELEGRAM_STATE_SENDING &&
@@ -2039,22 +2185,27 @@ lv_obj_t* create_telegram_screen(ui_context_t *ctx)
     lv_obj_align(telegram_status_label, LV_ALIGN_TOP_MID, 0, 40);
     lv_label_set_text(telegram_status_label, "Connecting...");
 
-    // Message list
-    telegram_list = lv_list_create(screen);
+    // Message history lives in PSRAM; allocated once, reused across visits
+    if (telegram_history == NULL) {
+        telegram_history = (telegram_message_t *)psram_malloc(TELEGRAM_HISTORY_MAX * sizeof(telegram_message_t));
+        if (telegram_history == NULL) {
+            printf("Failed to allocate Telegram history from PSRAM\n");
+        }
+    }
+
+    // Virtualized message list (two lines per row, Enter shows the full text)
+    ui_vlist_config_t list_config = {
+        .row_height = 44,
+        .bind_cb = telegram_row_bind,
+        .select_cb = telegram_message_selected,
+        .row_init_cb = apply_list_row_style,
+        .user_data = NULL,
+    };
+    telegram_list = ui_vlist_create(screen, &list_config);
     lv_obj_set_size(telegram_list, 300, 180);
     lv_obj_align(telegram_list, LV_ALIGN_TOP_MID, 0, 65);
-    lv_obj_set_style_bg_color(telegram_list, lv_color_hex(THEME_BG_SECONDARY), 0);
-    lv_obj_set_style_border_width(telegram_list, 2, 0);
-    lv_obj_set_style_border_color(telegram_list, lv_color_hex(THEME_BORDER_NORMAL), 0);
-    lv_obj_set_style_radius(telegram_list, 6, 0);
-
-    // Style the scrollbar
-    lv_obj_set_style_bg_color(telegram_list, lv_color_hex(THEME_TEXT_PRIMARY), LV_PART_SCROLLBAR);
-    lv_obj_set_style_bg_opa(telegram_list, LV_OPA_COVER, LV_PART_SCROLLBAR);
-    lv_obj_set_style_width(telegram_list, 8, LV_PART_SCROLLBAR);
-    lv_obj_set_style_radius(telegram_list, 4, LV_PART_SCROLLBAR);
-
-    lv_obj_set_style_pad_all(telegram_list, PADDING_SMALL, 0);
+    apply_vlist_style(telegram_list);
+    lv_port_disp_hw_scroll_attach(ui_vlist_get_viewport(telegram_list));
 
     // Message input textarea
     telegram_input_ta = lv_textarea_create(screen);
@@ -2097,14 +2248,18 @@ lv_obj_t* create_telegram_screen(ui_context_t *ctx)
             data->polling_active = true;
         }
 
+        // Results reach the list through the event bus; the timer only polls
+        event_bus_unsubscribe(telegram_event_handler);
+        event_bus_subscribe(EVENT_SOURCE_TELEGRAM, telegram_event_handler, NULL);
+
         // Initial poll
         telegram_poll_updates(TELEGRAM_BOT_TOKEN);
 
-        // Start update timer (check every 5 seconds)
-        if (telegram_update_timer != NULL) {
-            lv_timer_del(telegram_update_timer);
+        // Start poll timer (every 5 seconds)
+        if (telegram_poll_timer != NULL) {
+            lv_timer_del(telegram_poll_timer);
         }
-        telegram_update_timer = lv_timer_create(telegram_update_timer_cb, 5000, NULL);
+        telegram_poll_timer = lv_timer_create(telegram_poll_timer_cb, 5000, NULL);
     }
 
     return screen;
@@ -2195,30 +2350,31 @@ static void weather_refresh_btn_event(lv_event_t *e)
     }
 }
 
-// Weather update timer callback (for loading screen)
-static void weather_update_timer_cb(lv_timer_t *timer)
+// Weather event handler (for loading screen)
+static void weather_event_handler(const app_event_t *event, void *user_data)
 {
-    ui_context_t *ctx = (ui_context_t*)lv_timer_get_user_data(timer);
+    ui_context_t *ctx = (ui_context_t*)user_data;
     weather_data_t *data = weather_api_get_data();
 
     if (data == NULL) return;
 
-    if (data->state == WEATHER_STATE_FETCHING_FORECAST) {
+    const char *stage = (event->state == WEATHER_STATE_FETCHING_MAP) ?
+                        "Downloading map image..." : "Fetching forecast data...";
+
+    if (event->type == EVENT_FETCH_STARTED) {
         if (weather_detail_label != NULL) {
-            lv_label_set_text(weather_detail_label, "Fetching forecast data...");
+            lv_label_set_text(weather_detail_label, stage);
         }
-    } else if (data->state == WEATHER_STATE_FETCHING_MAP) {
+    } else if (event->type == EVENT_FETCH_PROGRESS) {
         if (weather_detail_label != NULL) {
-            lv_label_set_text(weather_detail_label, "Downloading map image...");
+            lv_label_set_text_fmt(weather_detail_label, "%s %lu KB", stage,
+                                  (unsigned long)(event->bytes / 1024));
         }
-    } else if (data->state == WEATHER_STATE_SUCCESS) {
+    } else if (event->type == EVENT_FETCH_COMPLETED) {
         // Both forecast and map loaded (or map skipped)
-        lv_timer_del(weather_update_timer);
-        weather_update_timer = NULL;
         transition_to_state(ctx, APP_STATE_WEATHER_DISPLAY);
-    } else if (data->state == WEATHER_STATE_ERROR) {
-        lv_timer_del(weather_update_timer);
-        weather_update_timer = NULL;
+    } else if (event->type == EVENT_FETCH_ERROR) {
+        event_bus_unsubscribe(weather_event_handler);
 
         // Show error
         if (weather_loading_label != NULL) {
@@ -2374,11 +2530,9 @@ lv_obj_t* create_weather_loading_screen(ui_context_t *ctx)
     apply_body_style(weather_detail_label);
     lv_obj_align(weather_detail_label, LV_ALIGN_CENTER, 0, 60);
 
-    // Start update timer (check API state every 500ms)
-    if (weather_update_timer != NULL) {
-        lv_timer_del(weather_update_timer);
-    }
-    weather_update_timer = lv_timer_create(weather_update_timer_cb, 500, ctx);
+    // Move on as soon as the weather module reports the fetch is done
+    event_bus_unsubscribe(weather_event_handler);
+    event_bus_subscribe(EVENT_SOURCE_WEATHER, weather_event_handler, ctx);
 
     return screen;
 }
@@ -2632,3 +2786,130 @@ lv_obj_t* create_weather_map_screen(ui_context_t *ctx)
 
     return screen;
 }
+
+// ============================================================================
+// BENCHMARKS
+// ============================================================================
+
+// Benchmarks button event (from main menu)
+static void benchmarks_btn_event(lv_event_t *e)
+{
+    ui_context_t *ctx = (ui_context_t *)lv_event_get_user_data(e);
+    transition_to_state(ctx, APP_STATE_BENCHMARKS);
+}
+
+// Benchmarks back button event
+static void benchmarks_back_btn_event(lv_event_t *e)
+{
+    ui_context_t *ctx = (ui_context_t *)lv_event_get_user_data(e);
+    transition_to_state(ctx, APP_STATE_MAIN_APP);
+}
+
+// Benchmark result: one line per metric in the results log
+static void benchmarks_result(const char *test, const char *metric, float value,
+                              const char *unit, void *user_data)
+{
+    (void)user_data;
+    if (bench_results_ta == NULL) {
+        return;
+    }
+    char line[80];
+    snprintf(line, sizeof(line), "%s.%s %.2f %s\n", test, metric, value, unit);
+    lv_textarea_add_text(bench_results_ta, line);
+}
+
+// Timer callback: run one test per tick so the screen updates between tests
+static void benchmarks_timer_cb(lv_timer_t *timer)
+{
+    int count = bench_test_count();
+
+    if (bench_next_test >= count) {
+        lv_timer_del(timer);
+        bench_timer = NULL;
+        bench_end();
+        lv_label_set_text_fmt(bench_status_label, "Done: %d tests (report on UART)", count);
+        return;
+    }
+
+    int index = bench_next_test++;
+    bench_run_test(index, benchmarks_result, NULL);
+
+    // Display tests drew over the screen
+    if (bench_test_draws(index)) {
+        lv_obj_invalidate(lv_screen_active());
+    }
+    if (bench_next_test < count) {
+        lv_label_set_text_fmt(bench_status_label, "Running %s (%d/%d)...",
+                              bench_test_name(bench_next_test), bench_next_test + 1, count);
+    }
+}
+
+// Run button event: start the suite
+static void benchmarks_run_btn_event(lv_event_t *e)
+{
+    (void)e;
+    if (bench_timer != NULL) {
+        return;
+    }
+
+    lv_textarea_set_text(bench_results_ta, "");
+    lv_label_set_text_fmt(bench_status_label, "Running %s (1/%d)...",
+                          bench_test_name(0), bench_test_count());
+    bench_next_test = 0;
+    bench_begin();
+
+    // Short period: the label update is drawn before the first test blocks
+    bench_timer = lv_timer_create(benchmarks_timer_cb, 50, NULL);
+}
+
+// Create benchmarks screen
+lv_obj_t* create_benchmarks_screen(ui_context_t *ctx)
+{
+    lv_obj_t *screen = lv_obj_create(NULL);
+    apply_screen_style(screen);
+
+    lv_obj_t *title = lv_label_create(screen);
+    lv_label_set_text(title, "Benchmarks");
+    apply_title_style(title);
+    lv_obj_align(title, LV_ALIGN_TOP_MID, 0, PADDING_SMALL);
+
+    bench_status_label = lv_label_create(screen);
+    lv_label_set_text(bench_status_label, "Press Run to start");
+    apply_status_style(bench_status_label);
+    lv_obj_align(bench_status_label, LV_ALIGN_TOP_MID, 0, 30);
+
+    // Results, read-only
+    bench_results_ta = lv_textarea_create(screen);
+    lv_obj_set_size(bench_results_ta, 300, 200);
+    apply_textarea_style(bench_results_ta);
+    lv_obj_align(bench_results_ta, LV_ALIGN_TOP_MID, 0, 55);
+    lv_textarea_set_text(bench_results_ta, "");
+    lv_textarea_set_placeholder_text(bench_results_ta, "Results also go to the UART as BENCH lines");
+    lv_obj_remove_flag(bench_results_ta, LV_OBJ_FLAG_CLICK_FOCUSABLE);
+
+    // Run button
+    lv_obj_t *run_btn = lv_btn_create(screen);
+    lv_obj_set_size(run_btn, 130, 35);
+    apply_button_style(run_btn);
+    lv_obj_align(run_btn, LV_ALIGN_BOTTOM_MID, -65, -PADDING_NORMAL);
+    lv_obj_add_event_cb(run_btn, benchmarks_run_btn_event, LV_EVENT_CLICKED, ctx);
+
+    lv_obj_t *run_label = lv_label_create(run_btn);
+    lv_label_set_text(run_label, "Run");
+    apply_button_label_style(run_label);
+    lv_obj_center(run_label);
+
+    // Back to Main button
+    lv_obj_t *back_btn = lv_btn_create(screen);
+    lv_obj_set_size(back_btn, 130, 35);
+    apply_button_style(back_btn);
+    lv_obj_align(back_btn, LV_ALIGN_BOTTOM_MID, 65, -PADDING_NORMAL);
+    lv_obj_add_event_cb(back_btn, benchmarks_back_btn_event, LV_EVENT_CLICKED, ctx);
+
+    lv_obj_t *back_label = lv_label_create(back_btn);
+    lv_label_set_text(back_label, "Main Menu");
+    apply_button_label_style(back_label);
+    lv_obj_center(back_label);
+
+    return screen;
+}
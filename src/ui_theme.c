@@ -0,0 +1,176 @@
+#include "ui_theme.h"
+#include "log.h"
+#include "pico/stdlib.h"
+#include <stdio.h>
+#include <stdbool.h>
+
+#define STYLE_LOOKUP_ROUNDS 10   // Passes over the screen when timing lookups
+
+static lv_style_t g_styles[UI_STYLE_COUNT];
+static bool g_theme_initialized = false;
+
+// Properties read per object when timing style lookups (what drawing a
+// plain widget resolves)
+static const lv_style_prop_t g_lookup_props[] = {
+    LV_STYLE_BG_COLOR,
+    LV_STYLE_BG_OPA,
+    LV_STYLE_BORDER_WIDTH,
+    LV_STYLE_RADIUS,
+    LV_STYLE_PAD_TOP,
+    LV_STYLE_TEXT_COLOR,
+    LV_STYLE_TEXT_FONT,
+};
+
+// Initialize the shared styles
+void ui_theme_init(void)
+{
+    if (g_theme_initialized) {
+        return;
+    }
+
+    for (int i = 0; i < UI_STYLE_COUNT; i++) {
+        lv_style_init(&g_styles[i]);
+    }
+
+    lv_style_set_bg_color(&g_styles[UI_STYLE_SCREEN], lv_color_hex(THEME_BG_PRIMARY));
+
+    lv_style_set_text_font(&g_styles[UI_STYLE_TITLE], FONT_TITLE);
+    lv_style_set_text_color(&g_styles[UI_STYLE_TITLE], lv_color_hex(THEME_TEXT_PRIMARY));
+
+    lv_style_set_text_font(&g_styles[UI_STYLE_BODY], FONT_BODY);
+    lv_style_set_text_color(&g_styles[UI_STYLE_BODY], lv_color_hex(THEME_TEXT_SECONDARY));
+
+    lv_style_set_text_font(&g_styles[UI_STYLE_STATUS], FONT_BODY);
+    lv_style_set_text_color(&g_styles[UI_STYLE_STATUS], lv_color_hex(THEME_TEXT_TERTIARY));
+
+    lv_style_set_bg_color(&g_styles[UI_STYLE_BUTTON], lv_color_hex(THEME_BG_BUTTON));
+    lv_style_set_radius(&g_styles[UI_STYLE_BUTTON], 5);
+
+    lv_style_set_text_font(&g_styles[UI_STYLE_BUTTON_LABEL], FONT_BODY);
+    lv_style_set_text_color(&g_styles[UI_STYLE_BUTTON_LABEL], lv_color_hex(THEME_TEXT_SECONDARY));
+
+    lv_style_t *ta = &g_styles[UI_STYLE_TEXTAREA];
+    lv_style_set_bg_color(ta, lv_color_hex(THEME_BG_TERTIARY));
+    lv_style_set_border_color(ta, lv_color_hex(THEME_BORDER_LIGHT));
+    lv_style_set_border_width(ta, BORDER_THIN);
+    lv_style_set_radius(ta, 4);
+    lv_style_set_text_font(ta, FONT_BODY);
+    lv_style_set_text_color(ta, lv_color_hex(THEME_TEXT_SECONDARY));
+    lv_style_set_pad_all(ta, PADDING_SMALL);
+
+    // Dropdown button (closed state)
+    lv_style_t *dd = &g_styles[UI_STYLE_DROPDOWN];
+    lv_style_set_bg_color(dd, lv_color_hex(THEME_BG_TERTIARY));
+    lv_style_set_border_color(dd, lv_color_hex(THEME_BORDER_LIGHT));
+    lv_style_set_border_width(dd, BORDER_THIN);
+    lv_style_set_radius(dd, 4);
+    lv_style_set_text_font(dd, FONT_BODY);
+    lv_style_set_text_color(dd, lv_color_hex(THEME_TEXT_SECONDARY));
+    lv_style_set_pad_left(dd, PADDING_SMALL);
+    lv_style_set_pad_right(dd, PADDING_SMALL);
+
+    // Dropdown list (opened state)
+    lv_style_t *dd_list = &g_styles[UI_STYLE_DROPDOWN_LIST];
+    lv_style_set_bg_color(dd_list, lv_color_hex(THEME_BG_SECONDARY));
+    lv_style_set_border_color(dd_list, lv_color_hex(THEME_BORDER_LIGHT));
+    lv_style_set_border_width(dd_list, 2);
+    lv_style_set_radius(dd_list, 4);
+    lv_style_set_text_font(dd_list, FONT_BODY);
+    lv_style_set_text_color(dd_list, lv_color_hex(THEME_TEXT_SECONDARY));
+    lv_style_set_pad_all(dd_list, PADDING_SMALL);
+
+    // Selected/highlighted items - orange background with black text
+    lv_style_t *dd_sel = &g_styles[UI_STYLE_DROPDOWN_SELECTED];
+    lv_style_set_bg_color(dd_sel, lv_color_hex(THEME_TEXT_PRIMARY));
+    lv_style_set_bg_opa(dd_sel, LV_OPA_COVER);
+    lv_style_set_text_color(dd_sel, lv_color_hex(0x000000));
+
+    lv_style_set_border_color(&g_styles[UI_STYLE_FOCUSED], lv_color_hex(THEME_TEXT_PRIMARY));
+
+    lv_style_t *list = &g_styles[UI_STYLE_LIST];
+    lv_style_set_bg_color(list, lv_color_hex(THEME_BG_SECONDARY));
+    lv_style_set_border_width(list, 2);
+    lv_style_set_border_color(list, lv_color_hex(THEME_BORDER_NORMAL));
+    lv_style_set_radius(list, 6);
+    lv_style_set_pad_all(list, PADDING_SMALL);
+
+    // Scrollbar - orange
+    lv_style_t *sb = &g_styles[UI_STYLE_LIST_SCROLLBAR];
+    lv_style_set_bg_color(sb, lv_color_hex(THEME_TEXT_PRIMARY));
+    lv_style_set_bg_opa(sb, LV_OPA_COVER);
+    lv_style_set_width(sb, 8);
+    lv_style_set_radius(sb, 4);
+
+    // List row card; the label inherits the text color from the row
+    lv_style_t *row = &g_styles[UI_STYLE_LIST_ROW];
+    lv_style_set_bg_color(row, lv_color_hex(THEME_BG_TERTIARY));
+    lv_style_set_bg_opa(row, LV_OPA_COVER);
+    lv_style_set_radius(row, 4);
+    lv_style_set_border_width(row, 1);
+    lv_style_set_border_color(row, lv_color_hex(THEME_BORDER_LIGHT));
+    lv_style_set_pad_all(row, 4);
+    lv_style_set_text_color(row, lv_color_hex(THEME_TEXT_SECONDARY));
+    lv_style_set_text_font(row, FONT_BODY);
+
+    // Selected row - orange with black text
+    lv_style_t *row_sel = &g_styles[UI_STYLE_LIST_ROW_SELECTED];
+    lv_style_set_bg_color(row_sel, lv_color_hex(THEME_TEXT_PRIMARY));
+    lv_style_set_border_color(row_sel, lv_color_hex(THEME_TEXT_PRIMARY));
+    lv_style_set_text_color(row_sel, lv_color_hex(0x000000));
+
+    g_theme_initialized = true;
+}
+
+// Get a shared style
+lv_style_t *ui_theme_style(ui_style_id_t id)
+{
+    return &g_styles[id];
+}
+
+// Tree walk: count objects
+static lv_obj_tree_walk_res_t count_obj_cb(lv_obj_t *obj, void *user_data)
+{
+    (void)obj;
+    (*(uint32_t *)user_data)++;
+    return LV_OBJ_TREE_WALK_NEXT;
+}
+
+// Tree walk: resolve the lookup properties on one object
+static lv_obj_tree_walk_res_t lookup_obj_cb(lv_obj_t *obj, void *user_data)
+{
+    volatile uint32_t *sink = (volatile uint32_t *)user_data;
+    for (size_t i = 0; i < sizeof(g_lookup_props) / sizeof(g_lookup_props[0]); i++) {
+        lv_style_value_t v = lv_obj_get_style_prop(obj, LV_PART_MAIN, g_lookup_props[i]);
+        *sink += (uint32_t)v.num;
+    }
+    return LV_OBJ_TREE_WALK_NEXT;
+}
+
+// Report heap use and style lookup cost of a screen
+void ui_theme_report_screen(lv_obj_t *screen, const char *name, size_t heap_used)
+{
+    if (screen == NULL) {
+        return;
+    }
+
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+
+    uint32_t objects = 0;
+    lv_obj_tree_walk(screen, count_obj_cb, &objects);
+
+    volatile uint32_t sink = 0;
+    uint64_t t0 = time_us_64();
+    for (int round = 0; round < STYLE_LOOKUP_ROUNDS; round++) {
+        lv_obj_tree_walk(screen, lookup_obj_cb, (void *)&sink);
+    }
+    uint32_t elapsed = (uint32_t)(time_us_64() - t0);
+
+    uint32_t lookups = objects * STYLE_LOOKUP_ROUNDS *
+                       (uint32_t)(sizeof(g_lookup_props) / sizeof(g_lookup_props[0]));
+
+    log_flush();
+    printf("Screen %s: %lu objects, heap %lu bytes (%lu free), style lookup %lu ns/prop\n",
+           name, (unsigned long)objects, (unsigned long)heap_used, (unsigned long)mon.free_size,
+           (unsigned long)(lookups ? (uint64_t)elapsed * 1000 / lookups : 0));
+}
@@ -0,0 +1,329 @@
+#include "ui_vlist.h"
+#include "pico/stdlib.h"
+#include <string.h>
+
+#define UI_VLIST_NONE    UINT32_MAX   // Row not bound to an item
+#define UI_VLIST_ROW_GAP 2            // Vertical space between rows
+
+// Per-list state, owned by the list object
+typedef struct {
+    ui_vlist_config_t config;
+    lv_obj_t *viewport;                        // Scrolls; rows live inside it
+    lv_obj_t *spacer;                          // Gives the viewport its full content height
+    lv_obj_t *rows[UI_VLIST_MAX_POOL];
+    lv_obj_t *labels[UI_VLIST_MAX_POOL];
+    uint32_t row_index[UI_VLIST_MAX_POOL];     // Item bound to each row
+    uint32_t pool_size;
+    uint32_t count;
+    uint32_t selected;
+    ui_vlist_stats_t stats;
+} ui_vlist_t;
+
+static ui_vlist_t *vlist_get(lv_obj_t *vlist)
+{
+    return (ui_vlist_t *)lv_obj_get_user_data(vlist);
+}
+
+// Grow the row pool to cover the viewport plus the margins
+static void vlist_ensure_pool(ui_vlist_t *list)
+{
+    int32_t view_h = lv_obj_get_content_height(list->viewport);
+    if (view_h <= 0) {
+        return;  // Not laid out yet
+    }
+
+    uint32_t needed = (uint32_t)((view_h + list->config.row_height - 1) / list->config.row_height)
+                      + 1 + 2 * UI_VLIST_MARGIN_ROWS;
+    if (needed > UI_VLIST_MAX_POOL) needed = UI_VLIST_MAX_POOL;
+    if (needed <= list->pool_size) {
+        return;
+    }
+
+    for (uint32_t s = list->pool_size; s < needed; s++) {
+        lv_obj_t *row = lv_obj_create(list->viewport);
+        lv_obj_remove_flag(row, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE |
+                                LV_OBJ_FLAG_SCROLL_ON_FOCUS);
+        lv_obj_set_size(row, lv_pct(100), list->config.row_height - UI_VLIST_ROW_GAP);
+        lv_obj_add_flag(row, LV_OBJ_FLAG_HIDDEN);
+
+        lv_obj_t *label = lv_label_create(row);
+        lv_obj_set_size(label, lv_pct(100), lv_pct(100));
+        lv_label_set_long_mode(label, LV_LABEL_LONG_DOT);
+
+        if (list->config.row_init_cb != NULL) {
+            list->config.row_init_cb(row, label);
+        }
+
+        list->rows[s] = row;
+        list->labels[s] = label;
+    }
+
+    // Slot assignment is index % pool_size, so every row must be rebound
+    list->pool_size = needed;
+    for (uint32_t s = 0; s < list->pool_size; s++) {
+        list->row_index[s] = UI_VLIST_NONE;
+        lv_obj_add_flag(list->rows[s], LV_OBJ_FLAG_HIDDEN);
+    }
+    list->stats.rows_live = list->pool_size;
+}
+
+// Bind the rows for the current scroll position. Rows that already show
+// the right item are left alone unless force is set.
+static void vlist_rebind(ui_vlist_t *list, bool force)
+{
+    vlist_ensure_pool(list);
+    if (list->pool_size == 0) {
+        return;
+    }
+
+    int32_t first = lv_obj_get_scroll_y(list->viewport) / list->config.row_height
+                    - UI_VLIST_MARGIN_ROWS;
+    if (first < 0) first = 0;
+    uint32_t end = (uint32_t)first + list->pool_size;
+    if (end > list->count) end = list->count;
+
+    // Hide rows that fell out of the window
+    for (uint32_t s = 0; s < list->pool_size; s++) {
+        uint32_t idx = list->row_index[s];
+        if (idx != UI_VLIST_NONE && (idx < (uint32_t)first || idx >= end)) {
+            lv_obj_add_flag(list->rows[s], LV_OBJ_FLAG_HIDDEN);
+            list->row_index[s] = UI_VLIST_NONE;
+        }
+    }
+
+    // Bind rows that came into the window
+    for (uint32_t i = (uint32_t)first; i < end; i++) {
+        uint32_t s = i % list->pool_size;
+        if (list->row_index[s] != i || force) {
+            lv_obj_set_y(list->rows[s], (int32_t)i * list->config.row_height);
+            list->config.bind_cb(list->labels[s], i, list->config.user_data);
+            lv_obj_remove_flag(list->rows[s], LV_OBJ_FLAG_HIDDEN);
+            list->row_index[s] = i;
+            list->stats.binds++;
+        }
+
+        if (i == list->selected) {
+            lv_obj_add_state(list->rows[s], LV_STATE_CHECKED);
+        } else {
+            lv_obj_remove_state(list->rows[s], LV_STATE_CHECKED);
+        }
+    }
+
+    list->stats.rebind_passes++;
+}
+
+// Viewport event: scrolled or resized
+static void vlist_viewport_event(lv_event_t *e)
+{
+    ui_vlist_t *list = (ui_vlist_t *)lv_event_get_user_data(e);
+    vlist_rebind(list, false);
+}
+
+// List event: keys, Enter and cleanup
+static void vlist_event(lv_event_t *e)
+{
+    lv_event_code_t code = lv_event_get_code(e);
+    lv_obj_t *obj = lv_event_get_target(e);
+    ui_vlist_t *list = vlist_get(obj);
+    if (list == NULL) return;
+
+    if (code == LV_EVENT_KEY) {
+        uint32_t key = lv_event_get_key(e);
+        uint32_t page = (uint32_t)(lv_obj_get_content_height(list->viewport) / list->config.row_height);
+        if (page == 0) page = 1;
+
+        if (list->count == 0) return;
+
+        if (key == LV_KEY_UP && list->selected > 0) {
+            ui_vlist_set_selected(obj, list->selected - 1);
+        } else if (key == LV_KEY_DOWN) {
+            ui_vlist_set_selected(obj, list->selected + 1);
+        } else if (key == LV_KEY_LEFT) {
+            ui_vlist_set_selected(obj, list->selected > page ? list->selected - page : 0);
+        } else if (key == LV_KEY_RIGHT) {
+            ui_vlist_set_selected(obj, list->selected + page);
+        } else if (key == LV_KEY_HOME) {
+            ui_vlist_set_selected(obj, 0);
+        } else if (key == LV_KEY_END) {
+            ui_vlist_set_selected(obj, list->count - 1);
+        }
+    } else if (code == LV_EVENT_CLICKED) {
+        if (list->count > 0 && list->config.select_cb != NULL) {
+            list->config.select_cb(obj, list->selected, list->config.user_data);
+        }
+    } else if (code == LV_EVENT_DELETE) {
+        // Children are deleted after this; stop the viewport reaching the state
+        lv_obj_remove_event_cb_with_user_data(list->viewport, vlist_viewport_event, list);
+        lv_obj_set_user_data(obj, NULL);
+        lv_free(list);
+    }
+}
+
+// Create a list
+lv_obj_t *ui_vlist_create(lv_obj_t *parent, const ui_vlist_config_t *config)
+{
+    ui_vlist_t *list = (ui_vlist_t *)lv_malloc(sizeof(ui_vlist_t));
+    if (list == NULL) {
+        return NULL;
+    }
+    memset(list, 0, sizeof(*list));
+    list->config = *config;
+
+    // The outer object takes focus and keys but does not scroll itself, so
+    // LVGL's default Up/Down scrolling never competes with the selection
+    lv_obj_t *obj = lv_obj_create(parent);
+    lv_obj_remove_flag(obj, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_set_user_data(obj, list);
+    lv_obj_add_event_cb(obj, vlist_event, LV_EVENT_ALL, NULL);
+
+    list->viewport = lv_obj_create(obj);
+    lv_obj_set_size(list->viewport, lv_pct(100), lv_pct(100));
+    lv_obj_remove_flag(list->viewport, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLL_ELASTIC);
+    lv_obj_set_scroll_dir(list->viewport, LV_DIR_VER);
+    lv_obj_set_style_bg_opa(list->viewport, LV_OPA_TRANSP, 0);
+    lv_obj_set_style_border_width(list->viewport, 0, 0);
+    lv_obj_set_style_radius(list->viewport, 0, 0);
+    lv_obj_set_style_pad_all(list->viewport, 0, 0);
+    lv_obj_set_style_pad_right(list->viewport, 10, 0);  // Room for the scrollbar
+    lv_obj_add_event_cb(list->viewport, vlist_viewport_event, LV_EVENT_SCROLL, list);
+    lv_obj_add_event_cb(list->viewport, vlist_viewport_event, LV_EVENT_SIZE_CHANGED, list);
+
+    list->spacer = lv_obj_create(list->viewport);
+    lv_obj_remove_style_all(list->spacer);
+    lv_obj_remove_flag(list->spacer, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_set_size(list->spacer, 1, 1);
+    lv_obj_add_flag(list->spacer, LV_OBJ_FLAG_HIDDEN);
+
+    return obj;
+}
+
+// Set the number of items
+void ui_vlist_set_count(lv_obj_t *vlist, uint32_t count)
+{
+    ui_vlist_t *list = vlist_get(vlist);
+    if (list == NULL) return;
+
+    list->count = count;
+    if (count > 0) {
+        lv_obj_set_y(list->spacer, (int32_t)count * list->config.row_height - 1);
+        lv_obj_remove_flag(list->spacer, LV_OBJ_FLAG_HIDDEN);
+    } else {
+        lv_obj_add_flag(list->spacer, LV_OBJ_FLAG_HIDDEN);
+    }
+    if (list->selected >= count) {
+        list->selected = (count > 0) ? count - 1 : 0;
+    }
+
+    // The content height changed; pull the scroll position back if it shrank
+    lv_obj_update_layout(list->viewport);
+    lv_obj_readjust_scroll(list->viewport, LV_ANIM_OFF);
+    vlist_rebind(list, false);
+}
+
+uint32_t ui_vlist_get_count(lv_obj_t *vlist)
+{
+    ui_vlist_t *list = vlist_get(vlist);
+    return (list != NULL) ? list->count : 0;
+}
+
+// Rebind the visible rows
+void ui_vlist_refresh(lv_obj_t *vlist)
+{
+    ui_vlist_t *list = vlist_get(vlist);
+    if (list == NULL) return;
+
+    vlist_rebind(list, true);
+}
+
+// Select an item and scroll it into view
+void ui_vlist_set_selected(lv_obj_t *vlist, uint32_t index)
+{
+    ui_vlist_t *list = vlist_get(vlist);
+    if (list == NULL || list->count == 0) return;
+
+    if (index >= list->count) index = list->count - 1;
+    list->selected = index;
+
+    int32_t row_top = (int32_t)index * list->config.row_height;
+    int32_t row_bottom = row_top + list->config.row_height;
+    int32_t view_h = lv_obj_get_content_height(list->viewport);
+    int32_t scroll_y = lv_obj_get_scroll_y(list->viewport);
+
+    if (row_top < scroll_y) {
+        lv_obj_scroll_to_y(list->viewport, row_top, LV_ANIM_OFF);
+    } else if (row_bottom > scroll_y + view_h) {
+        lv_obj_scroll_to_y(list->viewport, row_bottom - view_h, LV_ANIM_OFF);
+    }
+
+    // Moves the highlight even when the scroll position did not change
+    vlist_rebind(list, false);
+}
+
+uint32_t ui_vlist_get_selected(lv_obj_t *vlist)
+{
+    ui_vlist_t *list = vlist_get(vlist);
+    return (list != NULL) ? list->selected : 0;
+}
+
+lv_obj_t *ui_vlist_get_viewport(lv_obj_t *vlist)
+{
+    ui_vlist_t *list = vlist_get(vlist);
+    return (list != NULL) ? list->viewport : NULL;
+}
+
+void ui_vlist_get_stats(lv_obj_t *vlist, ui_vlist_stats_t *stats)
+{
+    ui_vlist_t *list = vlist_get(vlist);
+    if (list != NULL) {
+        *stats = list->stats;
+    } else {
+        memset(stats, 0, sizeof(*stats));
+    }
+}
+
+// Benchmark data source
+static void benchmark_bind(lv_obj_t *label, uint32_t index, void *user_data)
+{
+    (void)user_data;
+    lv_label_set_text_fmt(label, "Item %lu", (unsigned long)index);
+}
+
+// Scroll cost for a list of count items
+void ui_vlist_benchmark(uint32_t count, ui_vlist_bench_t *result)
+{
+    // Never loaded, so nothing is drawn; this measures objects, binding and layout
+    lv_obj_t *parent = lv_obj_create(NULL);
+
+    lv_mem_monitor_t before, after;
+    lv_mem_monitor(&before);
+
+    ui_vlist_config_t config = {
+        .row_height = 40,
+        .bind_cb = benchmark_bind,
+    };
+    lv_obj_t *list = ui_vlist_create(parent, &config);
+    lv_obj_set_size(list, 300, 220);
+    lv_obj_update_layout(list);
+    ui_vlist_set_count(list, count);
+    lv_obj_update_layout(list);
+
+    lv_mem_monitor(&after);
+
+    // Walk the selection to the end, one row per step
+    uint64_t t0 = time_us_64();
+    for (uint32_t i = 1; i < count; i++) {
+        ui_vlist_set_selected(list, i);
+        lv_obj_update_layout(list);
+    }
+    uint32_t elapsed = (uint32_t)(time_us_64() - t0);
+    uint32_t steps = count > 1 ? count - 1 : 0;
+
+    ui_vlist_stats_t stats;
+    ui_vlist_get_stats(list, &stats);
+    result->rows_live = stats.rows_live;
+    result->heap_bytes = (uint32_t)(before.free_size - after.free_size);
+    result->step_us = steps ? elapsed / steps : 0;
+    result->binds = stats.binds;
+
+    lv_obj_delete(parent);
+}
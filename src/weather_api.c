@@ -3,6 +3,10 @@
 #include "lwip/dns.h"
 #include "lwip/pbuf.h"
 #include "lwip/tcp.h"
+#include "event_bus.h"
+#include "job_queue.h"
+#include "trace.h"
+#include "log.h"
 #include "mbedtls/ssl.h"
 #include "mbedtls/entropy.h"
 #include "mbedtls/ctr_drbg.h"
@@ -11,6 +15,10 @@
 #include "mbedtls/debug.h"
 #include "lvgl.h"
 #include "psram_helper.h"
+#include "tls_rx_queue.h"
+#include "tls_arena.h"
+#include "tls_profile.h"
+#include "net_capture.h"
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -29,8 +37,24 @@ static weather_data_t g_weather_data = {0};
 static struct tcp_pcb *g_tcp_pcb = NULL;
 static ip_addr_t g_server_ip;
 static char g_request_buffer[1024];
-static char g_response_buffer[16384];  // Larger for JSON + map data
+static char g_response_buffer[16384];  // Decrypted response (JSON + map data)
 static uint32_t g_response_len = 0;
+static uint32_t g_parse_len = 0;  // Response length handed to the forecast parse job
+
+// Output of the forecast parse job (core1), published by
+// forecast_parse_done() (core0)
+typedef struct {
+    bool ok;
+    char error_message[128];
+    bool has_coords;
+    float latitude;
+    float longitude;
+    weather_forecast_t forecasts[MAX_WEATHER_FORECASTS];
+    uint8_t forecast_count;
+} forecast_parse_t;
+
+static forecast_parse_t g_forecast_parse;
+static tls_rx_queue_t g_rx_queue = {0};  // Ciphertext waiting for mbedTLS
 
 // mbedTLS SSL context
 static mbedtls_ssl_context g_ssl;
@@ -39,6 +63,8 @@ static mbedtls_entropy_context g_entropy;
 static mbedtls_ctr_drbg_context g_ctr_drbg;
 static bool g_ssl_initialized = false;
 static bool g_handshake_done = false;
+static tls_arena_t g_tls_arena;  // Heap for mbedTLS, released on every close
+static tls_profile_t g_tls_profile;  // Handshake timing for the current connection
 
 // Saved configuration
 static char g_api_key[64] = {0};
@@ -63,10 +89,34 @@ static err_t tcp_client_connected(void *arg, struct tcp_pcb *tpcb, err_t err);
 static err_t tcp_client_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err);
 static void tcp_client_err(void *arg, err_t err);
 static void weather_dns_found(const char *name, const ip_addr_t *ipaddr, void *arg);
-static void parse_forecast_response(const char *response, uint32_t len);
+static bool parse_forecast_response(const char *response, uint32_t len, forecast_parse_t *out);
+static void forecast_parse_job(void *arg);
+static void forecast_parse_done(void *arg);
+static uint8_t parse_forecast_list(const char *list_start, weather_forecast_t *forecasts, uint8_t max);
 static void parse_map_response(const char *response, uint32_t len);
 static int ssl_send_callback(void *ctx, const unsigned char *buf, size_t len);
-static int ssl_recv_callback(void *ctx, unsigned char *buf, size_t len);
+static void deinit_ssl(void);
+static void read_decrypted_data(void);
+
+// Set the fetch state and post the matching event for the UI
+static void weather_set_state(weather_api_state_t state)
+{
+    g_weather_data.state = state;
+    switch (state) {
+        case WEATHER_STATE_FETCHING_FORECAST:
+        case WEATHER_STATE_FETCHING_MAP:
+            event_bus_post(EVENT_SOURCE_WEATHER, EVENT_FETCH_STARTED, state);
+            break;
+        case WEATHER_STATE_SUCCESS:
+            event_bus_post(EVENT_SOURCE_WEATHER, EVENT_FETCH_COMPLETED, state);
+            break;
+        case WEATHER_STATE_ERROR:
+            event_bus_post(EVENT_SOURCE_WEATHER, EVENT_FETCH_ERROR, state);
+            break;
+        default:
+            break;
+    }
+}
 
 // Forward declaration of SDK's hardware entropy function
 extern int mbedtls_hardware_poll(void *data, unsigned char *output, size_t len, size_t *olen);
@@ -78,7 +128,7 @@ void weather_api_init(void)
     g_weather_data.state = WEATHER_STATE_IDLE;
     g_weather_data.map_image_data = NULL;
     g_weather_data.map_loaded = false;
-    g_ssl_initialized = false;
+    deinit_ssl();
     g_handshake_done = false;
 }
 
@@ -91,6 +141,12 @@ static bool init_ssl(void)
 
     int ret;
 
+    // All mbedTLS allocations for this connection come from the arena
+    if (!tls_arena_init(&g_tls_arena, "weather")) {
+        return false;
+    }
+    tls_arena_select(&g_tls_arena);     // The connected callback restores the previous one
+
     mbedtls_ssl_init(&g_ssl);
     mbedtls_ssl_config_init(&g_ssl_conf);
     mbedtls_ctr_drbg_init(&g_ctr_drbg);
@@ -100,8 +156,8 @@ static bool init_ssl(void)
     ret = mbedtls_entropy_add_source(&g_entropy, mbedtls_hardware_poll, NULL,
                                       32, MBEDTLS_ENTROPY_SOURCE_STRONG);
     if (ret != 0) {
-        printf("Failed to add entropy source: -0x%04x\n", -ret);
-        return false;
+        LOG_E("Failed to add entropy source: -0x%04x\n", -ret);
+        goto fail;
     }
 
     // Seed the random number generator using hardware entropy
@@ -109,8 +165,8 @@ static bool init_ssl(void)
     ret = mbedtls_ctr_drbg_seed(&g_ctr_drbg, mbedtls_entropy_func, &g_entropy,
                                  (const unsigned char *)pers, strlen(pers));
     if (ret != 0) {
-        printf("mbedtls_ctr_drbg_seed failed: -0x%04x\n", -ret);
-        return false;
+        LOG_E("mbedtls_ctr_drbg_seed failed: -0x%04x\n", -ret);
+        goto fail;
     }
 
     ret = mbedtls_ssl_config_defaults(&g_ssl_conf,
@@ -118,27 +174,54 @@ static bool init_ssl(void)
                                        MBEDTLS_SSL_TRANSPORT_STREAM,
                                        MBEDTLS_SSL_PRESET_DEFAULT);
     if (ret != 0) {
-        printf("mbedtls_ssl_config_defaults failed: -0x%04x\n", -ret);
-        return false;
+        LOG_E("mbedtls_ssl_config_defaults failed: -0x%04x\n", -ret);
+        goto fail;
     }
 
     // Skip certificate verification for simplicity
     mbedtls_ssl_conf_authmode(&g_ssl_conf, MBEDTLS_SSL_VERIFY_NONE);
     mbedtls_ssl_conf_rng(&g_ssl_conf, mbedtls_ctr_drbg_random, &g_ctr_drbg);
 
+    // Offer the suites and curves that are cheapest on this core first
+    tls_profile_apply_preferences(&g_ssl_conf);
+
     ret = mbedtls_ssl_setup(&g_ssl, &g_ssl_conf);
     if (ret != 0) {
-        printf("mbedtls_ssl_setup failed: -0x%04x\n", -ret);
-        return false;
+        LOG_E("mbedtls_ssl_setup failed: -0x%04x\n", -ret);
+        goto fail;
     }
 
     // Hostname will be set dynamically before each connection
     // Set custom BIO callbacks for lwIP integration
-    mbedtls_ssl_set_bio(&g_ssl, NULL, ssl_send_callback, ssl_recv_callback, NULL);
+    mbedtls_ssl_set_bio(&g_ssl, &g_rx_queue, ssl_send_callback, tls_rx_queue_bio_recv, NULL);
 
     g_ssl_initialized = true;
-    printf("Weather SSL initialized successfully\n");
+    LOG_I("Weather SSL initialized successfully\n");
     return true;
+
+fail:
+    // Leave nothing behind and the libc heap selected
+    mbedtls_ssl_free(&g_ssl);
+    mbedtls_ssl_config_free(&g_ssl_conf);
+    mbedtls_ctr_drbg_free(&g_ctr_drbg);
+    mbedtls_entropy_free(&g_entropy);
+    tls_arena_deinit(&g_tls_arena);
+    return false;
+}
+
+// Free SSL/TLS state and release the connection's arena in one go
+static void deinit_ssl(void)
+{
+    if (g_ssl_initialized) {
+        mbedtls_ssl_free(&g_ssl);
+        mbedtls_ssl_config_free(&g_ssl_conf);
+        mbedtls_ctr_drbg_free(&g_ctr_drbg);
+        mbedtls_entropy_free(&g_entropy);
+    }
+    tls_arena_deinit(&g_tls_arena);
+
+    g_ssl_initialized = false;
+    g_handshake_done = false;
 }
 
 // SSL send callback - writes to TCP
@@ -150,7 +233,7 @@ static int ssl_send_callback(void *ctx, const unsigned char *buf, size_t len)
 
     err_t err = tcp_write(g_tcp_pcb, buf, len, TCP_WRITE_FLAG_COPY);
     if (err != ERR_OK) {
-        printf("SSL send failed: %d\n", err);
+        LOG_E("SSL send failed: %d\n", err);
         return MBEDTLS_ERR_NET_SEND_FAILED;
     }
 
@@ -158,35 +241,59 @@ static int ssl_send_callback(void *ctx, const unsigned char *buf, size_t len)
     return len;
 }
 
-// SSL receive callback - reads from response buffer
-static int ssl_recv_callback(void *ctx, unsigned char *buf, size_t len)
+// Drain decrypted application data straight into the response buffer
+static void read_decrypted_data(void)
 {
-    if (g_response_len == 0) {
-        return MBEDTLS_ERR_SSL_WANT_READ;
-    }
+    int total_read = 0;
+    int dropped = 0;
+
+    while (1) {
+        size_t space = sizeof(g_response_buffer) - 1 - g_response_len;
+        int read_ret;
 
-    size_t copy_len = (len < g_response_len) ? len : g_response_len;
-    memcpy(buf, g_response_buffer, copy_len);
+        if (space > 0) {
+            read_ret = mbedtls_ssl_read(&g_ssl, (unsigned char *)g_response_buffer + g_response_len, space);
+            if (read_ret > 0) {
+                net_capture_append(EVENT_SOURCE_WEATHER, g_response_buffer + g_response_len, read_ret);
+                g_response_len += read_ret;
+                g_response_buffer[g_response_len] = '\0';
+                total_read += read_ret;
+            }
+        } else {
+            // Response buffer full - keep the record layer moving but drop the plaintext
+            unsigned char discard[256];
+            read_ret = mbedtls_ssl_read(&g_ssl, discard, sizeof(discard));
+            if (read_ret > 0) {
+                net_capture_append(EVENT_SOURCE_WEATHER, discard, read_ret);
+                dropped += read_ret;
+            }
+        }
 
-    // Shift remaining data
-    if (copy_len < g_response_len) {
-        memmove(g_response_buffer, g_response_buffer + copy_len, g_response_len - copy_len);
+        if (read_ret <= 0) {
+            // WANT_READ/WANT_WRITE: no complete record queued; anything else: closed or error
+            break;
+        }
     }
-    g_response_len -= copy_len;
 
-    return copy_len;
+    if (total_read > 0) {
+        LOG_D("Received %d bytes of decrypted data\n", total_read);
+        event_bus_post_progress(EVENT_SOURCE_WEATHER, g_weather_data.state, g_response_len);
+    }
+    if (dropped > 0) {
+        LOG_W("Response buffer full, dropped %d bytes\n", dropped);
+    }
 }
 
 // DNS callback
 static void weather_dns_found(const char *name, const ip_addr_t *ipaddr, void *arg)
 {
     if (ipaddr != NULL) {
-        printf("Weather DNS resolved: %s\n", ipaddr_ntoa(ipaddr));
+        LOG_I("Weather DNS resolved: %s\n", ipaddr_ntoa(ipaddr));
         g_server_ip = *ipaddr;
 
         // Close any existing connection first
         if (g_tcp_pcb != NULL) {
-            printf("Closing existing TCP connection\n");
+            LOG_I("Closing existing TCP connection\n");
             tcp_abort(g_tcp_pcb);
             g_tcp_pcb = NULL;
         }
@@ -198,46 +305,48 @@ static void weather_dns_found(const char *name, const ip_addr_t *ipaddr, void *a
             tcp_err(g_tcp_pcb, tcp_client_err);
             err_t err = tcp_connect(g_tcp_pcb, &g_server_ip, WEATHER_API_PORT, tcp_client_connected);
             if (err != ERR_OK) {
-                printf("Weather TCP connect failed: %d\n", err);
-                g_weather_data.state = WEATHER_STATE_ERROR;
+                LOG_E("Weather TCP connect failed: %d\n", err);
+                weather_set_state(WEATHER_STATE_ERROR);
                 snprintf(g_weather_data.error_message, sizeof(g_weather_data.error_message),
                          "Connection failed");
                 tcp_abort(g_tcp_pcb);
                 g_tcp_pcb = NULL;
             }
         } else {
-            printf("Failed to create Weather TCP PCB\n");
-            g_weather_data.state = WEATHER_STATE_ERROR;
+            LOG_E("Failed to create Weather TCP PCB\n");
+            weather_set_state(WEATHER_STATE_ERROR);
             snprintf(g_weather_data.error_message, sizeof(g_weather_data.error_message),
                      "Out of TCP connections");
         }
     } else {
-        printf("Weather DNS lookup failed for %s\n", name);
-        g_weather_data.state = WEATHER_STATE_ERROR;
+        LOG_E("Weather DNS lookup failed for %s\n", name);
+        weather_set_state(WEATHER_STATE_ERROR);
         snprintf(g_weather_data.error_message, sizeof(g_weather_data.error_message),
                  "DNS lookup failed");
     }
 }
 
-// TCP connected callback
-static err_t tcp_client_connected(void *arg, struct tcp_pcb *tpcb, err_t err)
+// TCP connected callback body; runs with the connection's arena selected
+static err_t client_connected(void *arg, struct tcp_pcb *tpcb, err_t err)
 {
     if (err != ERR_OK) {
-        printf("Weather connection failed: %d\n", err);
-        g_weather_data.state = WEATHER_STATE_ERROR;
+        LOG_E("Weather connection failed: %d\n", err);
+        weather_set_state(WEATHER_STATE_ERROR);
         snprintf(g_weather_data.error_message, sizeof(g_weather_data.error_message),
                  "Connection error");
+        deinit_ssl();
         return err;
     }
 
-    printf("Connected to weather server, starting TLS handshake\n");
+    LOG_I("Connected to weather server, starting TLS handshake\n");
 
     // Set up receive callback
     tcp_recv(tpcb, tcp_client_recv);
+    tls_rx_queue_init(&g_rx_queue, tpcb);
 
     // Initialize SSL if not already done
     if (!init_ssl()) {
-        g_weather_data.state = WEATHER_STATE_ERROR;
+        weather_set_state(WEATHER_STATE_ERROR);
         snprintf(g_weather_data.error_message, sizeof(g_weather_data.error_message),
                  "SSL init failed");
         return ERR_ABRT;
@@ -250,50 +359,75 @@ static err_t tcp_client_connected(void *arg, struct tcp_pcb *tpcb, err_t err)
     mbedtls_ssl_session_reset(&g_ssl);
     g_handshake_done = false;
 
+    // Profile the handshake; the tap sees the server flight as mbedTLS reads it
+    tls_profile_begin(&g_tls_profile, g_current_host);
+    tls_rx_queue_set_tap(&g_rx_queue, tls_profile_observe, &g_tls_profile);
+
     // Start TLS handshake
     int ret;
-    while ((ret = mbedtls_ssl_handshake(&g_ssl)) != 0) {
+    while ((ret = tls_profile_handshake(&g_tls_profile, &g_ssl)) != 0) {
         if (ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) {
-            printf("TLS handshake failed: -0x%04x\n", -ret);
-            g_weather_data.state = WEATHER_STATE_ERROR;
+            LOG_E("TLS handshake failed: -0x%04x\n", -ret);
+            weather_set_state(WEATHER_STATE_ERROR);
             snprintf(g_weather_data.error_message, sizeof(g_weather_data.error_message),
                      "TLS handshake failed");
+            deinit_ssl();
             return ERR_ABRT;
         }
         // Handshake in progress, will continue when more data arrives
         return ERR_OK;
     }
 
-    printf("TLS handshake completed\n");
+    LOG_I("TLS handshake completed\n");
+    tls_profile_report(&g_tls_profile, &g_ssl);
+    tls_arena_report(&g_tls_arena, "handshake");
     g_handshake_done = true;
 
     // Send HTTP request over TLS
     int write_ret = mbedtls_ssl_write(&g_ssl, (unsigned char *)g_request_buffer, strlen(g_request_buffer));
     if (write_ret < 0) {
-        printf("SSL write failed: -0x%04x\n", -write_ret);
-        g_weather_data.state = WEATHER_STATE_ERROR;
+        LOG_E("SSL write failed: -0x%04x\n", -write_ret);
+        weather_set_state(WEATHER_STATE_ERROR);
         snprintf(g_weather_data.error_message, sizeof(g_weather_data.error_message),
                  "Failed to send request");
+        deinit_ssl();
         return ERR_ABRT;
     }
 
-    printf("HTTPS request sent (%d bytes)\n", write_ret);
+    LOG_I("HTTPS request sent (%d bytes)\n", write_ret);
     return ERR_OK;
 }
 
-// TCP receive callback
-static err_t tcp_client_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err)
+// TCP connected callback, in the connection's arena; the interrupted code's
+// selection is restored on the way out
+static err_t tcp_client_connected(void *arg, struct tcp_pcb *tpcb, err_t err)
+{
+    tls_arena_t *prev = tls_arena_select(&g_tls_arena);
+    err_t ret = client_connected(arg, tpcb, err);
+    tls_arena_select(prev);
+    return ret;
+}
+
+// TCP receive callback body; runs with the connection's arena selected
+static err_t client_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err)
 {
     if (p == NULL) {
         // Connection closed by server
-        printf("Weather connection closed by server\n");
+        LOG_I("Weather connection closed by server\n");
         tcp_close(tpcb);
         g_tcp_pcb = NULL;
+        net_capture_end(EVENT_SOURCE_WEATHER);
 
         // Parse the final response if we have data
         if (g_response_len > 0) {
             if (g_weather_data.current_request == WEATHER_REQUEST_FORECAST) {
-                parse_forecast_response(g_response_buffer, g_response_len);
+                // JSON parsing runs on core1; the buffer is left alone until
+                // the next fetch, which the UI only starts after the result
+                g_parse_len = g_response_len;
+                if (!job_queue_submit("forecast parse", forecast_parse_job, forecast_parse_done, NULL)) {
+                    forecast_parse_job(NULL);
+                    forecast_parse_done(NULL);
+                }
             } else if (g_weather_data.current_request == WEATHER_REQUEST_MAP) {
                 parse_map_response(g_response_buffer, g_response_len);
             }
@@ -302,115 +436,95 @@ static err_t tcp_client_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, er
         // Reset for next request
         g_response_len = 0;
         g_handshake_done = false;
+        tls_rx_queue_reset(&g_rx_queue);
+        deinit_ssl();
 
         return ERR_OK;
     }
 
     if (err != ERR_OK) {
-        printf("Weather receive error: %d\n", err);
+        LOG_E("Weather receive error: %d\n", err);
         pbuf_free(p);
-        g_weather_data.state = WEATHER_STATE_ERROR;
+        weather_set_state(WEATHER_STATE_ERROR);
         snprintf(g_weather_data.error_message, sizeof(g_weather_data.error_message),
                  "Receive error");
+        deinit_ssl();
         return err;
     }
 
-    // Copy data to response buffer for SSL processing
-    uint32_t copy_len = p->tot_len;
-    if (g_response_len + copy_len > sizeof(g_response_buffer) - 1) {
-        copy_len = sizeof(g_response_buffer) - 1 - g_response_len;
-    }
-
-    pbuf_copy_partial(p, g_response_buffer + g_response_len, copy_len, 0);
-    g_response_len += copy_len;
-
-    // Tell lwIP we've processed the data
-    tcp_recved(tpcb, p->tot_len);
-    pbuf_free(p);
+    // Queue ciphertext for mbedTLS; tcp_recved happens as it is consumed
+    tls_rx_queue_push(&g_rx_queue, p);
 
     // Continue TLS handshake if not done
     if (!g_handshake_done) {
-        int ret = mbedtls_ssl_handshake(&g_ssl);
+        int ret = tls_profile_handshake(&g_tls_profile, &g_ssl);
         if (ret == 0) {
-            printf("TLS handshake completed\n");
+            LOG_I("TLS handshake completed\n");
+            tls_profile_report(&g_tls_profile, &g_ssl);
+            tls_arena_report(&g_tls_arena, "handshake");
             g_handshake_done = true;
 
-            // Clear response buffer - handshake data no longer needed
-            g_response_len = 0;
-            memset(g_response_buffer, 0, sizeof(g_response_buffer));
-
             // Send HTTP request now that handshake is done
             int write_ret = mbedtls_ssl_write(&g_ssl, (unsigned char *)g_request_buffer, strlen(g_request_buffer));
             if (write_ret < 0) {
-                printf("SSL write failed: -0x%04x\n", -write_ret);
-                g_weather_data.state = WEATHER_STATE_ERROR;
+                LOG_E("SSL write failed: -0x%04x\n", -write_ret);
+                weather_set_state(WEATHER_STATE_ERROR);
                 snprintf(g_weather_data.error_message, sizeof(g_weather_data.error_message),
                          "Failed to send request");
+                deinit_ssl();
             } else {
-                printf("HTTPS request sent (%d bytes)\n", write_ret);
+                LOG_I("HTTPS request sent (%d bytes)\n", write_ret);
             }
         } else if (ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) {
-            printf("TLS handshake failed: -0x%04x\n", -ret);
-            g_weather_data.state = WEATHER_STATE_ERROR;
+            LOG_E("TLS handshake failed: -0x%04x\n", -ret);
+            weather_set_state(WEATHER_STATE_ERROR);
             snprintf(g_weather_data.error_message, sizeof(g_weather_data.error_message),
                      "TLS handshake failed");
+            deinit_ssl();
         }
     } else {
         // Handshake done, read ALL available decrypted data
-        char decrypt_buf[2048];
-        int total_read = 0;
-
-        // Keep reading until no more data available
-        while (1) {
-            int read_ret = mbedtls_ssl_read(&g_ssl, (unsigned char *)decrypt_buf, sizeof(decrypt_buf) - 1);
-            if (read_ret > 0) {
-                decrypt_buf[read_ret] = '\0';
-                total_read += read_ret;
-
-                // Store decrypted response
-                if (g_response_len + read_ret < sizeof(g_response_buffer)) {
-                    memcpy(g_response_buffer + g_response_len, decrypt_buf, read_ret);
-                    g_response_len += read_ret;
-                    g_response_buffer[g_response_len] = '\0';
-                }
-            } else if (read_ret == MBEDTLS_ERR_SSL_WANT_READ || read_ret == MBEDTLS_ERR_SSL_WANT_WRITE) {
-                // No more data available right now
-                break;
-            } else {
-                // Error or connection closed
-                break;
-            }
-        }
-
-        if (total_read > 0) {
-            printf("Received %d bytes of decrypted data\n", total_read);
-        }
+        read_decrypted_data();
     }
 
     return ERR_OK;
 }
 
+// TCP receive callback, in the connection's arena like tcp_client_connected
+static err_t tcp_client_recv(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err)
+{
+    tls_arena_t *prev = tls_arena_select(&g_tls_arena);
+    err_t ret = client_recv(arg, tpcb, p, err);
+    tls_arena_select(prev);
+    return ret;
+}
+
 // TCP error callback
 static void tcp_client_err(void *arg, err_t err)
 {
-    printf("Weather TCP error: %d\n", err);
-    g_weather_data.state = WEATHER_STATE_ERROR;
+    LOG_E("Weather TCP error: %d\n", err);
+    weather_set_state(WEATHER_STATE_ERROR);
     snprintf(g_weather_data.error_message, sizeof(g_weather_data.error_message),
              "Network error");
     g_tcp_pcb = NULL;
+    net_capture_end(EVENT_SOURCE_WEATHER);
+
+    // The pcb is already gone, just drop any queued ciphertext and TLS state
+    tls_rx_queue_reset(&g_rx_queue);
+    deinit_ssl();
 }
 
 // Fetch weather forecast
 void weather_api_fetch_forecast(const char *api_key, const char *city)
 {
-    printf("Fetching weather forecast for: %s\n", city);
+    LOG_I("Fetching weather forecast for: %s\n", city);
 
     // Save API key for subsequent map request
     strncpy(g_api_key, api_key, sizeof(g_api_key) - 1);
     g_api_key[sizeof(g_api_key) - 1] = '\0';
 
     // Set state
-    g_weather_data.state = WEATHER_STATE_FETCHING_FORECAST;
+    weather_set_state(WEATHER_STATE_FETCHING_FORECAST);
     g_weather_data.current_request = WEATHER_REQUEST_FORECAST;
     strncpy(g_weather_data.city_name, city, WEATHER_CITY_NAME_MAX - 1);
     g_weather_data.city_name[WEATHER_CITY_NAME_MAX - 1] = '\0';
@@ -427,6 +541,7 @@ void weather_api_fetch_forecast(const char *api_key, const char *city)
     // Reset response buffer
     g_response_len = 0;
     memset(g_response_buffer, 0, sizeof(g_response_buffer));
+    net_capture_begin(EVENT_SOURCE_WEATHER);
 
     // Set current host
     strncpy(g_current_host, WEATHER_API_HOST, sizeof(g_current_host) - 1);
@@ -438,7 +553,7 @@ void weather_api_fetch_forecast(const char *api_key, const char *city)
     if (err == ERR_OK) {
         weather_dns_found(WEATHER_API_HOST, &g_server_ip, NULL);
     } else if (err != ERR_INPROGRESS) {
-        g_weather_data.state = WEATHER_STATE_ERROR;
+        weather_set_state(WEATHER_STATE_ERROR);
         snprintf(g_weather_data.error_message, sizeof(g_weather_data.error_message),
                  "DNS lookup failed");
     }
@@ -447,22 +562,22 @@ void weather_api_fetch_forecast(const char *api_key, const char *city)
 // Fetch weather map
 void weather_api_fetch_map(const char *api_key, float lat, float lon)
 {
-    printf("Fetching weather map for: %.4f, %.4f\n", lat, lon);
+    LOG_I("Fetching weather map for: %.4f, %.4f\n", lat, lon);
 
-    g_weather_data.state = WEATHER_STATE_FETCHING_MAP;
+    weather_set_state(WEATHER_STATE_FETCHING_MAP);
     g_weather_data.current_request = WEATHER_REQUEST_MAP;
 
     // Allocate map image buffer from PSRAM if not done
     if (g_weather_data.map_image_data == NULL) {
         g_weather_data.map_image_data = (uint8_t *)psram_malloc(WEATHER_MAP_IMAGE_MAX_SIZE);
         if (g_weather_data.map_image_data == NULL) {
-            printf("Failed to allocate map buffer from PSRAM\n");
-            g_weather_data.state = WEATHER_STATE_ERROR;
+            LOG_E("Failed to allocate map buffer from PSRAM\n");
+            weather_set_state(WEATHER_STATE_ERROR);
             snprintf(g_weather_data.error_message, sizeof(g_weather_data.error_message),
                      "PSRAM allocation failed");
             return;
         }
-        printf("Map buffer allocated in PSRAM: %d KB\n", WEATHER_MAP_IMAGE_MAX_SIZE / 1024);
+        LOG_I("Map buffer allocated in PSRAM: %d KB\n", WEATHER_MAP_IMAGE_MAX_SIZE / 1024);
     }
 
     // Build HTTPS GET request for PNG map
@@ -490,101 +605,55 @@ void weather_api_fetch_map(const char *api_key, float lat, float lon)
     if (err == ERR_OK) {
         weather_dns_found(WEATHER_MAP_HOST, &g_server_ip, NULL);
     } else if (err != ERR_INPROGRESS) {
-        g_weather_data.state = WEATHER_STATE_ERROR;
+        weather_set_state(WEATHER_STATE_ERROR);
         snprintf(g_weather_data.error_message, sizeof(g_weather_data.error_message),
                  "DNS lookup failed");
     }
 }
 
-// Parse forecast response
-static void parse_forecast_response(const char *response, uint32_t len)
+// Job: parse the forecast response into g_forecast_parse (core1, or inline
+// if the queue is unavailable). Nothing the UI reads is touched here.
+static void forecast_parse_job(void *arg)
 {
-    printf("Parsing weather forecast response (%d bytes)\n", len);
-
-    // Find JSON body (skip HTTP headers)
-    const char *json_start = strstr(response, "\r\n\r\n");
-    if (!json_start) {
-        g_weather_data.state = WEATHER_STATE_ERROR;
-        snprintf(g_weather_data.error_message, sizeof(g_weather_data.error_message),
-                 "Invalid response");
-        return;
-    }
-    json_start += 4;
-
-    // Debug: Print first 500 and last 500 characters of JSON
-    printf("JSON start: %.500s\n", json_start);
-
-    int json_len = strlen(json_start);
-    if (json_len > 500) {
-        printf("JSON end: ...%s\n", json_start + json_len - 500);
-    }
-
-    // Check for API errors
-    if (strstr(json_start, "\"cod\":\"404\"") != NULL) {
-        const char *msg = strstr(json_start, "\"message\":\"");
-        if (msg) {
-            msg += 11;
-            const char *msg_end = strchr(msg, '"');
-            if (msg_end) {
-                int msg_len = msg_end - msg;
-                if (msg_len > 127) msg_len = 127;
-                strncpy(g_weather_data.error_message, msg, msg_len);
-                g_weather_data.error_message[msg_len] = '\0';
-            }
-        } else {
-            snprintf(g_weather_data.error_message, sizeof(g_weather_data.error_message),
-                     "City not found");
-        }
-        g_weather_data.state = WEATHER_STATE_ERROR;
-        return;
-    }
+    trace_begin(TRACE_JSON_PARSE);
+    g_forecast_parse.ok = parse_forecast_response(g_response_buffer, g_parse_len, &g_forecast_parse);
+    trace_end(TRACE_JSON_PARSE);
+}
 
-    if (strstr(json_start, "\"cod\":401") != NULL) {
-        g_weather_data.state = WEATHER_STATE_ERROR;
-        snprintf(g_weather_data.error_message, sizeof(g_weather_data.error_message),
-                 "Invalid API key");
+// Job done (core0): publish the forecasts, or the error
+static void forecast_parse_done(void *arg)
+{
+    if (!g_forecast_parse.ok) {
+        memcpy(g_weather_data.error_message, g_forecast_parse.error_message,
+               sizeof(g_weather_data.error_message));
+        weather_set_state(WEATHER_STATE_ERROR);
         return;
     }
 
-    // Extract city coordinates (for map request)
-    // In forecast API, coordinates are under "city":{"coord":{...}}
-    const char *city = strstr(json_start, "\"city\":{");
-    if (city) {
-        const char *coord = strstr(city, "\"coord\":{");
-        if (coord) {
-            const char *lat_pos = strstr(coord, "\"lat\":");
-            const char *lon_pos = strstr(coord, "\"lon\":");
-            if (lat_pos && lon_pos) {
-                g_weather_data.latitude = atof(lat_pos + 6);
-                g_weather_data.longitude = atof(lon_pos + 6);
-                printf("City coordinates: %.4f, %.4f\n", g_weather_data.latitude, g_weather_data.longitude);
-            }
-        }
-    }
-
-    if (g_weather_data.latitude == 0.0 && g_weather_data.longitude == 0.0) {
-        printf("Warning: Could not parse city coordinates from response\n");
+    if (g_forecast_parse.has_coords) {
+        g_weather_data.latitude = g_forecast_parse.latitude;
+        g_weather_data.longitude = g_forecast_parse.longitude;
     }
+    memcpy(g_weather_data.forecasts, g_forecast_parse.forecasts,
+           g_forecast_parse.forecast_count * sizeof(weather_forecast_t));
+    g_weather_data.forecast_count = g_forecast_parse.forecast_count;
 
-    // Parse forecast list array
-    const char *list_start = strstr(json_start, "\"list\":[");
-    if (!list_start) {
-        g_weather_data.state = WEATHER_STATE_ERROR;
-        snprintf(g_weather_data.error_message, sizeof(g_weather_data.error_message),
-                 "Invalid forecast data");
-        return;
-    }
-    list_start += 8;
+    // Map can be fetched separately if needed
+    weather_set_state(WEATHER_STATE_SUCCESS);
+}
 
-    g_weather_data.forecast_count = 0;
+// Parse the entries of the forecast "list" array (list_start is just past the '[')
+static uint8_t parse_forecast_list(const char *list_start, weather_forecast_t *forecasts, uint8_t max)
+{
+    uint8_t count = 0;
     const char *search_pos = list_start;
 
-    while (g_weather_data.forecast_count < MAX_WEATHER_FORECASTS) {
+    while (count < max) {
         // Find next forecast object
         search_pos = strstr(search_pos, "\"dt\":");
         if (!search_pos) break;
 
-        weather_forecast_t *fc = &g_weather_data.forecasts[g_weather_data.forecast_count];
+        weather_forecast_t *fc = &forecasts[count];
 
         // Parse timestamp
         fc->timestamp = (time_t)atol(search_pos + 5);
@@ -628,36 +697,116 @@ static void parse_forecast_response(const char *response, uint32_t len)
             fc->icon[3] = '\0';
         }
 
-        g_weather_data.forecast_count++;
+        count++;
         search_pos += 100;  // Move forward to avoid re-parsing
     }
 
-    printf("Parsed %d forecasts\n", g_weather_data.forecast_count);
+    return count;
+}
 
-    // Weather forecast parsed successfully
-    // Map can be fetched separately if needed
-    g_weather_data.state = WEATHER_STATE_SUCCESS;
+// Parse forecast response into out (error text included)
+static bool parse_forecast_response(const char *response, uint32_t len, forecast_parse_t *out)
+{
+    LOG_I("Parsing weather forecast response (%d bytes)\n", len);
+
+    // Find JSON body (skip HTTP headers)
+    const char *json_start = strstr(response, "\r\n\r\n");
+    if (!json_start) {
+        snprintf(out->error_message, sizeof(out->error_message),
+                 "Invalid response");
+        return false;
+    }
+    json_start += 4;
+
+    // Debug: Print first 500 and last 500 characters of JSON
+    LOG_D("JSON start: %.500s\n", json_start);
+
+    int json_len = strlen(json_start);
+    if (json_len > 500) {
+        LOG_D("JSON end: ...%s\n", json_start + json_len - 500);
+    }
+
+    // Check for API errors
+    if (strstr(json_start, "\"cod\":\"404\"") != NULL) {
+        const char *msg = strstr(json_start, "\"message\":\"");
+        if (msg) {
+            msg += 11;
+            const char *msg_end = strchr(msg, '"');
+            if (msg_end) {
+                int msg_len = msg_end - msg;
+                if (msg_len > 127) msg_len = 127;
+                strncpy(out->error_message, msg, msg_len);
+                out->error_message[msg_len] = '\0';
+            }
+        } else {
+            snprintf(out->error_message, sizeof(out->error_message),
+                     "City not found");
+        }
+        return false;
+    }
+
+    if (strstr(json_start, "\"cod\":401") != NULL) {
+        snprintf(out->error_message, sizeof(out->error_message),
+                 "Invalid API key");
+        return false;
+    }
+
+    // Extract city coordinates (for map request)
+    // In forecast API, coordinates are under "city":{"coord":{...}}
+    const char *city = strstr(json_start, "\"city\":{");
+    out->has_coords = false;
+    if (city) {
+        const char *coord = strstr(city, "\"coord\":{");
+        if (coord) {
+            const char *lat_pos = strstr(coord, "\"lat\":");
+            const char *lon_pos = strstr(coord, "\"lon\":");
+            if (lat_pos && lon_pos) {
+                out->latitude = atof(lat_pos + 6);
+                out->longitude = atof(lon_pos + 6);
+                out->has_coords = true;
+                LOG_I("City coordinates: %.4f, %.4f\n", out->latitude, out->longitude);
+            }
+        }
+    }
+
+    if (!out->has_coords) {
+        LOG_W("Warning: Could not parse city coordinates from response\n");
+    }
+
+    // Parse forecast list array
+    const char *list_start = strstr(json_start, "\"list\":[");
+    if (!list_start) {
+        snprintf(out->error_message, sizeof(out->error_message),
+                 "Invalid forecast data");
+        return false;
+    }
+    list_start += 8;
+
+    out->forecast_count = parse_forecast_list(list_start, out->forecasts, MAX_WEATHER_FORECASTS);
+
+    LOG_I("Parsed %d forecasts\n", out->forecast_count);
+    return true;
 }
 
 // Parse map response
 static void parse_map_response(const char *response, uint32_t len)
 {
-    printf("Parsing map image response (%d bytes)\n", len);
+    LOG_I("Parsing map image response (%d bytes)\n", len);
 
     // Debug: Print HTTP response headers and beginning of body
     const char *body_start = strstr(response, "\r\n\r\n");
     if (body_start) {
         int header_len = body_start - response;
-        printf("HTTP headers (%d bytes): %.400s\n", header_len, response);
-        printf("Body start (first 100 bytes): %.100s\n", body_start + 4);
+        LOG_D("HTTP headers (%d bytes): %.400s\n", header_len, response);
+        LOG_D("Body start (first 100 bytes): %.100s\n", body_start + 4);
     } else {
-        printf("No HTTP headers found, raw response: %.200s\n", response);
+        LOG_D("No HTTP headers found, raw response: %.200s\n", response);
     }
 
     // Find PNG binary data (skip HTTP headers)
     const char *png_start = strstr(response, "\r\n\r\n");
     if (!png_start) {
-        g_weather_data.state = WEATHER_STATE_ERROR;
+        weather_set_state(WEATHER_STATE_ERROR);
         snprintf(g_weather_data.error_message, sizeof(g_weather_data.error_message),
                  "Invalid map response");
         return;
@@ -667,20 +816,20 @@ static void parse_map_response(const char *response, uint32_t len)
     // Check PNG magic header (89 50 4E 47)
     if ((unsigned char)png_start[0] != 0x89 || png_start[1] != 'P' ||
         png_start[2] != 'N' || png_start[3] != 'G') {
-        printf("Not a valid PNG image\n");
-        printf("First 4 bytes: 0x%02X 0x%02X 0x%02X 0x%02X\n",
-               (unsigned char)png_start[0], (unsigned char)png_start[1],
-               (unsigned char)png_start[2], (unsigned char)png_start[3]);
+        LOG_W("Not a valid PNG image\n");
+        LOG_D("First 4 bytes: 0x%02X 0x%02X 0x%02X 0x%02X\n",
+              (unsigned char)png_start[0], (unsigned char)png_start[1],
+              (unsigned char)png_start[2], (unsigned char)png_start[3]);
         // Don't fail completely, just skip the map
         g_weather_data.map_loaded = false;
-        g_weather_data.state = WEATHER_STATE_SUCCESS;
+        weather_set_state(WEATHER_STATE_SUCCESS);
         return;
     }
 
     // Calculate PNG size
     uint32_t png_size = len - (png_start - response);
     if (png_size > WEATHER_MAP_IMAGE_MAX_SIZE) {
-        printf("Warning: Map image truncated\n");
+        LOG_W("Warning: Map image truncated\n");
         png_size = WEATHER_MAP_IMAGE_MAX_SIZE;
     }
 
@@ -689,8 +838,8 @@ static void parse_map_response(const char *response, uint32_t len)
     g_weather_data.map_image_size = png_size;
     g_weather_data.map_loaded = true;
 
-    g_weather_data.state = WEATHER_STATE_SUCCESS;
-    printf("Map loaded successfully: %d bytes\n", png_size);
+    weather_set_state(WEATHER_STATE_SUCCESS);
+    LOG_I("Map loaded successfully: %d bytes\n", png_size);
 }
 
 // Get weather emoji from icon code
@@ -703,7 +852,7 @@ const char* weather_get_emoji(const char *icon_code)
     // 04d/04n = broken clouds, 09d/09n = shower rain, 10d/10n = rain
     // 11d/11n = thunderstorm, 13d/13n = snow, 50d/50n = mist
 
-    printf("Weather icon code: %s\n", icon_code);
+    LOG_D("Weather icon code: %s\n", icon_code);
 
     if (icon_code[0] == '0' && icon_code[1] == '1') {
         return "[Clear]";
@@ -723,7 +872,7 @@ const char* weather_get_emoji(const char *icon_code)
         return "[Fog]";
     }
 
-    printf("Unknown weather icon: %s\n", icon_code);
+    LOG_W("Unknown weather icon: %s\n", icon_code);
     return "[Unknown]";
 }
 
@@ -755,3 +904,15 @@ void weather_api_cleanup(void)
     g_weather_data.map_loaded = false;
     g_weather_data.map_image_size = 0;
 }
+
+// Parse a JSON body with the forecast parser into scratch storage (benchmarks)
+int weather_api_parse_fixture(const char *json)
+{
+    static weather_forecast_t scratch[MAX_WEATHER_FORECASTS];
+
+    const char *list_start = strstr(json, "\"list\":[");
+    if (list_start == NULL) {
+        return 0;
+    }
+    return parse_forecast_list(list_start + 8, scratch, MAX_WEATHER_FORECASTS);
+}
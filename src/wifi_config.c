@@ -1,5 +1,6 @@
 #include "wifi_config.h"
 #include <string.h>
+#include <stddef.h>
 #include <stdio.h>
 #include "pico/stdlib.h"
 #include "hardware/flash.h"
@@ -59,20 +60,35 @@ bool wifi_config_load(wifi_config_t *config)
     const wifi_config_t *flash_config =
         (const wifi_config_t *)(XIP_BASE + WIFI_CONFIG_FLASH_OFFSET);
 
-    // Check magic number
-    if (flash_config->magic != WIFI_CONFIG_MAGIC) 
+    // Validate the digest over the fields before it
+    size_t body_len = offsetof(wifi_config_t, digest);
+    if (flash_config->magic == WIFI_CONFIG_MAGIC) 
     {
-        printf("No valid WiFi config in flash (magic: 0x%08X)\n", flash_config->magic);
-        return false;
+        uint8_t digest[SHA256_ENGINE_DIGEST_SIZE];
+        sha256_engine_hash(flash_config, body_len, digest);
+        if (memcmp(digest, flash_config->digest, sizeof(digest)) != 0) 
+        {
+            printf("WiFi config SHA-256 mismatch\n");
+            return false;
+        }
     }
-
-    // Validate CRC32
-    uint32_t calc_crc = calculate_crc32((const uint8_t*)flash_config,
-                                        sizeof(wifi_config_t) - sizeof(uint32_t));
-    if (calc_crc != flash_config->crc32) 
+    else if (flash_config->magic == WIFI_CONFIG_MAGIC_CRC32) 
     {
-        printf("WiFi config CRC mismatch (calculated: 0x%08X, stored: 0x%08X)\n",
-               calc_crc, flash_config->crc32);
+        // Older record: same fields, CRC32 where the digest now starts.
+        // It is rewritten with a digest on the next save.
+        uint32_t stored_crc;
+        memcpy(&stored_crc, flash_config->digest, sizeof(stored_crc));
+        uint32_t calc_crc = calculate_crc32((const uint8_t*)flash_config, body_len);
+        if (calc_crc != stored_crc) 
+        {
+            printf("WiFi config CRC mismatch (calculated: 0x%08X, stored: 0x%08X)\n",
+                   calc_crc, stored_crc);
+            return false;
+        }
+    }
+    else 
+    {
+        printf("No valid WiFi config in flash (magic: 0x%08X)\n", flash_config->magic);
         return false;
     }
 
@@ -97,15 +113,13 @@ static void __no_inline_not_in_flash_func(flash_write_impl)(void *param)
 // Save WiFi configuration to flash
 bool wifi_config_save(const wifi_config_t *config) 
 {
-    // Create a copy with calculated CRC
+    // Create a copy with calculated digest
     wifi_config_t config_copy;
     memcpy(&config_copy, config, sizeof(wifi_config_t));
     config_copy.magic = WIFI_CONFIG_MAGIC;
-    config_copy.crc32 = calculate_crc32((const uint8_t*)&config_copy,
-                                        sizeof(wifi_config_t) - sizeof(uint32_t));
+    sha256_engine_hash(&config_copy, offsetof(wifi_config_t, digest), config_copy.digest);
 
-    printf("Saving WiFi config to flash: SSID=%s, CRC=0x%08X\n",
-           config_copy.ssid, config_copy.crc32);
+    printf("Saving WiFi config to flash: SSID=%s\n", config_copy.ssid);
 
     // Retry up to 3 times
     const int MAX_RETRIES = 3;
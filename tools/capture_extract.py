@@ -0,0 +1,75 @@
+#!/usr/bin/env python3
+"""Save captured API responses from the firmware's UART log to files.
+
+Send "cap on", use the app until the responses you want have arrived, then
+"cap dump news" (or weather / telegram) and capture the UART output (see
+src/net_capture.c). Then:
+
+    tools/capture_extract.py uart.log -o captures/
+
+Each dump is written as <source>-<n>.http, the raw HTTP response (headers
+and body) as the client received it after TLS decryption.
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+MAGIC = 0x434E4350  # "PCNC"
+VERSION = 1
+SOURCES = ["news", "weather", "telegram"]
+
+
+def extract_dumps(lines, tag="CAPT"):
+    """Return the payload bytes of every complete <tag> BEGIN/END block."""
+    dumps = []
+    payload = None
+    for line in lines:
+        line = line.strip()
+        if line.endswith(tag + " BEGIN"):
+            payload = bytearray()
+        elif line.endswith(tag + " END"):
+            if payload is not None:
+                dumps.append(bytes(payload))
+            payload = None
+        elif payload is not None and tag + ":" in line:
+            payload += bytes.fromhex(line.split(tag + ":", 1)[1])
+    return dumps
+
+
+def decode(data):
+    magic, version, source, received, length = struct.unpack_from("<5I", data)
+    if magic != MAGIC:
+        raise ValueError("bad magic")
+    if version != VERSION:
+        raise ValueError("unsupported capture version %d" % version)
+    name = SOURCES[source] if source < len(SOURCES) else "source%d" % source
+    return name, received, data[20:20 + length]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("log", help="UART log containing CAPT dumps")
+    parser.add_argument("-o", "--output", default=".", help="output directory")
+    args = parser.parse_args()
+
+    with open(args.log, errors="replace") as f:
+        dumps = extract_dumps(f)
+    if not dumps:
+        sys.exit("no CAPT dump found in %s" % args.log)
+
+    os.makedirs(args.output, exist_ok=True)
+    counts = {}
+    for data in dumps:
+        name, received, body = decode(data)
+        counts[name] = counts.get(name, 0) + 1
+        path = os.path.join(args.output, "%s-%d.http" % (name, counts[name]))
+        with open(path, "wb") as f:
+            f.write(body)
+        note = "" if received == len(body) else " (%d received, truncated)" % received
+        print("%s: %d bytes%s" % (path, len(body), note))
+
+
+if __name__ == "__main__":
+    main()
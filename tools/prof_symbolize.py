@@ -0,0 +1,137 @@
+#!/usr/bin/env python3
+"""Symbolize a sampling profiler dump from the firmware's UART log.
+
+Press F8 (or send "prof start" / "prof stop") to record a profile (see
+src/profiler.c), capture the UART output, then:
+
+    tools/prof_symbolize.py uart.log build/picocalc_omnitool.elf --folded prof.folded
+    flamegraph.pl prof.folded > prof.svg
+
+A flat profile (self samples per function) is printed to stdout. Folded
+stacks are "coreN;caller;function count" lines. The caller comes from the
+stacked LR, which is exact in leaf functions but may be stale elsewhere,
+so the flame graph is two frames deep at most.
+"""
+
+import argparse
+import bisect
+import collections
+import shutil
+import struct
+import subprocess
+import sys
+
+MAGIC = 0x46504350  # "PCPF"
+VERSION = 1
+
+
+def extract_dumps(lines, tag="PROF"):
+    """Return the payload bytes of every complete <tag> BEGIN/END block."""
+    dumps = []
+    payload = None
+    for line in lines:
+        line = line.strip()
+        if line.endswith(tag + " BEGIN"):
+            payload = bytearray()
+        elif line.endswith(tag + " END"):
+            if payload is not None:
+                dumps.append(bytes(payload))
+            payload = None
+        elif payload is not None and tag + ":" in line:
+            payload += bytes.fromhex(line.split(tag + ":", 1)[1])
+    return dumps
+
+
+def decode(data):
+    magic, version_cores, rate_hz, count, dropped = struct.unpack_from("<5I", data)
+    if magic != MAGIC:
+        raise ValueError("bad magic")
+    if version_cores & 0xFFFF != VERSION:
+        raise ValueError("unsupported profile version %d" % (version_cores & 0xFFFF))
+    samples = [struct.unpack_from("<II", data, 20 + i * 8) for i in range(count)]
+    return rate_hz, dropped, [(pc & 1, pc & ~1, lr) for pc, lr in samples]
+
+
+class Symbols:
+    """Function lookup from the ELF symbol table (via nm)."""
+
+    def __init__(self, elf, nm):
+        out = subprocess.run([nm, "-n", "-C", "--defined-only", elf],
+                             check=True, capture_output=True, text=True).stdout
+        self.addrs = []
+        self.names = []
+        for line in out.splitlines():
+            parts = line.split(" ", 2)
+            if len(parts) != 3 or parts[1] not in "tTwW":
+                continue
+            addr = int(parts[0], 16) & ~1
+            if self.addrs and self.addrs[-1] == addr:
+                continue
+            self.addrs.append(addr)
+            self.names.append(parts[2])
+
+    def lookup(self, addr):
+        i = bisect.bisect_right(self.addrs, addr & ~1) - 1
+        return self.names[i] if i >= 0 else None
+
+
+def find_nm(requested):
+    for tool in [requested, "arm-none-eabi-nm", "llvm-nm", "nm"]:
+        if tool and shutil.which(tool):
+            return tool
+    sys.exit("no nm found; pass --nm")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("log", help="UART log containing a profile dump ('-' for stdin)")
+    parser.add_argument("elf", help="picocalc_omnitool ELF the dump was taken with")
+    parser.add_argument("--folded", help="write folded stacks for flamegraph.pl here")
+    parser.add_argument("--core", type=int, choices=[0, 1], help="only this core")
+    parser.add_argument("--top", type=int, default=40, help="rows in the flat profile")
+    parser.add_argument("--nm", help="nm to use (default: arm-none-eabi-nm)")
+    parser.add_argument("--index", type=int, default=-1, help="which dump in the log to use")
+    args = parser.parse_args()
+
+    src = sys.stdin if args.log == "-" else open(args.log, errors="replace")
+    with src:
+        dumps = extract_dumps(src)
+    if not dumps:
+        sys.exit("no complete PROF BEGIN/END block found")
+
+    rate_hz, dropped, samples = decode(dumps[args.index])
+    if args.core is not None:
+        samples = [s for s in samples if s[0] == args.core]
+    if not samples:
+        sys.exit("no samples")
+
+    syms = Symbols(args.elf, find_nm(args.nm))
+    flat = collections.Counter()
+    folded = collections.Counter()
+    per_core = collections.Counter()
+    for core, pc, lr in samples:
+        func = syms.lookup(pc) or "0x%08x" % pc
+        caller = syms.lookup(lr)
+        per_core[core] += 1
+        flat[(core, func)] += 1
+        stack = ["core%d" % core]
+        if caller is not None and caller != func:
+            stack.append(caller)
+        stack.append(func)
+        folded[";".join(stack)] += 1
+
+    print("%d samples at %d Hz per core (%s), %d dropped" % (
+        len(samples), rate_hz,
+        ", ".join("core%d: %d" % (c, n) for c, n in sorted(per_core.items())), dropped))
+    print("%8s %7s  %-5s %s" % ("samples", "self%", "core", "function"))
+    for (core, func), n in flat.most_common(args.top):
+        print("%8d %6.2f%%  %-5s %s" % (n, 100.0 * n / per_core[core], "core%d" % core, func))
+
+    if args.folded:
+        with open(args.folded, "w") as f:
+            for stack, n in sorted(folded.items()):
+                f.write("%s %d\n" % (stack, n))
+
+
+if __name__ == "__main__":
+    main()
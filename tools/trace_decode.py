@@ -0,0 +1,137 @@
+#!/usr/bin/env python3
+"""Convert a trace dump from the firmware's UART log to Chrome trace JSON.
+
+Press F9 on the device to dump the hot-path trace rings (see src/trace.c),
+capture the UART output, then:
+
+    tools/trace_decode.py uart.log -o trace.json
+
+and open trace.json in chrome://tracing or https://ui.perfetto.dev.
+Other log lines around the dump are ignored; if the log holds several
+dumps, the last one is used unless --index is given.
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+MAGIC = 0x52544350  # "PCTR"
+VERSION = 1
+RECORD = struct.Struct("<IIHBB")  # cycles, value, id, type, reserved
+SYNC_ID = 0
+
+
+def extract_dumps(lines):
+    """Return the payload bytes of every complete TRACE BEGIN/END block."""
+    dumps = []
+    payload = None
+    for line in lines:
+        line = line.strip()
+        if line.endswith("TRACE BEGIN"):
+            payload = bytearray()
+        elif line.endswith("TRACE END"):
+            if payload is not None:
+                dumps.append(bytes(payload))
+            payload = None
+        elif payload is not None and "TRACE:" in line:
+            payload += bytes.fromhex(line.split("TRACE:", 1)[1])
+    return dumps
+
+
+class Reader:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def take(self, fmt):
+        value = struct.unpack_from(fmt, self.data, self.pos)
+        self.pos += struct.calcsize(fmt)
+        return value if len(value) > 1 else value[0]
+
+    def bytes(self, n):
+        value = self.data[self.pos:self.pos + n]
+        self.pos += n
+        return value
+
+
+def decode(data):
+    r = Reader(data)
+    if r.take("<I") != MAGIC:
+        raise ValueError("bad magic")
+    version = r.take("<H")
+    if version != VERSION:
+        raise ValueError("unsupported trace version %d" % version)
+    cores = r.take("<H")
+    clk_hz = r.take("<I")
+    names = [r.bytes(r.take("<B")).decode() for _ in range(r.take("<H"))]
+
+    cycles_per_us = clk_hz / 1e6
+    events = []
+    for core in range(cores):
+        count = r.take("<I")
+        records = [RECORD.unpack_from(data, r.pos + i * RECORD.size) for i in range(count)]
+        r.pos += count * RECORD.size
+        events += decode_core(core, records, names, cycles_per_us)
+
+    meta = [{"ph": "M", "name": "thread_name", "pid": 0, "tid": core,
+             "args": {"name": "core%d" % core}} for core in range(cores)]
+    return meta + sorted(events, key=lambda e: e["ts"])
+
+
+def decode_core(core, records, names, cycles_per_us):
+    """Place each record on the wall clock using the nearest preceding sync."""
+    # Records from before the first surviving sync use the first one
+    sync = next(((c, v) for c, v, i, t, _ in records if i == SYNC_ID), None)
+    if sync is None:
+        return []
+
+    events = []
+    open_slices = 0
+    for cycles, value, ident, kind, _ in records:
+        if ident == SYNC_ID:
+            sync = (cycles, value)
+            continue
+        delta = cycles - sync[0]
+        if delta >= 1 << 31:
+            delta -= 1 << 32
+        ts = sync[1] + delta / cycles_per_us
+        name = names[ident] if ident < len(names) else "id%d" % ident
+        ph = chr(kind)
+        event = {"name": name, "ph": ph, "ts": ts, "pid": 0, "tid": core}
+        if ph == "C":
+            event["args"] = {"value": value}
+        elif ph == "B":
+            open_slices += 1
+        elif ph == "E":
+            # The ring may have dropped the matching begin
+            if open_slices == 0:
+                continue
+            open_slices -= 1
+        events.append(event)
+    return events
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("log", help="UART log containing a trace dump ('-' for stdin)")
+    parser.add_argument("-o", "--output", help="output JSON file (default: stdout)")
+    parser.add_argument("--index", type=int, default=-1, help="which dump in the log to decode")
+    args = parser.parse_args()
+
+    src = sys.stdin if args.log == "-" else open(args.log, errors="replace")
+    with src:
+        dumps = extract_dumps(src)
+    if not dumps:
+        sys.exit("no complete TRACE BEGIN/END block found")
+
+    trace = {"traceEvents": decode(dumps[args.index]), "displayTimeUnit": "ns"}
+    out = sys.stdout if args.output is None else open(args.output, "w")
+    with out:
+        json.dump(trace, out)
+    print("%d events from dump %d of %d" % (len(trace["traceEvents"]), args.index % len(dumps) + 1,
+                                           len(dumps)), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()